@@ -58,7 +58,10 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 #include <Grid/lattice/Lattice.h>      
 #include <Grid/cshift/Cshift.h>       
 #include <Grid/stencil/Stencil.h>      
+#include <Grid/stencil/GeneralLocalStencil.h>
+#include <Grid/lattice/PaddedCell.h>
 #include <Grid/parallelIO/BinaryIO.h>
+#include <Grid/parallelIO/BinaryIOAsync.h>
 #include <Grid/algorithms/Algorithms.h>   
 NAMESPACE_CHECK(GridCore)
 
@@ -66,6 +66,12 @@ public:
   inline static void fftw_destroy_plan(const FFTW_plan p) {
     ::fftw_destroy_plan(p);
   }
+  inline static int fftw_import_wisdom_from_filename(const char *filename) {
+    return ::fftw_import_wisdom_from_filename(filename);
+  }
+  inline static int fftw_export_wisdom_to_filename(const char *filename) {
+    return ::fftw_export_wisdom_to_filename(filename);
+  }
 };
 
 template<> struct FFTW<ComplexF> {
@@ -93,6 +99,12 @@ public:
   inline static void fftw_destroy_plan(const FFTW_plan p) {
     ::fftwf_destroy_plan(p);
   }
+  inline static int fftw_import_wisdom_from_filename(const char *filename) {
+    return ::fftwf_import_wisdom_from_filename(filename);
+  }
+  inline static int fftw_export_wisdom_to_filename(const char *filename) {
+    return ::fftwf_export_wisdom_to_filename(filename);
+  }
 };
 
 #endif
@@ -100,6 +112,9 @@ public:
 #ifndef FFTW_FORWARD
 #define FFTW_FORWARD (-1)
 #define FFTW_BACKWARD (+1)
+#define FFTW_MEASURE (0U)
+#define FFTW_ESTIMATE (1U << 6)
+#define FFTW_PATIENT (1U << 5)
 #endif
 
 class FFT {
@@ -116,11 +131,59 @@ private:
   Coordinate dimensions;
   Coordinate processors;
   Coordinate processor_coor;
+
+  // Communicators along each dimension for the pencil transposes; built on first use
+  std::vector<CartesianCommunicator *> rowcomm;
     
 public:
     
   static const int forward=FFTW_FORWARD;
   static const int backward=FFTW_BACKWARD;
+
+  static const unsigned estimate=FFTW_ESTIMATE;
+  static const unsigned measure =FFTW_MEASURE;
+  static const unsigned patient =FFTW_PATIENT;
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Plans are cached process wide, keyed on (length, howmany, stride, sign,
+  // flags) with one cache per precision, and live until ClearPlanCache.
+  // FFT objects are usually short lived so the cache is not per instance.
+  // Effort other than estimate times candidate plans on a scratch buffer the
+  // first time a key is seen; importing wisdom makes that cheap.
+  ///////////////////////////////////////////////////////////////////////////
+  static unsigned &PlanningEffort(void) { static unsigned effort=estimate; return effort; }
+  static void SetPlanningEffort(unsigned effort) {
+    assert( (effort==estimate) || (effort==measure) || (effort==patient) );
+    PlanningEffort() = effort;
+  }
+
+  // Double and single precision wisdom are kept in <filename>.d and <filename>.f
+  static bool ImportWisdom(const std::string &filename) {
+#ifdef HAVE_FFTW
+    int okd = FFTW<ComplexD>::fftw_import_wisdom_from_filename((filename+".d").c_str());
+    int okf = FFTW<ComplexF>::fftw_import_wisdom_from_filename((filename+".f").c_str());
+    std::cout << GridLogMessage << "FFT: imported wisdom from "<<filename<<".{d,f} "<<okd<<" "<<okf<<std::endl;
+    return okd && okf;
+#else
+    return false;
+#endif
+  }
+  // Call on the boss rank only if the file system is shared
+  static bool ExportWisdom(const std::string &filename) {
+#ifdef HAVE_FFTW
+    int okd = FFTW<ComplexD>::fftw_export_wisdom_to_filename((filename+".d").c_str());
+    int okf = FFTW<ComplexF>::fftw_export_wisdom_to_filename((filename+".f").c_str());
+    return okd && okf;
+#else
+    return false;
+#endif
+  }
+  static void ClearPlanCache(void) {
+#ifdef HAVE_FFTW
+    ClearPlanCache<ComplexD>();
+    ClearPlanCache<ComplexF>();
+#endif
+  }
     
   double Flops(void) {return flops;}
   double MFlops(void) {return flops/usec;}
@@ -131,7 +194,8 @@ public:
     Nd(grid->_ndimension),
     dimensions(grid->_fdimensions),
     processors(grid->_processors),
-    processor_coor(grid->_processor_coor)
+    processor_coor(grid->_processor_coor),
+    rowcomm(grid->_ndimension,nullptr)
   {
     flops=0;
     usec =0;
@@ -140,6 +204,7 @@ public:
   };
     
   ~FFT ( void)  {
+    for(int d=0;d<rowcomm.size();d++) delete rowcomm[d];
     delete sgrid;
   }
     
@@ -164,131 +229,239 @@ public:
     FFT_dim_mask(result,source,mask,sign);
   }
 
-
   template<class vobj>
   void FFT_dim(Lattice<vobj> &result,const Lattice<vobj> &source,int dim, int sign){
+    Lattice<vobj> *res = &result;
+    const Lattice<vobj> *src = &source;
+    FFT_dim_batch(&res,&src,1,dim,sign);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Batched transforms of many fields of the same type; one exchange per
+  // dimension carries all fields. result may alias source.
+  ///////////////////////////////////////////////////////////////////////////
+  template<class vobj>
+  void FFT_dim_mask(std::vector<Lattice<vobj> > &result,const std::vector<Lattice<vobj> > &source,Coordinate mask,int sign){
+    assert(result.size()==source.size());
+    int Nf = source.size();
+    if ( Nf==0 ) return;
+    std::vector<Lattice<vobj> *> res(Nf);
+    std::vector<const Lattice<vobj> *> src(Nf);
+    for(int f=0;f<Nf;f++){
+      res[f] = &result[f];
+      src[f] = &source[f];
+    }
+    for(int d=0;d<Nd;d++){
+      if( mask[d] ) {
+	FFT_dim_batch(&res[0],&src[0],Nf,d,sign);
+	for(int f=0;f<Nf;f++) src[f] = &result[f];
+      }
+    }
+    // Nothing transformed; still honour result = source
+    for(int f=0;f<Nf;f++){
+      if ( src[f] != &result[f] ) result[f] = source[f];
+    }
+  }
+
+  template<class vobj>
+  void FFT_all_dim(std::vector<Lattice<vobj> > &result,const std::vector<Lattice<vobj> > &source,int sign){
+    Coordinate mask(Nd,1);
+    FFT_dim_mask(result,source,mask,sign);
+  }
+
+  template<class vobj>
+  void FFT_dim(std::vector<Lattice<vobj> > &result,const std::vector<Lattice<vobj> > &source,int dim,int sign){
+    Coordinate mask(Nd,0);
+    mask[dim]=1;
+    FFT_dim_mask(result,source,mask,sign);
+  }
+
+private:
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Transpose based pencil FFT.
+  //
+  // The local sites orthogonal to dim are dealt out in P equal chunks, P the
+  // number of ranks along dim. One all to all along dim leaves each rank with
+  // complete lines of length G for its chunk; these are transformed locally
+  // and a second all to all returns them. Storage is O(Nf x local volume).
+  //
+  // The Nf fields travel together, interleaved innermost in each pencil, so
+  // a single FFTW execution with howmany = Nf x Ncomp covers every field's
+  // line through a given site.
+  ///////////////////////////////////////////////////////////////////////////
+  template<class vobj>
+  void FFT_dim_batch(Lattice<vobj> * const *result,const Lattice<vobj> * const *source,int Nf,int dim, int sign){
 #ifndef HAVE_FFTW
     assert(0);
 #else
-    conformable(result.Grid(),vgrid);
-    conformable(source.Grid(),vgrid);
+    for(int f=0;f<Nf;f++){
+      conformable(result[f]->Grid(),vgrid);
+      conformable(source[f]->Grid(),vgrid);
+    }
 
-    int L = vgrid->_ldimensions[dim];
-    int G = vgrid->_fdimensions[dim];
-      
-    Coordinate layout(Nd,1);
-    Coordinate pencil_gd(vgrid->_fdimensions);
-      
-    pencil_gd[dim] = G*processors[dim];
-      
-    // Pencil global vol LxLxGxLxL per node
-    GridCartesian pencil_g(pencil_gd,layout,processors);
-      
-    // Construct pencils
     typedef typename vobj::scalar_object sobj;
     typedef typename sobj::scalar_type   scalar;
-      
-    Lattice<sobj> pgbuf(&pencil_g);
-    autoView(pgbuf_v , pgbuf, CpuWrite);
 
     typedef typename FFTW<scalar>::FFTW_scalar FFTW_scalar;
     typedef typename FFTW<scalar>::FFTW_plan   FFTW_plan;
-      
+
+    int P = processors[dim];
+    int L = vgrid->_ldimensions[dim];
+    int G = vgrid->_fdimensions[dim];
+
+    int64_t Nperp  = sgrid->lSites()/L;     // local lines through dim, per field
+    int64_t Nchunk = (Nperp+P-1)/P;         // lines transformed by this rank, per field
+    int64_t words  = Nchunk*Nf*L;           // sites exchanged with each rank
+
+    Vector<sobj> sbuf(P*words);
+    Vector<sobj> rbuf(P*words);
+    Vector<sobj> pencil(Nchunk*G*Nf);
+
     int Ncomp = sizeof(sobj)/sizeof(scalar);
-    int Nlow  = 1;
-    for(int d=0;d<dim;d++){
-      Nlow*=vgrid->_ldimensions[d];
-    }
-      
+
     int rank = 1;  /* 1d transforms */
     int n[] = {G}; /* 1d transforms of length G */
-    int howmany = Ncomp;
+    int howmany = Nf*Ncomp;
     int odist,idist,istride,ostride;
     idist   = odist   = 1;          /* Distance between consecutive FT's */
-    istride = ostride = Ncomp*Nlow; /* distance between two elements in the same FT */
+    istride = ostride = Nf*Ncomp;   /* distance between two elements in the same FT */
     int *inembed = n, *onembed = n;
       
     scalar div;
     if ( sign == backward ) div = 1.0/G;
     else if ( sign == forward ) div = 1.0;
     else assert(0);
-      
-    FFTW_plan p;
-    {
-      FFTW_scalar *in = (FFTW_scalar *)&pgbuf_v[0];
-      FFTW_scalar *out= (FFTW_scalar *)&pgbuf_v[0];
-      p = FFTW<scalar>::fftw_plan_many_dft(rank,n,howmany,
-					   in,inembed,
-					   istride,idist,
-					   out,onembed,
-					   ostride, odist,
-					   sign,FFTW_ESTIMATE);
+
+    // Pencils are executed at offsets of G*Nf sites; keep FFTW off aligned-only codelets if they drift
+    unsigned flags = PlanningEffort();
+    if ( (G*Nf*sizeof(sobj)) % 16 ) flags |= FFTW_UNALIGNED;
+
+    PlanKey key(G,howmany,istride,sign,flags);
+    auto &cache = PlanCache<scalar>();
+    auto plan = cache.find(key);
+    if ( plan == cache.end() ) {
+      // Measuring planners overwrite the arrays, so never plan on live data
+      Vector<sobj> scratch(G*Nf);
+      FFTW_scalar *in = (FFTW_scalar *)&scratch[0];
+      FFTW_scalar *out= (FFTW_scalar *)&scratch[0];
+      FFTW_plan np = FFTW<scalar>::fftw_plan_many_dft(rank,n,howmany,
+						      in,inembed,
+						      istride,idist,
+						      out,onembed,
+						      ostride, odist,
+						      sign,flags);
+      assert(np!=NULL);
+      plan = cache.insert(std::make_pair(key,np)).first;
     }
-      
-    // Barrel shift and collect global pencil
-    Coordinate lcoor(Nd), gcoor(Nd);
-    result = source;
-    int pc = processor_coor[dim];
-    for(int p=0;p<processors[dim];p++) {
-      {
-	autoView(r_v,result,CpuRead);
-	autoView(p_v,pgbuf,CpuWrite);
-	thread_for(idx, sgrid->lSites(),{
-          Coordinate cbuf(Nd);
-          sobj s;
-	  sgrid->LocalIndexToLocalCoor(idx,cbuf);
-	  peekLocalSite(s,r_v,cbuf);
-	  cbuf[dim]+=((pc+p) % processors[dim])*L;
-	  pokeLocalSite(s,p_v,cbuf);
-        });
-      }
-      if (p != processors[dim] - 1) {
-	result = Cshift(result,dim,L);
-      }
+    FFTW_plan p = plan->second;
+
+    // Pack by destination rank: line o = q*Nchunk+c goes to rank q, fields innermost
+    for(int f=0;f<Nf;f++){
+      autoView(s_v,(*source[f]),CpuRead);
+      thread_for(idx, sgrid->lSites(),{
+	Coordinate lcoor(Nd);
+	sobj s;
+	sgrid->LocalIndexToLocalCoor(idx,lcoor);
+	peekLocalSite(s,s_v,lcoor);
+	sbuf[(PerpIndex(lcoor,dim)*Nf+f)*L+lcoor[dim]] = s;
+      });
     }
-      
-    // Loop over orthog coords
-    int NN=pencil_g.lSites();
+    thread_for(i,(P*Nchunk-Nperp)*Nf*L,{
+      sbuf[Nperp*Nf*L+i] = Zero();
+    });
+
+    Transpose(dim,sbuf,rbuf,words);
+
+    // Assemble lines of length G; rank p supplied global coordinates p*L..p*L+L-1
+    thread_for(c,Nchunk,{
+      for(int pp=0;pp<P;pp++){
+      for(int f=0;f<Nf;f++){
+	for(int x=0;x<L;x++){
+	  pencil[(c*G+pp*L+x)*Nf+f] = rbuf[((pp*Nchunk+c)*Nf+f)*L+x];
+	}
+      }}
+    });
+
     GridStopWatch timer;
     timer.Start();
-    thread_for( idx,NN,{
-        Coordinate cbuf(Nd);
-	pencil_g.LocalIndexToLocalCoor(idx, cbuf);
-	if ( cbuf[dim] == 0 ) {  // restricts loop to plane at lcoor[dim]==0
-	  FFTW_scalar *in = (FFTW_scalar *)&pgbuf_v[idx];
-	  FFTW_scalar *out= (FFTW_scalar *)&pgbuf_v[idx];
-	  FFTW<scalar>::fftw_execute_dft(p,in,out);
-	}
+    thread_for(c,Nchunk,{
+      FFTW_scalar *in = (FFTW_scalar *)&pencil[c*G*Nf];
+      FFTW_scalar *out= (FFTW_scalar *)&pencil[c*G*Nf];
+      FFTW<scalar>::fftw_execute_dft(p,in,out);
     });
     timer.Stop();
-      
+
     // performance counting
     double add,mul,fma;
     FFTW<scalar>::fftw_flops(p,&add,&mul,&fma);
     flops_call = add+mul+2.0*fma;
     usec += timer.useconds();
-    flops+= flops_call*NN;
-      
-    // writing out result
-    {
-      autoView(pgbuf_v,pgbuf,CpuRead);
-      autoView(result_v,result,CpuWrite);
-      thread_for(idx,sgrid->lSites(),{
-	Coordinate clbuf(Nd), cgbuf(Nd);
-	sobj s;
-	sgrid->LocalIndexToLocalCoor(idx,clbuf);
-	cgbuf = clbuf;
-	cgbuf[dim] = clbuf[dim]+L*pc;
-	peekLocalSite(s,pgbuf_v,cgbuf);
-	pokeLocalSite(s,result_v,clbuf);
+    flops+= flops_call*Nchunk;
+
+    // Return the lines to their owners
+    thread_for(c,Nchunk,{
+      for(int pp=0;pp<P;pp++){
+      for(int f=0;f<Nf;f++){
+	for(int x=0;x<L;x++){
+	  sbuf[((pp*Nchunk+c)*Nf+f)*L+x] = pencil[(c*G+pp*L+x)*Nf+f]*div;
+	}
+      }}
+    });
+
+    Transpose(dim,sbuf,rbuf,words);
+
+    for(int f=0;f<Nf;f++){
+      autoView(r_v,(*result[f]),CpuWrite);
+      thread_for(idx, sgrid->lSites(),{
+	Coordinate lcoor(Nd);
+	sgrid->LocalIndexToLocalCoor(idx,lcoor);
+	pokeLocalSite(rbuf[(PerpIndex(lcoor,dim)*Nf+f)*L+lcoor[dim]],r_v,lcoor);
       });
     }
-    result = result*div;
-      
-    // destroying plan
-    FFTW<scalar>::fftw_destroy_plan(p);
 #endif
   }
+
+  typedef std::tuple<int,int,int,int,unsigned> PlanKey; // length, howmany, stride, sign, flags
+
+#ifdef HAVE_FFTW
+  template<class scalar>
+  static std::map<PlanKey,typename FFTW<scalar>::FFTW_plan> &PlanCache(void) {
+    static std::map<PlanKey,typename FFTW<scalar>::FFTW_plan> cache;
+    return cache;
+  }
+  template<class scalar>
+  static void ClearPlanCache(void) {
+    auto &cache = PlanCache<scalar>();
+    for(auto &plan : cache) FFTW<scalar>::fftw_destroy_plan(plan.second);
+    cache.clear();
+  }
+#endif
+
+  // Lexicographic index of a local site within the sites orthogonal to dim
+  int64_t PerpIndex(const Coordinate &lcoor,int dim) {
+    int64_t o=0;
+    for(int d=Nd-1;d>=0;d--){
+      if ( d!=dim ) o = o*vgrid->_ldimensions[d]+lcoor[d];
+    }
+    return o;
+  }
+
+  // All to all along dim of P blocks of words objects each
+  template<class sobj>
+  void Transpose(int dim,Vector<sobj> &sbuf,Vector<sobj> &rbuf,int64_t words) {
+    if ( processors[dim]==1 ) {
+      std::swap(sbuf,rbuf);
+      return;
+    }
+    if ( rowcomm[dim]==nullptr ) {
+      Coordinate row(Nd,1);
+      row[dim] = processors[dim];
+      int me;
+      rowcomm[dim] = new CartesianCommunicator(row,*vgrid,me);
+    }
+    rowcomm[dim]->AllToAll((void *)&sbuf[0],(void *)&rbuf[0],words,sizeof(sobj));
+  }
 };
 
 NAMESPACE_END(Grid);
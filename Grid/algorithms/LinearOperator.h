@@ -52,6 +52,12 @@ public:
   virtual void AdjOp  (const Field &in, Field &out) = 0; // Abstract base
   virtual void HermOpAndNorm(const Field &in, Field &out,RealD &n1,RealD &n2)=0;
   virtual void HermOp(const Field &in, Field &out)=0;
+
+  // Batched HermOp on several right hand sides; wrappers of actions
+  // that batch their operator application override this
+  virtual void HermOpMultiRHS(const std::vector<Field> &in, std::vector<Field> &out) {
+    for(int r=0;r<in.size();r++) HermOp(in[r],out[r]);
+  }
 };
 
 
@@ -101,6 +107,11 @@ public:
   void HermOp(const Field &in, Field &out){
     _Mat.MdagM(in,out);
   }
+  void HermOpMultiRHS(const std::vector<Field> &in, std::vector<Field> &out){
+    std::vector<Field> tmp(in.size(),in[0].Grid());
+    _Mat.MMultiRHS(in,tmp);
+    _Mat.MdagMultiRHS(tmp,out);
+  }
 };
 
 ////////////////////////////////////////////////////////////////////
@@ -144,6 +155,33 @@ public:
   }
 };
 
+////////////////////////////////////////////////////////////////////
+// Shift the HermOp of an existing linear operator; single pole
+// solves and cleanups in the multi-shift solvers
+////////////////////////////////////////////////////////////////////
+template<class Field>
+class ShiftedHermOpLinearOperator : public LinearOperatorBase<Field> {
+  LinearOperatorBase<Field> &_Linop;
+  RealD _shift;
+public:
+  ShiftedHermOpLinearOperator(LinearOperatorBase<Field> &Linop,RealD shift): _Linop(Linop), _shift(shift){};
+  void OpDiag (const Field &in, Field &out) { assert(0); }
+  void OpDir  (const Field &in, Field &out,int dir,int disp) { assert(0); }
+  void OpDirAll  (const Field &in, std::vector<Field> &out){ assert(0); };
+  void Op     (const Field &in, Field &out){ assert(0); }
+  void AdjOp  (const Field &in, Field &out){ assert(0); }
+  void HermOpAndNorm(const Field &in, Field &out,RealD &n1,RealD &n2){
+    HermOp(in,out);
+    ComplexD dot = innerProduct(in,out);
+    n1=real(dot);
+    n2=norm2(out);
+  }
+  void HermOp(const Field &in, Field &out){
+    _Linop.HermOp(in,out);
+    axpy(out,_shift,in,out);
+  }
+};
+
 ////////////////////////////////////////////////////////////////////
 // Wrap an already herm matrix
 ////////////////////////////////////////////////////////////////////
@@ -234,6 +272,12 @@ class SchurOperatorBase :  public LinearOperatorBase<Field> {
     out.Checkerboard() = in.Checkerboard();
     MpcDagMpc(in,out);
   }
+  virtual  void MpcMultiRHS   (const std::vector<Field> &in, std::vector<Field> &out) {
+    for(int r=0;r<in.size();r++) Mpc(in[r],out[r]);
+  }
+  virtual  void MpcDagMultiRHS(const std::vector<Field> &in, std::vector<Field> &out) {
+    for(int r=0;r<in.size();r++) MpcDag(in[r],out[r]);
+  }
   void Op     (const Field &in, Field &out){
     Mpc(in,out);
   }
@@ -257,23 +301,40 @@ template<class Matrix,class Field>
     Matrix &_Mat;
     SchurDiagMooeeOperator (Matrix &Mat): _Mat(Mat){};
     virtual  void Mpc      (const Field &in, Field &out) {
-      Field tmp(in.Grid());
-      tmp.Checkerboard() = !in.Checkerboard();
-      
-      _Mat.Meooe(in,tmp);
-      _Mat.MooeeInv(tmp,out);
-      _Mat.Meooe(out,tmp);
-      _Mat.Mooee(in,out);
-      axpy(out,-1.0,tmp,out);
+      _Mat.SchurDiagMooee(in,out);
     }
     virtual void MpcDag   (const Field &in, Field &out){
-      Field tmp(in.Grid());
-	
-      _Mat.MeooeDag(in,tmp);
-      _Mat.MooeeInvDag(tmp,out);
-      _Mat.MeooeDag(out,tmp);
-      _Mat.MooeeDag(in,out);
-      axpy(out,-1.0,tmp,out);
+      _Mat.SchurDiagMooeeDag(in,out);
+    }
+    // HermOp is MpcDag Mpc here; other Schur operators keep the per field default
+    virtual void HermOpMultiRHS(const std::vector<Field> &in, std::vector<Field> &out){
+      std::vector<Field> tmp(in.size(),in[0].Grid());
+      for(int r=0;r<in.size();r++) tmp[r].Checkerboard() = in[r].Checkerboard();
+      MpcMultiRHS(in,tmp);
+      MpcDagMultiRHS(tmp,out);
+    }
+    // Hopping terms batched across the right hand sides
+    virtual void MpcMultiRHS   (const std::vector<Field> &in, std::vector<Field> &out) {
+      int nrhs = in.size();
+      std::vector<Field> tmp(nrhs,in[0].Grid());
+      _Mat.MeooeMultiRHS(in,tmp);
+      for(int r=0;r<nrhs;r++) _Mat.MooeeInv(tmp[r],out[r]);
+      _Mat.MeooeMultiRHS(out,tmp);
+      for(int r=0;r<nrhs;r++) {
+	_Mat.Mooee(in[r],out[r]);
+	axpy(out[r],-1.0,tmp[r],out[r]);
+      }
+    }
+    virtual void MpcDagMultiRHS(const std::vector<Field> &in, std::vector<Field> &out) {
+      int nrhs = in.size();
+      std::vector<Field> tmp(nrhs,in[0].Grid());
+      _Mat.MeooeDagMultiRHS(in,tmp);
+      for(int r=0;r<nrhs;r++) _Mat.MooeeInvDag(tmp[r],out[r]);
+      _Mat.MeooeDagMultiRHS(out,tmp);
+      for(int r=0;r<nrhs;r++) {
+	_Mat.MooeeDag(in[r],out[r]);
+	axpy(out[r],-1.0,tmp[r],out[r]);
+      }
     }
 };
 template<class Matrix,class Field>
@@ -530,6 +591,13 @@ public:
 template<class Field> class LinearFunction {
 public:
   virtual void operator() (const Field &in, Field &out) = 0;
+  // Block of right hand sides; override where the operator can batch them
+  virtual void operator() (const std::vector<Field> &in, std::vector<Field> &out) {
+    assert(in.size()==out.size());
+    for(int k=0;k<in.size();k++){
+      (*this)(in[k],out[k]);
+    }
+  }
 };
 
 template<class Field> class IdentityLinearFunction : public LinearFunction<Field> {
@@ -583,6 +651,9 @@ public:
   void operator()(const Field& in, Field& out) {
     _Linop.HermOp(in,out);
   }
+  void operator()(const std::vector<Field>& in, std::vector<Field>& out) {
+    _Linop.HermOpMultiRHS(in,out);
+  }
 };
 
 template<typename Field>
@@ -597,6 +668,9 @@ public:
   void operator()(const Field& in, Field& out) {
     _poly(_Linop,in,out);
   }
+  void operator()(const std::vector<Field>& in, std::vector<Field>& out) {
+    _poly(_Linop,in,out);
+  }
 };
 
 template<class Field>
@@ -48,6 +48,15 @@ public:
   virtual  void Mdiag    (const Field &in, Field &out)=0;
   virtual  void Mdir     (const Field &in, Field &out,int dir, int disp)=0;
   virtual  void MdirAll  (const Field &in, std::vector<Field> &out)=0;
+
+  // Several right hand sides; an action that can share the operator
+  // application across them overrides these
+  virtual void  MMultiRHS   (const std::vector<Field> &in, std::vector<Field> &out) {
+    for(int r=0;r<in.size();r++) M(in[r],out[r]);
+  }
+  virtual void  MdagMultiRHS(const std::vector<Field> &in, std::vector<Field> &out) {
+    for(int r=0;r<in.size();r++) Mdag(in[r],out[r]);
+  }
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -73,6 +82,33 @@ public:
   virtual  void MooeeDag    (const Field &in, Field &out)=0;
   virtual  void MooeeInvDag (const Field &in, Field &out)=0;
 
+  // Schur complement Mooee - Meooe MooeeInv Meooe on one checkerboard;
+  // an action that can fuse the passes overrides these
+  virtual  void SchurDiagMooee    (const Field &in, Field &out) {
+    Field tmp(in.Grid());
+    tmp.Checkerboard() = !in.Checkerboard();
+    Meooe(in,tmp);
+    MooeeInv(tmp,out);
+    Meooe(out,tmp);
+    Mooee(in,out);
+    axpy(out,-1.0,tmp,out);
+  }
+  virtual  void SchurDiagMooeeDag (const Field &in, Field &out) {
+    Field tmp(in.Grid());
+    tmp.Checkerboard() = !in.Checkerboard();
+    MeooeDag(in,tmp);
+    MooeeInvDag(tmp,out);
+    MeooeDag(out,tmp);
+    MooeeDag(in,out);
+    axpy(out,-1.0,tmp,out);
+  }
+
+  virtual  void MeooeMultiRHS    (const std::vector<Field> &in, std::vector<Field> &out) {
+    for(int r=0;r<in.size();r++) Meooe(in[r],out[r]);
+  }
+  virtual  void MeooeDagMultiRHS (const std::vector<Field> &in, std::vector<Field> &out) {
+    for(int r=0;r<in.size();r++) MeooeDag(in[r],out[r]);
+  }
 };
 
 NAMESPACE_END(Grid);
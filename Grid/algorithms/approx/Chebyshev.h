@@ -286,6 +286,49 @@ public:
 	  
     }
   }
+
+  // Same recurrence for a block of vectors, applying the operator to the
+  // whole block at once so a multi-RHS HermOp can batch the Dslash
+  void operator() (LinearOperatorBase<Field> &Linop, const std::vector<Field> &in, std::vector<Field> &out) {
+
+    assert(in.size()==out.size());
+    int nrhs = in.size();
+    if ( nrhs == 0 ) return;
+    GridBase *grid=in[0].Grid();
+
+    std::vector<Field> T0(in);
+    std::vector<Field> T1(nrhs,grid);
+    std::vector<Field> T2(nrhs,grid);
+    std::vector<Field>  y(nrhs,grid);
+
+    std::vector<Field> *Tnm = &T0;
+    std::vector<Field> *Tn  = &T1;
+    std::vector<Field> *Tnp = &T2;
+
+    RealD xscale = 2.0/(hi-lo);
+    RealD mscale = -(hi+lo)/(hi-lo);
+    Linop.HermOpMultiRHS(T0,y);
+    for(int r=0;r<nrhs;r++){
+      axpby(T1[r],xscale,mscale,y[r],in[r]);
+      axpby(out[r],0.5*Coeffs[0],Coeffs[1],T0[r],T1[r]);
+    }
+    for(int n=2;n<order;n++){
+
+      Linop.HermOpMultiRHS(*Tn,y);
+      for(int r=0;r<nrhs;r++){
+	axpby(y[r],xscale,mscale,y[r],(*Tn)[r]);
+	axpby((*Tnp)[r],2.0,-1.0,y[r],(*Tnm)[r]);
+	if ( Coeffs[n] != 0.0) {
+	  axpy(out[r],Coeffs[n],(*Tnp)[r],out[r]);
+	}
+      }
+      // Cycle pointers to avoid copies
+      std::vector<Field> *swizzle = Tnm;
+      Tnm    =Tn;
+      Tn     =Tnp;
+      Tnp    =swizzle;
+    }
+  }
 };
 
 
@@ -404,6 +447,13 @@ public:
 	  
     }
   }
+  // Different recurrence from the base class; apply vector by vector
+  void operator() (LinearOperatorBase<Field> &Linop, const std::vector<Field> &in, std::vector<Field> &out) {
+    assert(in.size()==out.size());
+    for(int k=0;k<in.size();k++){
+      (*this)(Linop,in[k],out[k]);
+    }
+  }
 };
 NAMESPACE_END(Grid);
 #endif
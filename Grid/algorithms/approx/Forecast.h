@@ -43,8 +43,25 @@ public:
   virtual Field operator()(Matrix &Mat, const Field& phi, const std::vector<Field>& chi) = 0;
 };
 
+// MdagM of the normal equations the forecast minimises over. A linear
+// operator supplies it directly as its HermOp.
+template<class Matrix, class Field,
+	 typename std::enable_if<!std::is_base_of<LinearOperatorBase<Field>,Matrix>::value,int>::type = 0>
+void ForecastMdagM(Matrix &Mat, const Field &in, Field &out, Field &tmp)
+{
+  Mat.M(in,tmp);
+  Mat.Mdag(tmp,out);
+}
+template<class Matrix, class Field,
+	 typename std::enable_if<std::is_base_of<LinearOperatorBase<Field>,Matrix>::value,int>::type = 0>
+void ForecastMdagM(Matrix &Linop, const Field &in, Field &out, Field &tmp)
+{
+  Linop.HermOp(in,out);
+}
+
 // Implementation of Brower et al.'s chronological inverter (arXiv:hep-lat/9509012),
-// used to forecast solutions across poles of the EOFA heatbath.
+// used to forecast solutions across poles of the EOFA heatbath, and across
+// MD steps by ChronoSolutionHistory.
 //
 // Modified from CPS (cps_pp/src/util/dirac_op/d_op_base/comsrc/minresext.C)
 template<class Matrix, class Field>
@@ -83,8 +100,7 @@ public:
     // Perform sparse matrix multiplication and construct rhs
     for(int i=0; i<degree; i++){
       b[i] = innerProduct(v[i],phi);
-      Mat.M(v[i],Mv);
-      Mat.Mdag(Mv,MdagMv[i]);
+      ForecastMdagM(Mat,v[i],MdagMv[i],Mv);
       G[i][i] = innerProduct(v[i],MdagMv[i]);
     }
 
@@ -147,6 +163,41 @@ public:
   };
 };
 
+// The last few solutions of a solve that recurs along an MD trajectory,
+// e.g. a pseudofermion force. Guess() gives the minimum residual
+// extrapolation through them; Depth=0 keeps the zero guess. The integrator
+// resets the history at trajectory start and momentum refresh.
+template<class Field>
+class ChronoSolutionHistory
+{
+public:
+  int Depth;
+  std::vector<Field> Solutions; // oldest first
+
+  ChronoSolutionHistory(int depth = 0) : Depth(depth) {};
+
+  void Reset(void) { Solutions.clear(); }
+
+  void Push(const Field &soln)
+  {
+    if ( Depth <= 0 ) return;
+    if ( Solutions.size() == Depth ) Solutions.erase(Solutions.begin());
+    Solutions.push_back(soln);
+  }
+
+  // Guess for MdagM psi = phi
+  template<class Matrix>
+  void Guess(Matrix &Mat, const Field &phi, Field &psi)
+  {
+    if ( Solutions.size() == 0 ) {
+      psi = Zero();
+    } else {
+      ChronoForecast<Matrix,Field> Forecast;
+      psi = Forecast(Mat, phi, Solutions);
+    }
+  }
+};
+
 NAMESPACE_END(Grid);
 
 #endif
@@ -0,0 +1,275 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/algorithms/iterative/ConjugateGradientMultiRHS.h
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#ifndef GRID_CONJUGATE_GRADIENT_MULTI_RHS_H
+#define GRID_CONJUGATE_GRADIENT_MULTI_RHS_H
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////
+// CG on several independent systems A x_i = b_i sharing the operator.
+//
+// Each iteration applies Linop.HermOpMultiRHS once to the residuals of all
+// systems still running, so an action that batches its hopping term reads
+// the gauge field and exchanges halos once for the whole set.
+//
+// Uses the Chronopoulos-Gear recurrence, carrying w = A r and s = A p, so
+// that <r,r> and <r,w> of every live system are available together; they
+// go into a single GlobalSumVector per iteration.
+//
+// A system leaves the batch as soon as its residual meets the target and
+// the remaining ones carry on with a smaller batch.
+/////////////////////////////////////////////////////////////////////////////
+template <class Field>
+class ConjugateGradientMultiRHS : public OperatorFunction<Field> {
+public:
+
+  using OperatorFunction<Field>::operator();
+
+  bool ErrorOnNoConverge;  // throw an assert when the CG fails to converge.
+                           // Defaults true.
+  RealD Tolerance;
+  Integer MaxIterations;
+  Integer IterationsToComplete; // Iterations until the last system converged
+  std::vector<Integer> IterationsToCompleteRHS;
+  std::vector<RealD>   TrueResidualRHS;
+
+  ConjugateGradientMultiRHS(RealD tol, Integer maxit, bool err_on_no_conv = true)
+    : Tolerance(tol),
+      MaxIterations(maxit),
+      ErrorOnNoConverge(err_on_no_conv){};
+
+  void operator()(LinearOperatorBase<Field> &Linop, const Field &src, Field &psi) {
+    std::vector<Field> vsrc(1,src);
+    std::vector<Field> vpsi(1,psi);
+    (*this)(Linop,vsrc,vpsi);
+    psi = vpsi[0];
+  }
+
+  void operator()(LinearOperatorBase<Field> &Linop, const std::vector<Field> &src, std::vector<Field> &psi) {
+
+    int nrhs = src.size();
+    assert(psi.size() == nrhs);
+    if ( nrhs == 0 ) return;
+
+    GridBase *grid = src[0].Grid();
+
+    IterationsToCompleteRHS.assign(nrhs,0);
+    TrueResidualRHS.assign(nrhs,0.0);
+
+    std::vector<RealD> ssq(nrhs);
+    std::vector<RealD> rsq(nrhs);
+    for(int r=0;r<nrhs;r++){
+      psi[r].Checkerboard() = src[r].Checkerboard();
+      conformable(psi[r], src[r]);
+      RealD guess = norm2(psi[r]);
+      assert(std::isnan(guess) == 0);
+      ssq[r] = norm2(src[r]);
+      rsq[r] = Tolerance * Tolerance * ssq[r];
+    }
+
+    ////////////////////////////////////////////////////////
+    // Live systems; slot i solves system idx[i]. Systems with
+    // zero source are done before the first iteration.
+    ////////////////////////////////////////////////////////
+    std::vector<int> idx;
+    for(int r=0;r<nrhs;r++){
+      if ( ssq[r] == 0. ) {
+	psi[r] = Zero();
+	IterationsToCompleteRHS[r] = 1;
+      } else {
+	idx.push_back(r);
+      }
+    }
+    int nlive = idx.size();
+
+    std::vector<Field> R, W, P, S, X;
+    for(int i=0;i<nlive;i++){
+      X.push_back(psi[idx[i]]);
+      R.push_back(src[idx[i]]);
+      W.push_back(src[idx[i]]);
+      P.push_back(src[idx[i]]);
+      S.push_back(src[idx[i]]);
+    }
+
+    GridStopWatch LinalgTimer;
+    GridStopWatch ReduceTimer;
+    GridStopWatch MatrixTimer;
+    GridStopWatch SolverTimer;
+
+    SolverTimer.Start();
+
+    if ( nlive ) {
+      // r = b - A x ; w = A r
+      MatrixTimer.Start();
+      Linop.HermOpMultiRHS(X, W);
+      MatrixTimer.Stop();
+      for(int i=0;i<nlive;i++){
+	R[i] = src[idx[i]] - W[i];
+	P[i] = Zero();
+	S[i] = Zero();
+      }
+      MatrixTimer.Start();
+      Linop.HermOpMultiRHS(R, W);
+      MatrixTimer.Stop();
+    }
+
+    std::cout << GridLogIterative << "ConjugateGradientMultiRHS: " << nrhs << " systems, "
+	      << nlive << " with nonzero source" << std::endl;
+
+    std::vector<RealD> alpha(nlive, 1.0);
+    std::vector<RealD> gamma_old(nlive, 1.0);
+    std::vector<ComplexD> red(2*nlive);
+
+    int k;
+    for (k = 1; (k <= MaxIterations) && nlive; k++) {
+
+      ////////////////////////////////////////////////////////
+      // <r,w> and <r,r> of all live systems in one reduction
+      ////////////////////////////////////////////////////////
+      LinalgTimer.Start();
+      ReduceTimer.Start();
+      for(int i=0;i<nlive;i++){
+	rankInnerProductNorm(red[2*i], red[2*i+1], R[i], W[i]);
+      }
+      grid->GlobalSumVector(&red[0], 2*nlive);
+      ReduceTimer.Stop();
+      LinalgTimer.Stop();
+
+      ////////////////////////////////////////////////////////
+      // Retire converged systems, swapping the last live one
+      // into the vacated slot
+      ////////////////////////////////////////////////////////
+      for(int i=nlive-1;i>=0;i--){
+	RealD gamma = real(red[2*i+1]);
+	int r = idx[i];
+	if ( gamma <= rsq[r] ) {
+	  std::cout << GridLogIterative << "ConjugateGradientMultiRHS: system " << r
+		    << " converged on iteration " << k << " residual " << std::sqrt(gamma/ssq[r]) << std::endl;
+	  psi[r] = X[i];
+	  IterationsToCompleteRHS[r] = k;
+	  int l = nlive-1;
+	  if ( i != l ) {
+	    std::swap(X[i], X[l]);
+	    std::swap(R[i], R[l]);
+	    std::swap(W[i], W[l]);
+	    std::swap(P[i], P[l]);
+	    std::swap(S[i], S[l]);
+	    std::swap(idx[i], idx[l]);
+	    std::swap(alpha[i], alpha[l]);
+	    std::swap(gamma_old[i], gamma_old[l]);
+	    std::swap(red[2*i]  , red[2*l]);
+	    std::swap(red[2*i+1], red[2*l+1]);
+	  }
+	  X.pop_back(); R.pop_back(); W.pop_back(); P.pop_back(); S.pop_back();
+	  idx.pop_back(); alpha.pop_back(); gamma_old.pop_back();
+	  nlive--;
+	}
+      }
+      if ( nlive == 0 ) break;
+
+      std::cout << GridLogIterative << "ConjugateGradientMultiRHS: Iteration " << k
+		<< " live systems " << nlive << std::endl;
+
+      LinalgTimer.Start();
+      for(int i=0;i<nlive;i++){
+	RealD delta = real(red[2*i]);
+	RealD gamma = real(red[2*i+1]);
+	RealD beta;
+	if ( k == 1 ) {
+	  beta     = 0.0;
+	  alpha[i] = gamma / delta;
+	} else {
+	  beta     = gamma / gamma_old[i];
+	  alpha[i] = gamma / (delta - beta * gamma / alpha[i]);
+	}
+	gamma_old[i] = gamma;
+
+	RealD a = alpha[i];
+	RealD b = beta;
+	autoView( x_v , X[i], AcceleratorWrite);
+	autoView( r_v , R[i], AcceleratorWrite);
+	autoView( w_v , W[i], AcceleratorRead);
+	autoView( p_v , P[i], AcceleratorWrite);
+	autoView( s_v , S[i], AcceleratorWrite);
+	accelerator_for(ss,p_v.size(), Field::vector_object::Nsimd(),{
+	    auto sn = w_v(ss) + b * s_v(ss);
+	    auto pn = r_v(ss) + b * p_v(ss);
+	    coalescedWrite(s_v[ss], sn);
+	    coalescedWrite(p_v[ss], pn);
+	    coalescedWrite(x_v[ss], x_v(ss) + a * pn);
+	    coalescedWrite(r_v[ss], r_v(ss) - a * sn);
+	});
+      }
+      LinalgTimer.Stop();
+
+      MatrixTimer.Start();
+      Linop.HermOpMultiRHS(R, W);
+      MatrixTimer.Stop();
+    }
+    SolverTimer.Stop();
+
+    // Systems left running hit the iteration limit
+    for(int i=0;i<nlive;i++){
+      psi[idx[i]] = X[i];
+      IterationsToCompleteRHS[idx[i]] = k;
+    }
+    IterationsToComplete = k;
+
+    ////////////////////////////////////////////////////////
+    // True residuals, batched
+    ////////////////////////////////////////////////////////
+    {
+      std::vector<Field> AX(nrhs, grid);
+      Linop.HermOpMultiRHS(psi, AX);
+      for(int r=0;r<nrhs;r++){
+	AX[r] = AX[r] - src[r];
+	TrueResidualRHS[r] = (ssq[r]==0.) ? 0.0 : std::sqrt(norm2(AX[r])/ssq[r]);
+	std::cout << GridLogMessage << "ConjugateGradientMultiRHS system " << r
+		  << " iterations " << IterationsToCompleteRHS[r]
+		  << "\tTrue residual " << TrueResidualRHS[r]
+		  << "\tTarget " << Tolerance << std::endl;
+      }
+    }
+
+    std::cout << GridLogIterative << "Time breakdown "<<std::endl;
+    std::cout << GridLogIterative << "\tElapsed    " << SolverTimer.Elapsed() <<std::endl;
+    std::cout << GridLogIterative << "\tMatrix     " << MatrixTimer.Elapsed() <<std::endl;
+    std::cout << GridLogIterative << "\tLinalg     " << LinalgTimer.Elapsed() <<std::endl;
+    std::cout << GridLogIterative << "\tReduce     " << ReduceTimer.Elapsed() <<std::endl;
+
+    if ( nlive ) {
+      std::cout << GridLogMessage << "ConjugateGradientMultiRHS did NOT converge " << nlive
+		<< " of " << nrhs << " systems in " << MaxIterations << " iterations" << std::endl;
+      if (ErrorOnNoConverge) assert(0);
+    } else {
+      std::cout << GridLogMessage << "ConjugateGradientMultiRHS converged all " << nrhs
+		<< " systems in " << IterationsToComplete << " iterations" << std::endl;
+    }
+  }
+};
+NAMESPACE_END(Grid);
+#endif
@@ -0,0 +1,383 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/algorithms/iterative/ConjugateGradientMultiShiftMixedPrec.h
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#ifndef GRID_CONJUGATE_MULTI_SHIFT_GRADIENT_MIXED_PREC_H
+#define GRID_CONJUGATE_MULTI_SHIFT_GRADIENT_MIXED_PREC_H
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////
+// Mixed precision multi-shift CG; drop in for ConjugateGradientMultiShift.
+//
+// The shifted systems are iterated in the precision of FieldF with the
+// single precision operator given at construction (which may use half
+// precision comms). Solution increments are accumulated in FieldF and folded
+// into the FieldD solutions at each reliable update, when the primary
+// residual is recomputed with the double precision operator passed to
+// operator(). Reliable updates trigger when the residual has fallen by Delta
+// since the last one, as in ConjugateGradientReliableUpdate.
+//
+// Updating the primary residual only keeps the other poles approximately
+// collinear, so each pole whose true residual misses its tolerance from
+// MultiShiftFunction is finished by a double precision CG on its own shift.
+/////////////////////////////////////////////////////////////////////////////
+template<class FieldD,class FieldF,
+	 typename std::enable_if< getPrecision<FieldD>::value == 2, int>::type = 0,
+	 typename std::enable_if< getPrecision<FieldF>::value == 1, int>::type = 0>
+class ConjugateGradientMultiShiftMixedPrec : public OperatorMultiFunction<FieldD>,
+					     public OperatorFunction<FieldD>
+{
+public:
+
+  using OperatorFunction<FieldD>::operator();
+
+  Integer MaxIterations;
+  Integer IterationsToComplete; //Number of iterations the CG took to finish. Filled in upon completion
+  std::vector<int> IterationsToCompleteShift;  // Iterations for this shift
+  std::vector<int> IterationsToCleanupShift;   // Double precision cleanup iterations for this shift
+  Integer ReliableUpdatesPerformed;
+  MultiShiftFunction shifts;
+  std::vector<RealD> TrueResidualShift;
+
+  LinearOperatorBase<FieldF> &Linop_f;
+  GridBase *SinglePrecGrid;
+  RealD Delta; //reliable update parameter
+  bool DoFinalCleanup; //Per pole DP cleanup, defaults to true
+
+  ConjugateGradientMultiShiftMixedPrec(Integer maxit, MultiShiftFunction &_shifts,
+				       GridBase *_sp_grid, LinearOperatorBase<FieldF> &_Linop_f,
+				       RealD _delta = 0.1) :
+    MaxIterations(maxit),
+    shifts(_shifts),
+    Linop_f(_Linop_f),
+    SinglePrecGrid(_sp_grid),
+    Delta(_delta),
+    DoFinalCleanup(true)
+  {
+    IterationsToCompleteShift.resize(_shifts.order);
+    IterationsToCleanupShift.resize(_shifts.order);
+    TrueResidualShift.resize(_shifts.order);
+  }
+
+  void operator() (LinearOperatorBase<FieldD> &Linop_d, const FieldD &src, FieldD &psi)
+  {
+    GridBase *grid = src.Grid();
+    int nshift = shifts.order;
+    std::vector<FieldD> results(nshift,grid);
+    (*this)(Linop_d,src,results,psi);
+  }
+  void operator() (LinearOperatorBase<FieldD> &Linop_d, const FieldD &src, std::vector<FieldD> &results, FieldD &psi)
+  {
+    int nshift = shifts.order;
+
+    (*this)(Linop_d,src,results);
+
+    psi = shifts.norm*src;
+    for(int i=0;i<nshift;i++){
+      psi = psi + shifts.residues[i]*results[i];
+    }
+
+    return;
+  }
+
+  void operator() (LinearOperatorBase<FieldD> &Linop_d, const FieldD &src_d, std::vector<FieldD> &psi_d)
+  {
+    GridBase *grid = src_d.Grid();
+
+    ////////////////////////////////////////////////////////////////////////
+    // Convenience references to the info stored in "MultiShiftFunction"
+    ////////////////////////////////////////////////////////////////////////
+    int nshift = shifts.order;
+
+    std::vector<RealD> &mass(shifts.poles); // Make references to array in "shifts"
+    std::vector<RealD> &mresidual(shifts.tolerances);
+    std::vector<RealD> alpha(nshift,1.0);
+
+    assert(psi_d.size()==nshift);
+    assert(mass.size()==nshift);
+    assert(mresidual.size()==nshift);
+
+    // dynamic sized arrays on stack; 2d is a pain with vector
+    RealD  bs[nshift];
+    RealD  rsq[nshift];
+    RealD  z[nshift][2];
+    int     converged[nshift];
+
+    const int       primary =0;
+
+    //Primary shift fields CG iteration
+    RealD a,b,c,d;
+    RealD cp,bp,qq; //prev
+
+    // Check lightest mass
+    for(int s=0;s<nshift;s++){
+      assert( mass[s]>= mass[primary] );
+      converged[s]=0;
+      IterationsToCleanupShift[s]=0;
+      psi_d[s].Checkerboard() = src_d.Checkerboard();
+    }
+
+    cp = norm2(src_d);
+
+    // Handle trivial case of zero src.
+    if( cp == 0. ){
+      for(int s=0;s<nshift;s++){
+	psi_d[s] = Zero();
+	IterationsToCompleteShift[s] = 1;
+	TrueResidualShift[s] = 0.;
+      }
+      return;
+    }
+    RealD ssq = cp;
+
+    // Single precision iteration fields; psi_f holds the increments since
+    // the last reliable update
+    FieldF src_f(SinglePrecGrid);
+    src_f.Checkerboard() = src_d.Checkerboard();
+    precisionChange(src_f,src_d);
+
+    std::vector<FieldF> ps_f (nshift,SinglePrecGrid);// Search directions
+    std::vector<FieldF> psi_f(nshift,SinglePrecGrid);
+    FieldF r_f(src_f);
+    FieldF p_f(src_f);
+    FieldF mmp_f(src_f);
+
+    // Double precision residual for reliable updates
+    FieldD r_d(grid);
+    FieldD mmp_d(grid);
+
+    for(int s=0;s<nshift;s++){
+      rsq[s] = cp * mresidual[s] * mresidual[s];
+      std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec: shift "<<s
+	       <<" target resid "<<rsq[s]<<std::endl;
+      ps_f[s] = src_f;
+    }
+
+    //MdagM+m[0]
+    Linop_f.HermOpAndNorm(p_f,mmp_f,d,qq);
+    axpy(mmp_f,mass[0],p_f,mmp_f);
+    RealD rn = norm2(p_f);
+    d += rn*mass[0];
+
+    b = -cp /d;
+
+    // Set up the various shift variables
+    int       iz=0;
+    z[0][1-iz] = 1.0;
+    z[0][iz]   = 1.0;
+    bs[0]      = b;
+    for(int s=1;s<nshift;s++){
+      z[s][1-iz] = 1.0;
+      z[s][iz]   = 1.0/( 1.0 - b*(mass[s]-mass[0]));
+      bs[s]      = b*z[s][iz];
+    }
+
+    // r += b[0] A.p[0]
+    // c= norm(r)
+    c=axpy_norm(r_f,b,mmp_f,r_f);
+
+    for(int s=0;s<nshift;s++) {
+      axpby(psi_f[s],0.,-bs[s]*alpha[s],src_f,src_f);
+      psi_d[s] = Zero();
+    }
+
+    RealD MaxResidSinceLastRelUp = c;
+    ReliableUpdatesPerformed = 0;
+
+    ///////////////////////////////////////
+    // Timers
+    ///////////////////////////////////////
+    GridStopWatch AXPYTimer;
+    GridStopWatch ShiftTimer;
+    GridStopWatch MatrixTimer;
+    GridStopWatch ReliableTimer;
+    GridStopWatch CleanupTimer;
+    GridStopWatch SolverTimer;
+    SolverTimer.Start();
+
+    // Iteration loop
+    int k;
+    int all_converged = 0;
+
+    for (k=1;k<=MaxIterations;k++){
+
+      a = c /cp;
+      AXPYTimer.Start();
+      axpy(p_f,a,p_f,r_f);
+      for(int s=0;s<nshift;s++){
+	if ( ! converged[s] ) {
+	  if (s==0){
+	    axpy(ps_f[s],a,ps_f[s],r_f);
+	  } else{
+	    RealD as =a *z[s][iz]*bs[s] /(z[s][1-iz]*b);
+	    axpby(ps_f[s],z[s][iz],as,r_f,ps_f[s]);
+	  }
+	}
+      }
+      AXPYTimer.Stop();
+
+      cp=c;
+      MatrixTimer.Start();
+      Linop_f.HermOp(p_f,mmp_f);
+      d=real(innerProduct(p_f,mmp_f));
+      MatrixTimer.Stop();
+
+      AXPYTimer.Start();
+      axpy(mmp_f,mass[0],p_f,mmp_f);
+      AXPYTimer.Stop();
+      RealD rn = norm2(p_f);
+      d += rn*mass[0];
+
+      bp=b;
+      b=-cp/d;
+
+      AXPYTimer.Start();
+      c=axpy_norm(r_f,b,mmp_f,r_f);
+      AXPYTimer.Stop();
+
+      // Toggle the recurrence history
+      bs[0] = b;
+      iz = 1-iz;
+      ShiftTimer.Start();
+      for(int s=1;s<nshift;s++){
+	if((!converged[s])){
+	  RealD z0 = z[s][1-iz];
+	  RealD z1 = z[s][iz];
+	  z[s][iz] = z0*z1*bp
+	    / (b*a*(z1-z0) + z1*bp*(1- (mass[s]-mass[0])*b));
+	  bs[s] = b*z[s][iz]/z0; // NB sign  rel to Mike
+	}
+      }
+      ShiftTimer.Stop();
+
+      AXPYTimer.Start();
+      for(int s=0;s<nshift;s++){
+	if( (!converged[s]) ) {
+	  axpy(psi_f[s],-bs[s]*alpha[s],ps_f[s],psi_f[s]);
+	}
+      }
+      AXPYTimer.Stop();
+
+      // Convergence checks
+      all_converged = 1;
+      for(int s=0;s<nshift;s++){
+	if ( (!converged[s]) ){
+	  IterationsToCompleteShift[s] = k;
+	  RealD css  = c * z[s][iz]* z[s][iz];
+	  if(css<rsq[s]){
+	    std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec k="<<k<<" Shift "<<s<<" has converged"<<std::endl;
+	    converged[s]=1;
+	  } else {
+	    all_converged=0;
+	  }
+	}
+      }
+
+      if ( all_converged ) break;
+
+      if ( c > MaxResidSinceLastRelUp ) MaxResidSinceLastRelUp = c;
+
+      //////////////////////////////////////////////////////////
+      // Reliable update: fold the single precision increments
+      // into the solutions and recompute the primary residual.
+      // Once the primary has converged its solution is frozen
+      // and no longer tracks r, so the remaining poles finish on
+      // the iterated residual and are checked below.
+      //////////////////////////////////////////////////////////
+      if ( (!converged[primary]) && (c < Delta * MaxResidSinceLastRelUp) ) {
+	ReliableTimer.Start();
+	for(int s=0;s<nshift;s++){
+	  if ( ! converged[s] ) {
+	    precisionChange(mmp_d,psi_f[s]);
+	    psi_d[s] = psi_d[s] + mmp_d;
+	    psi_f[s] = Zero();
+	  }
+	}
+	Linop_d.HermOp(psi_d[primary],mmp_d);
+	axpy(mmp_d,mass[primary],psi_d[primary],mmp_d);
+	r_d = src_d - mmp_d;
+	RealD cn = norm2(r_d);
+	precisionChange(r_f,r_d);
+	std::cout<<GridLogIterative<<"ConjugateGradientMultiShiftMixedPrec k="<<k
+		 <<" reliable update; iterated residual "<<c<<" true "<<cn<<std::endl;
+	c = cn;
+	MaxResidSinceLastRelUp = c;
+	ReliableUpdatesPerformed++;
+	ReliableTimer.Stop();
+      }
+    }
+    SolverTimer.Stop();
+    IterationsToComplete = k;
+
+    if ( !all_converged ) {
+      std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec did not converge"<<std::endl;
+    } else {
+      std::cout<<GridLogMessage<< "ConjugateGradientMultiShiftMixedPrec: All shifts have converged iteration "<<k
+	       <<" after "<<ReliableUpdatesPerformed<<" reliable updates"<<std::endl;
+    }
+
+    for(int s=0;s<nshift;s++){
+      precisionChange(mmp_d,psi_f[s]);
+      psi_d[s] = psi_d[s] + mmp_d;
+    }
+
+    //////////////////////////////////////////////////////////
+    // Check answers, and clean up in double precision the
+    // poles that missed their tolerance
+    //////////////////////////////////////////////////////////
+    CleanupTimer.Start();
+    for(int s=0; s < nshift; s++) {
+      Linop_d.HermOp(psi_d[s],mmp_d);
+      axpy(mmp_d,mass[s],psi_d[s],mmp_d);
+      axpy(r_d,-alpha[s],src_d,mmp_d);
+      TrueResidualShift[s] = std::sqrt(norm2(r_d)/ssq);
+      std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec: shift["<<s<<"] true residual "<< TrueResidualShift[s]
+	       <<" target "<<mresidual[s]<<std::endl;
+
+      if ( DoFinalCleanup && (TrueResidualShift[s] > mresidual[s]) ) {
+	ShiftedHermOpLinearOperator<FieldD> ShiftedLinop(Linop_d,mass[s]);
+	ConjugateGradient<FieldD> CG(mresidual[s],MaxIterations,false);
+	CG(ShiftedLinop,src_d,psi_d[s]);
+	IterationsToCleanupShift[s] = CG.IterationsToComplete;
+	TrueResidualShift[s] = CG.TrueResidual;
+	std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec: shift["<<s<<"] cleaned up in "
+		 << IterationsToCleanupShift[s] <<" iterations, true residual "<<TrueResidualShift[s]<<std::endl;
+      }
+    }
+    CleanupTimer.Stop();
+
+    std::cout << GridLogMessage << "Time Breakdown "<<std::endl;
+    std::cout << GridLogMessage << "\tElapsed    " << SolverTimer.Elapsed()     <<std::endl;
+    std::cout << GridLogMessage << "\tAXPY       " << AXPYTimer.Elapsed()     <<std::endl;
+    std::cout << GridLogMessage << "\tMatrix     " << MatrixTimer.Elapsed()     <<std::endl;
+    std::cout << GridLogMessage << "\tShift      " << ShiftTimer.Elapsed()     <<std::endl;
+    std::cout << GridLogMessage << "\tReliable   " << ReliableTimer.Elapsed()     <<std::endl;
+    std::cout << GridLogMessage << "\tCleanup    " << CleanupTimer.Elapsed()     <<std::endl;
+  }
+
+};
+NAMESPACE_END(Grid);
+#endif
@@ -0,0 +1,265 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/algorithms/iterative/ConjugateGradientPipelined.h
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#ifndef GRID_CONJUGATE_GRADIENT_PIPELINED_H
+#define GRID_CONJUGATE_GRADIENT_PIPELINED_H
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////
+// Pipelined CG; P. Ghysels and W. Vanroose, Parallel Computing 40 (2014) 224
+//
+// Drop in replacement for ConjugateGradient. Carries the auxiliary vectors
+//
+//   w = A r,  s = A p,  z = A s
+//
+// so that gamma=<r,r> and delta=<r,w> are both available at the top of the
+// iteration. They are fused into a single non-blocking global reduction per
+// iteration which overlaps the operator application q = A w. The vector
+// recurrences are applied in one fused sweep.
+//
+// The extra recurrences let the computed residual drift from b-Ax, so the
+// true residual is periodically substituted (Cools et al, residual replacement):
+//
+//   r = b - A x,  w = A r,  s = A p,  z = A s
+//
+// every ReplaceInterval iterations, and whenever the recursed residual claims
+// convergence but the true residual disagrees.
+/////////////////////////////////////////////////////////////////////////////
+template <class Field>
+class ConjugateGradientPipelined : public OperatorFunction<Field> {
+public:
+
+  using OperatorFunction<Field>::operator();
+
+  bool ErrorOnNoConverge;  // throw an assert when the CG fails to converge.
+                           // Defaults true.
+  RealD Tolerance;
+  Integer MaxIterations;
+  Integer ReplaceInterval; // Residual replacement frequency; zero only replaces on convergence
+  Integer IterationsToComplete; //Number of iterations the CG took to finish. Filled in upon completion
+  Integer ReplacementsPerformed;
+  RealD TrueResidual;
+
+  ConjugateGradientPipelined(RealD tol, Integer maxit, bool err_on_no_conv = true, Integer replace = 100)
+    : Tolerance(tol),
+      MaxIterations(maxit),
+      ReplaceInterval(replace),
+      ErrorOnNoConverge(err_on_no_conv){};
+
+  void operator()(LinearOperatorBase<Field> &Linop, const Field &src, Field &psi) {
+
+    psi.Checkerboard() = src.Checkerboard();
+
+    conformable(psi, src);
+
+    GridBase *grid = src.Grid();
+
+    RealD alpha, beta, gamma, gamma_old, delta, ssq, d, qq;
+
+    Field r(src);
+    Field w(src);
+    Field p(src);
+    Field s(src);
+    Field z(src);
+    Field q(src);
+
+    // Initial residual computation & set up
+    RealD guess = norm2(psi);
+    assert(std::isnan(guess) == 0);
+
+    ssq = norm2(src);
+
+    // Handle trivial case of zero src
+    if (ssq == 0.){
+      psi = Zero();
+      IterationsToComplete = 1;
+      TrueResidual = 0.;
+      return;
+    }
+
+    RealD rsq = Tolerance * Tolerance * ssq;
+
+    Linop.HermOp(psi, q);
+    r = src - q;
+    Linop.HermOp(r, w);
+    p = Zero();
+    s = Zero();
+    z = Zero();
+
+    std::cout << GridLogIterative << std::setprecision(8) << "ConjugateGradientPipelined: guess " << guess << std::endl;
+    std::cout << GridLogIterative << std::setprecision(8) << "ConjugateGradientPipelined:   src " << ssq << std::endl;
+
+    GridStopWatch LinalgTimer;
+    GridStopWatch ReduceTimer;
+    GridStopWatch WaitTimer;
+    GridStopWatch LinearCombTimer;
+    GridStopWatch MatrixTimer;
+    GridStopWatch ReplaceTimer;
+    GridStopWatch SolverTimer;
+
+    ReplacementsPerformed = 0;
+    alpha = 1.0;
+    gamma_old = 1.0;
+
+    SolverTimer.Start();
+    int k;
+    bool restart = true;
+    for (k = 1; k <= MaxIterations; k++) {
+
+      ////////////////////////////////////////////////////////
+      // One reduction for <r,w> and <r,r>, in flight while
+      // the operator is applied.
+      ////////////////////////////////////////////////////////
+      LinalgTimer.Start();
+      ReduceTimer.Start();
+      ComplexD red[2];
+      CommsRequest_t req;
+      rankInnerProductNorm(red[0], red[1], r, w);
+      grid->GlobalSumVectorBegin(red, 2, req);
+      ReduceTimer.Stop();
+      LinalgTimer.Stop();
+
+      MatrixTimer.Start();
+      Linop.HermOp(w, q);
+      MatrixTimer.Stop();
+
+      WaitTimer.Start();
+      grid->GlobalSumVectorComplete(req);
+      WaitTimer.Stop();
+
+      delta = real(red[0]);
+      gamma = real(red[1]);
+
+      std::cout << GridLogIterative << "ConjugateGradientPipelined: Iteration " << k
+                << " residual " << sqrt(gamma/ssq) << " target " << Tolerance << std::endl;
+
+      // Stopping condition, verified against the true residual
+      if (gamma <= rsq) {
+	ReplaceTimer.Start();
+	Linop.HermOp(psi, q);
+	r = src - q;
+	RealD tsq = norm2(r);
+	ReplaceTimer.Stop();
+	if ( tsq <= rsq ) {
+	  SolverTimer.Stop();
+	  TrueResidual = std::sqrt(tsq/ssq);
+	  std::cout << GridLogMessage << "ConjugateGradientPipelined Converged on iteration " << k
+		    << "\tComputed residual " << std::sqrt(gamma / ssq)
+		    << "\tTrue residual " << TrueResidual
+		    << "\tTarget " << Tolerance << std::endl;
+	  std::cout << GridLogMessage << "ConjugateGradientPipelined performed " << ReplacementsPerformed
+		    << " residual replacements" << std::endl;
+
+	  std::cout << GridLogIterative << "Time breakdown "<<std::endl;
+	  std::cout << GridLogIterative << "\tElapsed    " << SolverTimer.Elapsed() <<std::endl;
+	  std::cout << GridLogIterative << "\tMatrix     " << MatrixTimer.Elapsed() <<std::endl;
+	  std::cout << GridLogIterative << "\tLinalg     " << LinalgTimer.Elapsed() <<std::endl;
+	  std::cout << GridLogIterative << "\tReduce     " << ReduceTimer.Elapsed() <<std::endl;
+	  std::cout << GridLogIterative << "\tReduceWait " << WaitTimer.Elapsed() <<std::endl;
+	  std::cout << GridLogIterative << "\tLinearComb " << LinearCombTimer.Elapsed() <<std::endl;
+	  std::cout << GridLogIterative << "\tReplace    " << ReplaceTimer.Elapsed() <<std::endl;
+
+	  IterationsToComplete = k;
+	  return;
+	}
+	// Recursed residual has drifted; restart the recurrence from the true residual
+	std::cout << GridLogIterative << "ConjugateGradientPipelined: true residual " << std::sqrt(tsq/ssq)
+		  << " exceeds recursed residual; restarting" << std::endl;
+	ReplaceTimer.Start();
+	Linop.HermOp(r, w);
+	p = Zero();
+	s = Zero();
+	z = Zero();
+	ReplaceTimer.Stop();
+	ReplacementsPerformed++;
+	restart = true;
+	continue;
+      }
+
+      if ( restart ) {
+	beta  = 0.0;
+	alpha = gamma / delta;
+	restart = false;
+      } else {
+	beta  = gamma / gamma_old;
+	alpha = gamma / (delta - beta * gamma / alpha);
+      }
+      gamma_old = gamma;
+
+      LinalgTimer.Start();
+      LinearCombTimer.Start();
+      {
+	RealD a = alpha;
+	RealD b = beta;
+	autoView( psi_v , psi, AcceleratorWrite);
+	autoView( r_v   , r,   AcceleratorWrite);
+	autoView( w_v   , w,   AcceleratorWrite);
+	autoView( p_v   , p,   AcceleratorWrite);
+	autoView( s_v   , s,   AcceleratorWrite);
+	autoView( z_v   , z,   AcceleratorWrite);
+	autoView( q_v   , q,   AcceleratorRead);
+	accelerator_for(ss,p_v.size(), Field::vector_object::Nsimd(),{
+	    auto zz = q_v(ss)   + b * z_v(ss);
+	    auto sn = w_v(ss)   + b * s_v(ss);
+	    auto pn = r_v(ss)   + b * p_v(ss);
+	    coalescedWrite(z_v[ss]  , zz);
+	    coalescedWrite(s_v[ss]  , sn);
+	    coalescedWrite(p_v[ss]  , pn);
+	    coalescedWrite(psi_v[ss], psi_v(ss) + a * pn);
+	    coalescedWrite(r_v[ss]  , r_v(ss)   - a * sn);
+	    coalescedWrite(w_v[ss]  , w_v(ss)   - a * zz);
+	});
+      }
+      LinearCombTimer.Stop();
+      LinalgTimer.Stop();
+
+      if ( ReplaceInterval && ((k % ReplaceInterval) == 0) ) {
+	ReplaceTimer.Start();
+	Linop.HermOp(psi, q);
+	r = src - q;
+	Linop.HermOp(r, w);
+	Linop.HermOp(p, s);
+	Linop.HermOp(s, z);
+	ReplaceTimer.Stop();
+	ReplacementsPerformed++;
+      }
+    }
+    // Failed. Calculate true residual before giving up
+    Linop.HermOpAndNorm(psi, q, d, qq);
+    r = q - src;
+
+    TrueResidual = sqrt(norm2(r)/ssq);
+
+    std::cout << GridLogMessage << "ConjugateGradientPipelined did NOT converge "<<k<<" / "<< MaxIterations<< std::endl;
+
+    if (ErrorOnNoConverge) assert(0);
+    IterationsToComplete = k;
+
+  }
+};
+NAMESPACE_END(Grid);
+#endif
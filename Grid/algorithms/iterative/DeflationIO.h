@@ -0,0 +1,441 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/algorithms/iterative/DeflationIO.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#ifndef GRID_DEFLATION_IO_H
+#define GRID_DEFLATION_IO_H
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Compact on-disk storage for local coherence deflation spaces.
+//
+// A deflation space <stem> is written as two files:
+//
+//   <stem>.xml   DeflationSpaceMetaData: sizes, precision, evals, checksums
+//   <stem>.bin   the nbasis fine basis vectors followed by the neig coarse
+//                eigenvectors, each at a fixed offset so that any one vector
+//                can be read on its own
+//
+// Each vector is stored in reduced precision, 16 or 32 bits per real.
+// In 16 bit mode each block of sites carries one float scale, the largest
+// |component| in the block, and the site data are stored as fp16 relative to
+// it. For fine vectors the blocks are the coarse grid blocks. For coarse
+// vectors each coarse site is its own block. A 16 bit vector record is the
+// block scales followed by the site data. A 32 bit record is the site data.
+//
+// All records go through BinaryIO::IOobject in lexicographic order, as
+// little endian 32 bit words.
+////////////////////////////////////////////////////////////////////////////////
+struct DeflationSpaceMetaData : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(DeflationSpaceMetaData,
+				  int, nbasis,
+				  int, neig,
+				  int, precision,      /* bits per real on disk: 16 or 32 */
+				  int, checkerboard,   /* of the fine basis */
+				  uint64_t, fine_bytes,   /* bytes per fine vector record */
+				  uint64_t, coarse_bytes, /* bytes per coarse vector record */
+				  std::vector<RealD>, eval_fine,
+				  std::vector<RealD>, eval_coarse,
+				  std::vector<uint32_t>, fine_checksum,
+				  std::vector<uint32_t>, coarse_checksum);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Read and write one reduced precision vector record at a given offset.
+// blockGrid must subdivide the grid of the field; it sets the scaling blocks.
+////////////////////////////////////////////////////////////////////////////////
+template<class vobj>
+class DeflationVectorIO {
+public:
+  typedef typename vobj::scalar_object sobj;
+  typedef typename vobj::Realified::scalar_type RealScalar;
+  static constexpr int Nreal = sizeof(sobj)/sizeof(RealScalar);
+  static_assert(Nreal%2==0,"DeflationVectorIO: records must be whole 32 bit words");
+
+  struct HalfSite   { uint16_t x[Nreal]; };
+  struct SingleSite { float    x[Nreal]; };
+
+  static uint64_t Bytes(GridBase *grid,GridBase *blockGrid,int precision)
+  {
+    assert(precision==16 || precision==32);
+    if ( precision == 16 ) {
+      return blockGrid->gSites()*sizeof(float) + grid->gSites()*sizeof(HalfSite);
+    }
+    return grid->gSites()*sizeof(SingleSite);
+  }
+
+  static uint32_t write(const std::string &file,uint64_t offset,
+			const Lattice<vobj> &in,GridBase *blockGrid,int precision)
+  {
+    GridBase *grid = in.Grid();
+    uint64_t lsites = grid->lSites();
+    uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    uint32_t csum = 0;
+    float w = 0;
+
+    std::vector<sobj> scalardata(lsites);
+    unvectorizeToLexOrdArray(scalardata,in);
+
+    if ( precision == 16 ) {
+      uint64_t bsites = blockGrid->lSites();
+      std::vector<int> map;
+      BlockMap(grid,blockGrid,map);
+
+      // Largest component per site, then per block
+      std::vector<float> sitemax(lsites);
+      thread_for(x,lsites,{
+	RealScalar *r = (RealScalar *)&scalardata[x];
+	RealScalar mx = 0.0;
+	for(int i=0;i<Nreal;i++) mx = std::max(mx,std::fabs(r[i]));
+	sitemax[x] = mx;
+      });
+      std::vector<float> scale(bsites,0.0);
+      for(uint64_t x=0;x<lsites;x++){
+	scale[map[x]] = std::max(scale[map[x]],sitemax[x]);
+      }
+
+      std::vector<HalfSite> iodata(lsites);
+      thread_for(x,lsites,{
+	RealScalar *r = (RealScalar *)&scalardata[x];
+	float s   = scale[map[x]];
+	float inv = (s > 0.0) ? 1.0/s : 0.0;
+	for(int i=0;i<Nreal;i++) iodata[x].x[i] = sfw_float_to_half(r[i]*inv).x;
+      });
+
+      // IOobject moves the offset it is given; keep ours fixed
+      uint64_t scale_offset = offset;
+      uint64_t data_offset  = offset + blockGrid->gSites()*sizeof(float);
+      BinaryIO::IOobject(w,blockGrid,scale,file,scale_offset,"IEEE32",
+			 BinaryIO::BINARYIO_WRITE|BinaryIO::BINARYIO_LEXICOGRAPHIC,
+			 nersc_csum,scidac_csuma,scidac_csumb);
+      csum += nersc_csum;
+      BinaryIO::IOobject(w,grid,iodata,file,data_offset,"IEEE32",
+			 BinaryIO::BINARYIO_WRITE|BinaryIO::BINARYIO_LEXICOGRAPHIC,
+			 nersc_csum,scidac_csuma,scidac_csumb);
+      csum += nersc_csum;
+    } else {
+      assert(precision==32);
+      std::vector<SingleSite> iodata(lsites);
+      thread_for(x,lsites,{
+	RealScalar *r = (RealScalar *)&scalardata[x];
+	for(int i=0;i<Nreal;i++) iodata[x].x[i] = r[i];
+      });
+      BinaryIO::IOobject(w,grid,iodata,file,offset,"IEEE32",
+			 BinaryIO::BINARYIO_WRITE|BinaryIO::BINARYIO_LEXICOGRAPHIC,
+			 nersc_csum,scidac_csuma,scidac_csumb);
+      csum += nersc_csum;
+    }
+    return csum;
+  }
+
+  static uint32_t read(const std::string &file,uint64_t offset,
+		       Lattice<vobj> &out,GridBase *blockGrid,int precision)
+  {
+    GridBase *grid = out.Grid();
+    uint64_t lsites = grid->lSites();
+    uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    uint32_t csum = 0;
+    float w = 0;
+
+    std::vector<sobj> scalardata(lsites);
+
+    if ( precision == 16 ) {
+      uint64_t bsites = blockGrid->lSites();
+      std::vector<int> map;
+      BlockMap(grid,blockGrid,map);
+
+      std::vector<float>    scale(bsites);
+      std::vector<HalfSite> iodata(lsites);
+      // IOobject moves the offset it is given; keep ours fixed
+      uint64_t scale_offset = offset;
+      uint64_t data_offset  = offset + blockGrid->gSites()*sizeof(float);
+      BinaryIO::IOobject(w,blockGrid,scale,file,scale_offset,"IEEE32",
+			 BinaryIO::BINARYIO_READ|BinaryIO::BINARYIO_LEXICOGRAPHIC,
+			 nersc_csum,scidac_csuma,scidac_csumb);
+      csum += nersc_csum;
+      BinaryIO::IOobject(w,grid,iodata,file,data_offset,"IEEE32",
+			 BinaryIO::BINARYIO_READ|BinaryIO::BINARYIO_LEXICOGRAPHIC,
+			 nersc_csum,scidac_csuma,scidac_csumb);
+      csum += nersc_csum;
+
+      thread_for(x,lsites,{
+	RealScalar *r = (RealScalar *)&scalardata[x];
+	float s = scale[map[x]];
+	for(int i=0;i<Nreal;i++) r[i] = sfw_half_to_float(Grid_half(iodata[x].x[i]))*s;
+      });
+    } else {
+      assert(precision==32);
+      std::vector<SingleSite> iodata(lsites);
+      BinaryIO::IOobject(w,grid,iodata,file,offset,"IEEE32",
+			 BinaryIO::BINARYIO_READ|BinaryIO::BINARYIO_LEXICOGRAPHIC,
+			 nersc_csum,scidac_csuma,scidac_csumb);
+      csum += nersc_csum;
+      thread_for(x,lsites,{
+	RealScalar *r = (RealScalar *)&scalardata[x];
+	for(int i=0;i<Nreal;i++) r[i] = iodata[x].x[i];
+      });
+    }
+
+    vectorizeFromLexOrdArray(scalardata,out);
+    return csum;
+  }
+
+private:
+
+  // Local lexicographic site -> local lexicographic block
+  static void BlockMap(GridBase *grid,GridBase *blockGrid,std::vector<int> &map)
+  {
+    int ndim = grid->Nd();
+    assert(blockGrid->Nd() == ndim);
+    Coordinate ldims = grid->LocalDimensions();
+    Coordinate bdims = blockGrid->LocalDimensions();
+    Coordinate block(ndim);
+    for(int d=0;d<ndim;d++){
+      block[d] = ldims[d]/bdims[d];
+      assert(block[d]*bdims[d]==ldims[d]);
+    }
+    uint64_t lsites = grid->lSites();
+    map.resize(lsites);
+    thread_for(x,lsites,{
+      Coordinate lcoor(ndim);
+      Coordinate bcoor(ndim);
+      Lexicographic::CoorFromIndex(lcoor,x,ldims);
+      for(int d=0;d<ndim;d++) bcoor[d] = lcoor[d]/block[d];
+      int b;
+      Lexicographic::IndexFromCoor(bcoor,b,bdims);
+      map[x] = b;
+    });
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Write/read a whole deflation space, or single vectors of it
+////////////////////////////////////////////////////////////////////////////////
+template<class Fobj,class CComplex,int nbasis>
+class DeflationSpaceIO {
+public:
+  typedef iVector<CComplex,nbasis >           CoarseSiteVector;
+  typedef Lattice<CoarseSiteVector>           CoarseField;
+  typedef Lattice<Fobj>                       FineField;
+
+  static std::string binFile(const std::string &stem) { return stem + ".bin"; }
+  static std::string xmlFile(const std::string &stem) { return stem + ".xml"; }
+
+  static void write(const std::string &stem,
+		    const std::vector<FineField>   &subspace,
+		    const std::vector<RealD>       &eval_fine,
+		    const std::vector<CoarseField> &evec_coarse,
+		    const std::vector<RealD>       &eval_coarse,
+		    int precision=16)
+  {
+    assert(subspace.size()==nbasis);
+    assert(evec_coarse.size()==eval_coarse.size());
+    assert(evec_coarse.size()>0);
+    GridBase *FineGrid   = subspace[0].Grid();
+    GridBase *CoarseGrid = evec_coarse[0].Grid();
+
+    DeflationSpaceMetaData md;
+    md.nbasis       = nbasis;
+    md.neig         = evec_coarse.size();
+    md.precision    = precision;
+    md.checkerboard = subspace[0].Checkerboard();
+    md.fine_bytes   = DeflationVectorIO<Fobj>::Bytes(FineGrid,CoarseGrid,precision);
+    md.coarse_bytes = DeflationVectorIO<CoarseSiteVector>::Bytes(CoarseGrid,CoarseGrid,precision);
+    md.eval_fine    = eval_fine;
+    md.eval_coarse  = eval_coarse;
+    md.fine_checksum.resize(md.nbasis);
+    md.coarse_checksum.resize(md.neig);
+
+    std::string file = binFile(stem);
+    GridStopWatch timer; timer.Start();
+    for(int v=0;v<md.nbasis;v++){
+      md.fine_checksum[v] = DeflationVectorIO<Fobj>::write(file,fineOffset(md,v),subspace[v],CoarseGrid,precision);
+    }
+    for(int i=0;i<md.neig;i++){
+      md.coarse_checksum[i] = DeflationVectorIO<CoarseSiteVector>::write(file,coarseOffset(md,i),evec_coarse[i],CoarseGrid,precision);
+    }
+    timer.Stop();
+
+    if ( FineGrid->IsBoss() ) {
+      XmlWriter WR(xmlFile(stem));
+      Grid::write(WR,"DeflationSpace",md);
+    }
+    FineGrid->Barrier();
+
+    uint64_t bytes = md.nbasis*md.fine_bytes + md.neig*md.coarse_bytes;
+    std::cout << GridLogMessage << "DeflationSpaceIO: wrote "<< md.nbasis<<" fine and "<<md.neig
+	      <<" coarse vectors, "<<bytes<<" bytes in "<<timer.Elapsed()<<std::endl;
+  }
+
+  static void readMetaData(const std::string &stem,DeflationSpaceMetaData &md)
+  {
+    XmlReader RD(xmlFile(stem));
+    Grid::read(RD,"DeflationSpace",md);
+    assert(md.nbasis==nbasis);
+  }
+
+  static void readFine(const std::string &stem,const DeflationSpaceMetaData &md,
+		       int v,FineField &out,GridBase *CoarseGrid)
+  {
+    assert(v<md.nbasis);
+    assert(md.fine_bytes==DeflationVectorIO<Fobj>::Bytes(out.Grid(),CoarseGrid,md.precision));
+    uint32_t csum = DeflationVectorIO<Fobj>::read(binFile(stem),fineOffset(md,v),out,CoarseGrid,md.precision);
+    if ( csum != md.fine_checksum[v] ) {
+      std::cout << GridLogError << "DeflationSpaceIO: checksum mismatch on fine vector "<<v<<std::endl;
+      assert(0);
+    }
+    out.Checkerboard() = md.checkerboard;
+  }
+
+  static void readCoarse(const std::string &stem,const DeflationSpaceMetaData &md,
+			 int i,CoarseField &out)
+  {
+    GridBase *CoarseGrid = out.Grid();
+    assert(i<md.neig);
+    assert(md.coarse_bytes==DeflationVectorIO<CoarseSiteVector>::Bytes(CoarseGrid,CoarseGrid,md.precision));
+    uint32_t csum = DeflationVectorIO<CoarseSiteVector>::read(binFile(stem),coarseOffset(md,i),out,CoarseGrid,md.precision);
+    if ( csum != md.coarse_checksum[i] ) {
+      std::cout << GridLogError << "DeflationSpaceIO: checksum mismatch on coarse vector "<<i<<std::endl;
+      assert(0);
+    }
+  }
+
+  // Everything resident, e.g. to restart LocalCoherenceLanczos
+  static void read(const std::string &stem,
+		   GridBase *FineGrid,GridBase *CoarseGrid,
+		   std::vector<FineField>   &subspace,
+		   std::vector<RealD>       &eval_fine,
+		   std::vector<CoarseField> &evec_coarse,
+		   std::vector<RealD>       &eval_coarse)
+  {
+    DeflationSpaceMetaData md;
+    readMetaData(stem,md);
+    subspace.resize(md.nbasis,FineGrid);
+    evec_coarse.resize(md.neig,CoarseGrid);
+    for(int v=0;v<md.nbasis;v++) readFine  (stem,md,v,subspace[v],CoarseGrid);
+    for(int i=0;i<md.neig  ;i++) readCoarse(stem,md,i,evec_coarse[i]);
+    eval_fine   = md.eval_fine;
+    eval_coarse = md.eval_coarse;
+  }
+
+  static uint64_t fineOffset  (const DeflationSpaceMetaData &md,int v) { return v*md.fine_bytes; }
+  static uint64_t coarseOffset(const DeflationSpaceMetaData &md,int i) { return md.nbasis*md.fine_bytes + i*md.coarse_bytes; }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fine basis on disk, indexable like std::vector<FineField> so it can be handed
+// to blockProject/blockPromote. A vector is read on access; only the last one
+// read is held in memory.
+////////////////////////////////////////////////////////////////////////////////
+template<class Fobj,class CComplex,int nbasis>
+class DeflationSubspaceStream {
+public:
+  typedef DeflationSpaceIO<Fobj,CComplex,nbasis> IO;
+  typedef typename IO::FineField FineField;
+
+  DeflationSubspaceStream(const std::string &stem,const DeflationSpaceMetaData &md,
+			  GridBase *FineGrid,GridBase *CoarseGrid)
+    : _stem(stem), _md(md), _CoarseGrid(CoarseGrid), current(-1), buffer(FineGrid)
+  {};
+
+  int size(void) const { return _md.nbasis; }
+
+  const FineField & operator[](int v) const {
+    if ( v != current ) {
+      IO::readFine(_stem,_md,v,buffer,_CoarseGrid);
+      current = v;
+    }
+    return buffer;
+  }
+
+private:
+  std::string                   _stem;
+  DeflationSpaceMetaData        _md;   // copied: callers may pass a temporary
+  GridBase                     *_CoarseGrid;
+  mutable int                   current;
+  mutable FineField             buffer;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// LocalCoherenceDeflatedGuesser reading the deflation space from disk.
+// The fine basis is streamed in twice per guess, once to project and once to
+// promote. The coarse eigenvectors are kept resident unless streamCoarse is
+// set, in which case they are read one at a time as well.
+////////////////////////////////////////////////////////////////////////////////
+template<class Fobj,class CComplex,int nbasis>
+class StreamingLocalCoherenceDeflatedGuesser: public LinearFunction<Lattice<Fobj> > {
+public:
+  typedef DeflationSpaceIO<Fobj,CComplex,nbasis> IO;
+  typedef typename IO::FineField   FineField;
+  typedef typename IO::CoarseField CoarseField;
+
+private:
+  std::string                                      stem;
+  DeflationSpaceMetaData                           md;
+  GridBase                                        *_CoarseGrid;
+  bool                                             streamCoarse;
+  DeflationSubspaceStream<Fobj,CComplex,nbasis>    subspace;
+  std::vector<CoarseField>                         evec_coarse;
+
+public:
+
+  StreamingLocalCoherenceDeflatedGuesser(const std::string &_stem,
+					 GridBase *FineGrid,GridBase *CoarseGrid,
+					 bool _streamCoarse=false)
+    : stem(_stem), md(readMetaData(_stem)), _CoarseGrid(CoarseGrid),
+      streamCoarse(_streamCoarse), subspace(_stem,md,FineGrid,CoarseGrid)
+  {
+    if ( !streamCoarse ) {
+      evec_coarse.resize(md.neig,CoarseGrid);
+      for(int i=0;i<md.neig;i++) IO::readCoarse(stem,md,i,evec_coarse[i]);
+    }
+  }
+
+  void operator()(const FineField &src,FineField &guess) {
+    CoarseField src_coarse(_CoarseGrid);
+    CoarseField guess_coarse(_CoarseGrid);    guess_coarse = Zero();
+    CoarseField tmp(_CoarseGrid);
+    blockProject(src_coarse,src,subspace);
+    for (int i=0;i<md.neig;i++) {
+      if ( streamCoarse ) IO::readCoarse(stem,md,i,tmp);
+      const CoarseField & evec = streamCoarse ? tmp : evec_coarse[i];
+      axpy(guess_coarse,TensorRemove(innerProduct(evec,src_coarse)) / md.eval_coarse[i],evec,guess_coarse);
+    }
+    blockPromote(guess_coarse,guess,subspace);
+    guess.Checkerboard() = src.Checkerboard();
+  };
+
+private:
+  static DeflationSpaceMetaData readMetaData(const std::string &stem)
+  {
+    DeflationSpaceMetaData md;
+    IO::readMetaData(stem,md);
+    return md;
+  }
+};
+
+NAMESPACE_END(Grid);
+#endif
@@ -403,6 +403,20 @@ public:
       std::cout << i << " Coarse eval = " << evals_coarse[i]  << std::endl;
     }
   }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Compact reduced precision checkpoint of the deflation space, see
+  // DeflationIO.h. Use StreamingLocalCoherenceDeflatedGuesser to deflate
+  // from it without reading it all into memory.
+  //////////////////////////////////////////////////////////////////////////
+  void saveDeflationSpace(std::string stem,int precision=16)
+  {
+    DeflationSpaceIO<Fobj,CComplex,nbasis>::write(stem,subspace,evals_fine,evec_coarse,evals_coarse,precision);
+  }
+  void loadDeflationSpace(std::string stem)
+  {
+    DeflationSpaceIO<Fobj,CComplex,nbasis>::read(stem,_FineGrid,_CoarseGrid,subspace,evals_fine,evec_coarse,evals_coarse);
+  }
 };
 
 NAMESPACE_END(Grid);
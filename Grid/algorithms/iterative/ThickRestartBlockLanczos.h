@@ -0,0 +1,331 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/algorithms/iterative/ThickRestartBlockLanczos.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#ifndef GRID_THICK_RESTART_BLOCK_LANCZOS_H
+#define GRID_THICK_RESTART_BLOCK_LANCZOS_H
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////////
+// Thick restarted block Lanczos (block Krylov-Schur for a Hermitian operator)
+//
+// The Krylov space is grown Nblock vectors at a time: PolyOp is applied to the
+// whole block through its multi-RHS interface, so FunctionHermOp over a
+// Chebyshev polynomial batches the Dslash over the block when the operator
+// provides HermOpMultiRHS. Each new block is fully reorthogonalised against the
+// basis with block CGS2, and the overlaps fill the projected (banded, arrow
+// headed after a restart) matrix H = V^dag PolyOp V.
+//
+// When the basis reaches Nm vectors H is diagonalised with Eigen. The Nk
+// largest Ritz pairs of PolyOp are kept, the rest discarded, and the residual
+// block is appended so that PolyOp V = V H + F B e^dag still holds. Leading
+// Ritz vectors that pass the HermOp convergence test are locked: they stay in
+// the basis for orthogonalisation but are decoupled from H and no longer rotated.
+//
+// Nm-Nk must be a positive multiple of Nblock. The Nblock starting vectors
+// need not be orthonormal.
+/////////////////////////////////////////////////////////////////////////////////
+template<class Field>
+class ThickRestartBlockLanczos {
+ private:
+  typedef typename Field::scalar_type Coeff_t;
+  typedef Eigen::Matrix<Coeff_t,Eigen::Dynamic,Eigen::Dynamic> RotationMatrix;
+
+  int MaxIter; // Max restarts
+  int Nstop;   // Number of evecs sought
+  int Nk;      // Number kept on restart
+  int Nm;      // Total number of vectors
+  int Nblock;  // Block size
+  RealD eresid;
+
+  RealD OrthoTime;
+  RealD OpTime;
+  ////////////////////////////////
+  // Embedded objects
+  ////////////////////////////////
+  LinearFunction<Field>       &_PolyOp;
+  LinearFunction<Field>       &_HermOp;
+  ImplicitlyRestartedLanczosTester<Field> &_Tester;
+  ImplicitlyRestartedLanczosHermOpTester<Field> SimpleTester;
+
+public:
+
+  ThickRestartBlockLanczos(LinearFunction<Field> & PolyOp,
+			   LinearFunction<Field> & HermOp,
+			   ImplicitlyRestartedLanczosTester<Field> & Tester,
+			   int _Nstop, int _Nk, int _Nm, int _Nblock,
+			   RealD _eresid, int _MaxIter) :
+    SimpleTester(HermOp), _PolyOp(PolyOp), _HermOp(HermOp), _Tester(Tester),
+    Nstop(_Nstop), Nk(_Nk), Nm(_Nm), Nblock(_Nblock),
+    eresid(_eresid), MaxIter(_MaxIter)
+  {
+    Check();
+  };
+
+  ThickRestartBlockLanczos(LinearFunction<Field> & PolyOp,
+			   LinearFunction<Field> & HermOp,
+			   int _Nstop, int _Nk, int _Nm, int _Nblock,
+			   RealD _eresid, int _MaxIter) :
+    SimpleTester(HermOp), _PolyOp(PolyOp), _HermOp(HermOp), _Tester(SimpleTester),
+    Nstop(_Nstop), Nk(_Nk), Nm(_Nm), Nblock(_Nblock),
+    eresid(_eresid), MaxIter(_MaxIter)
+  {
+    Check();
+  };
+
+  void calc(std::vector<RealD>& eval, std::vector<Field>& evec, const std::vector<Field>& src, int& Nconv, bool reverse=false)
+  {
+    GridBase *grid = src[0].Grid();
+    assert(grid == evec[0].Grid());
+    assert(src.size() == Nblock);
+    assert(Nm <= evec.size() && Nm <= eval.size());
+
+    std::cout << GridLogIRL <<"**************************************************************************"<< std::endl;
+    std::cout << GridLogIRL <<" ThickRestartBlockLanczos::calc() starting iteration 0 /  "<< MaxIter<< std::endl;
+    std::cout << GridLogIRL <<"**************************************************************************"<< std::endl;
+    std::cout << GridLogIRL <<" -- seek   Nstop  = " << Nstop  <<" vectors"<< std::endl;
+    std::cout << GridLogIRL <<" -- keep   Nk     = " << Nk     <<" vectors"<< std::endl;
+    std::cout << GridLogIRL <<" -- total  Nm     = " << Nm     <<" vectors"<< std::endl;
+    std::cout << GridLogIRL <<" -- block  Nblock = " << Nblock <<" vectors"<< std::endl;
+    std::cout << GridLogIRL <<"**************************************************************************"<< std::endl;
+
+    RealD evalMaxApprox = MaxEvalApprox(src[0]);
+
+    Eigen::MatrixXcd H = Eigen::MatrixXcd::Zero(Nm,Nm); // V^dag PolyOp V
+    Eigen::MatrixXcd B = Eigen::MatrixXcd::Zero(Nblock,Nblock); // Residual block coupling
+    std::vector<Field> F(Nblock,grid);
+    std::vector<RealD> evalH(Nm,0.0);     // HermOp eigenvalues of locked vectors
+    std::vector<RealD> thetaLock(Nm,0.0); // PolyOp eigenvalues of locked vectors
+
+    // Orthonormal starting block
+    for(int b=0;b<Nblock;b++){
+      evec[b] = src[b];
+      basisOrthogonalize(evec,evec[b],b);
+      normalise(evec[b]);
+    }
+
+    int Nlock = 0;
+    int p0    = 0;
+    int iter;
+    OrthoTime = 0.;
+    OpTime    = 0.;
+    for(iter=0; iter<MaxIter; ++iter){
+
+      std::cout<< GridLogMessage <<" **********************"<< std::endl;
+      std::cout<< GridLogMessage <<" Restart iteration = "<< iter << std::endl;
+      std::cout<< GridLogMessage <<" **********************"<< std::endl;
+
+      for(int p=p0; p<Nm; p+=Nblock) blockStep(H,B,evec,F,Nlock,p);
+      std::cout<<GridLogIRL <<" Extended basis to "<<Nm<<" vectors: OpTime "<<OpTime<<" s OrthoTime "<<OrthoTime<<" s"<<std::endl;
+
+      //////////////////////////////////
+      // Diagonalise the active part of H, largest first
+      //////////////////////////////////
+      int Nact = Nm-Nlock;
+      Eigen::MatrixXcd Hact = H.block(Nlock,Nlock,Nact,Nact);
+      Hact = 0.5*(Hact + Hact.adjoint());
+      Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> eigensolver(Hact);
+      std::vector<RealD> theta(Nact);
+      Eigen::MatrixXcd S(Nact,Nact);
+      for(int i=0;i<Nact;i++){
+	theta[i]  = eigensolver.eigenvalues()(Nact-1-i);
+	S.col(i)  = eigensolver.eigenvectors().col(Nact-1-i);
+      }
+      const int chunk=8;
+      for(int io=0; io<Nk-Nlock;io+=chunk){
+	std::cout<<GridLogIRL << "eval "<< std::setw(3) << io+Nlock ;
+	for(int ii=0;ii<chunk;ii++){
+	  if ( (io+ii)<Nk-Nlock )
+	    std::cout<< " "<< std::setw(12)<< theta[io+ii];
+	}
+	std::cout << std::endl;
+      }
+
+      //////////////////////////////////
+      // Thick restart: keep the leading Ritz vectors
+      //////////////////////////////////
+      RotationMatrix Qt = RotationMatrix::Zero(Nm,Nm);
+      for(int j=0;j<Nk-Nlock;j++){
+	for(int k=0;k<Nact;k++){
+	  Qt(Nlock+j,Nlock+k) = Coeff_t(S(k,j));
+	}
+      }
+      basisRotate(evec,Qt,Nlock,Nk,Nlock,Nm,Nm);
+
+      // Coupling of the kept Ritz vectors to the residual block
+      Eigen::MatrixXcd C = B * S.block(Nact-Nblock,0,Nblock,Nk-Nlock);
+
+      ////////////////////////////////////////////////////
+      // Lock the leading Ritz vectors that have converged
+      ////////////////////////////////////////////////////
+      int Nnew = 0;
+      {
+	Field Bv(grid);
+	for(int j=Nlock;j<Nk;j++){
+	  Bv = evec[j];
+	  RealD e = theta[j-Nlock];
+	  if ( !_Tester.TestConvergence(j,eresid,Bv,e,evalMaxApprox) ) break;
+	  evalH[j]     = e;
+	  thetaLock[j] = theta[j-Nlock];
+	  Nnew++;
+	}
+      }
+
+      H = Eigen::MatrixXcd::Zero(Nm,Nm);
+      for(int j=0;j<Nlock;j++) H(j,j) = thetaLock[j];
+      for(int j=Nlock;j<Nk;j++) H(j,j) = theta[j-Nlock];
+      for(int j=Nlock+Nnew;j<Nk;j++){
+	for(int b=0;b<Nblock;b++){
+	  H(Nk+b,j) = C(b,j-Nlock);
+	  H(j,Nk+b) = std::conj(C(b,j-Nlock));
+	}
+      }
+      Nlock += Nnew;
+
+      std::cout<<GridLogIRL<<" #modes locked: "<<Nlock<<"/"<<Nstop<<std::endl;
+      if ( Nlock >= Nstop ) goto converged;
+
+      // Residual block continues the Krylov space
+      for(int b=0;b<Nblock;b++) evec[Nk+b] = F[b];
+      p0 = Nk;
+    }
+
+    std::cout<<GridLogError<<"\n NOT converged.\n";
+    abort();
+
+  converged:
+    Nconv = Nlock;
+    eval.resize(Nconv);
+    for(int j=0;j<Nconv;j++) eval[j] = evalH[j];
+    evec.resize(Nconv,grid);
+    basisSortInPlace(evec,eval,reverse);
+
+    std::cout << GridLogIRL <<"**************************************************************************"<< std::endl;
+    std::cout << GridLogIRL << "ThickRestartBlockLanczos CONVERGED ; Summary :\n";
+    std::cout << GridLogIRL <<"**************************************************************************"<< std::endl;
+    std::cout << GridLogIRL << " -- Iterations  = "<< iter      << "\n";
+    std::cout << GridLogIRL << " -- Nconv       = "<< Nconv     << "\n";
+    std::cout << GridLogIRL << " -- OpTime      = "<< OpTime    << " s\n";
+    std::cout << GridLogIRL << " -- OrthoTime   = "<< OrthoTime << " s\n";
+    std::cout << GridLogIRL <<"**************************************************************************"<< std::endl;
+  }
+
+ private:
+
+  void Check(void)
+  {
+    assert(Nblock > 0);
+    assert(Nstop <= Nk);
+    assert(Nk+Nblock <= Nm);
+    assert((Nm-Nk)%Nblock == 0);
+  }
+
+  template<typename T>  static RealD normalise(T& v)
+  {
+    RealD nn = norm2(v);
+    nn = std::sqrt(nn);
+    v = v * (1.0/nn);
+    return nn;
+  }
+
+  // Rough power method estimate of the largest eigenvalue, normalising the residuals
+  RealD MaxEvalApprox(const Field &src)
+  {
+    RealD evalMaxApprox = 0.0;
+    auto src_n = src;
+    auto tmp = src;
+    const int _MAX_ITER_IRL_MEVAPP_ = 50;
+    for (int i=0;i<_MAX_ITER_IRL_MEVAPP_;i++) {
+      normalise(src_n);
+      _HermOp(src_n,tmp);
+      RealD vnum = real(innerProduct(src_n,tmp));
+      RealD vden = norm2(src_n);
+      RealD na = vnum/vden;
+      if (fabs(evalMaxApprox/na - 1.0) < 0.0001)
+	i=_MAX_ITER_IRL_MEVAPP_;
+      evalMaxApprox = na;
+      src_n = tmp;
+    }
+    std::cout << GridLogIRL << " Approximation of largest eigenvalue: " << evalMaxApprox << std::endl;
+    return evalMaxApprox;
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // Apply PolyOp to the block evec[p..p+Nblock) and orthonormalise the
+  // result against evec[0..p+Nblock) and within itself. The overlaps
+  // fill columns p..p+Nblock of H; the new block goes to evec[p+Nblock..)
+  // or, if the basis is full, to the residual block F with coupling B.
+  /////////////////////////////////////////////////////////////////////
+  void blockStep(Eigen::MatrixXcd &H,Eigen::MatrixXcd &B,
+		 std::vector<Field> &evec,std::vector<Field> &F,
+		 int Nlock,int p)
+  {
+    const RealD tiny = 1.0e-20;
+    GridBase *grid = evec[0].Grid();
+    std::cout<<GridLogIRL << "Block Lanczos step " <<p<<std::endl;
+
+    std::vector<Field> in(evec.begin()+p,evec.begin()+p+Nblock);
+    std::vector<Field> w(Nblock,grid);
+    OpTime-=usecond()/1e6;
+    _PolyOp(in,w);
+    OpTime+=usecond()/1e6;
+
+    OrthoTime-=usecond()/1e6;
+    int nbasis = p+Nblock;
+    bool last  = (nbasis == Nm);
+    Eigen::MatrixXcd R = Eigen::MatrixXcd::Zero(Nblock,Nblock);
+    std::vector<ComplexD> coeff;
+    for(int b=0;b<Nblock;b++){
+      basisOrthogonalize(evec,w[b],nbasis,coeff);
+      // Locked vectors are decoupled; the overlaps with them are rounding
+      for(int i=Nlock;i<nbasis;i++){
+	H(i,p+b) = coeff[i];
+	H(p+b,i) = std::conj(coeff[i]);
+      }
+      basisOrthogonalize(w,w[b],b,coeff);
+      for(int c=0;c<b;c++) R(c,b) = coeff[c];
+      RealD beta = normalise(w[b]);
+      R(b,b) = beta;
+      if ( beta < tiny )
+	std::cout<<GridLogIRL << " beta is tiny "<<beta<<" : block Krylov space is (nearly) invariant"<<std::endl;
+    }
+    if ( last ) {
+      for(int b=0;b<Nblock;b++) F[b] = w[b];
+      B = R;
+    } else {
+      for(int b=0;b<Nblock;b++){
+	evec[nbasis+b] = w[b];
+	for(int c=0;c<Nblock;c++){
+	  H(nbasis+c,p+b) = R(c,b);
+	  H(p+b,nbasis+c) = std::conj(R(c,b));
+	}
+      }
+    }
+    OrthoTime+=usecond()/1e6;
+  }
+};
+
+NAMESPACE_END(Grid);
+#endif
@@ -4,14 +4,11 @@ NAMESPACE_BEGIN(Grid);
 
 /*Allocation types, saying which pointer cache should be used*/
 #define Cpu      (0)
-#define CpuSmall (1)
-#define Acc      (2)
-#define AccSmall (3)
-#define Shared   (4)
-#define SharedSmall (5)
-uint64_t total_shared;
-uint64_t total_device;
-uint64_t total_host;;
+#define Acc      (1)
+#define Shared   (2)
+std::atomic<uint64_t> total_shared;
+std::atomic<uint64_t> total_device;
+std::atomic<uint64_t> total_host;
 void MemoryManager::PrintBytes(void)
 {
   std::cout << " MemoryManager : "<<total_shared<<" shared      bytes "<<std::endl;
@@ -20,17 +17,46 @@ void MemoryManager::PrintBytes(void)
 }
 
 //////////////////////////////////////////////////////////////////////
-// Data tables for recently freed pooiniter caches
+// Data tables for recently freed pointer caches
 //////////////////////////////////////////////////////////////////////
-MemoryManager::AllocationCacheEntry MemoryManager::Entries[MemoryManager::NallocType][MemoryManager::NallocCacheMax];
-int MemoryManager::Victim[MemoryManager::NallocType];
-int MemoryManager::Ncache[MemoryManager::NallocType] = { 8, 32, 8, 32, 8, 32 };
+MemoryManager::AllocationCacheEntry MemoryManager::Entries[MemoryManager::NallocCacheMax];
+std::atomic<uint64_t> MemoryManager::EntriesFree;
+std::atomic<uint32_t> MemoryManager::EntriesUsed;
+std::atomic<uint64_t> MemoryManager::CacheHead  [MemoryManager::NallocType][MemoryManager::NallocClass];
+std::atomic<uint32_t> MemoryManager::CacheCount [MemoryManager::NallocType][MemoryManager::NallocClass];
+std::atomic<uint64_t> MemoryManager::CacheHits  [MemoryManager::NallocType][MemoryManager::NallocClass];
+std::atomic<uint64_t> MemoryManager::CacheMisses[MemoryManager::NallocType][MemoryManager::NallocClass];
+std::atomic<uint64_t> MemoryManager::CacheBytes [MemoryManager::NallocType];
+std::atomic_flag      MemoryManager::CacheTrimming[MemoryManager::NallocType] = { ATOMIC_FLAG_INIT, ATOMIC_FLAG_INIT, ATOMIC_FLAG_INIT };
+int      MemoryManager::Ncache[2] = { 8, 32 };
+uint64_t MemoryManager::CacheHighWater = 1024ULL*1024*1024;
+uint64_t MemoryManager::CacheLowWater  =  768ULL*1024*1024;
+
+//////////////////////////////////////////////////////////////////////
+// Per thread front end for the small classes. Plain old data so that
+// it is zero initialised and safe to touch during static destruction.
+// A separate drain object, constructed when the thread first caches a
+// block, returns the slots to the central lists at thread exit.
+//////////////////////////////////////////////////////////////////////
+struct MemoryThreadCache {
+  void *slot[MemoryManager::NallocType][MemoryManager::NallocSmallClass][MemoryManager::NallocThreadCache];
+  int   n   [MemoryManager::NallocType][MemoryManager::NallocSmallClass];
+};
+static thread_local MemoryThreadCache ThreadCache;
+
+struct MemoryThreadCacheDrain {
+  int armed;
+  MemoryThreadCacheDrain() : armed(1) {};
+  ~MemoryThreadCacheDrain() { MemoryManager::DrainThreadCache(); }
+};
+static thread_local MemoryThreadCacheDrain ThreadCacheDrain;
 
 //////////////////////////////////////////////////////////////////////
 // Actual allocation and deallocation utils
 //////////////////////////////////////////////////////////////////////
 void *MemoryManager::AcceleratorAllocate(size_t bytes)
 {
+  bytes = CacheRound(bytes);
   void *ptr = (void *) Lookup(bytes,Acc);
   if ( ptr == (void *) NULL ) {
     ptr = (void *) acceleratorAllocDevice(bytes);
@@ -40,15 +66,11 @@ void *MemoryManager::AcceleratorAllocate(size_t bytes)
 }
 void  MemoryManager::AcceleratorFree    (void *ptr,size_t bytes)
 {
-  void *__freeme = Insert(ptr,bytes,Acc);
-  if ( __freeme ) {
-    acceleratorFreeDevice(__freeme);
-    total_device-=bytes;
-    //    PrintBytes();
-  }
+  Insert(ptr,CacheRound(bytes),Acc);
 }
 void *MemoryManager::SharedAllocate(size_t bytes)
 {
+  bytes = CacheRound(bytes);
   void *ptr = (void *) Lookup(bytes,Shared);
   if ( ptr == (void *) NULL ) {
     ptr = (void *) acceleratorAllocShared(bytes);
@@ -60,16 +82,12 @@ void *MemoryManager::SharedAllocate(size_t bytes)
 }
 void  MemoryManager::SharedFree    (void *ptr,size_t bytes)
 {
-  void *__freeme = Insert(ptr,bytes,Shared);
-  if ( __freeme ) {
-    acceleratorFreeShared(__freeme);
-    total_shared-=bytes;
-    //    PrintBytes();
-  }
+  Insert(ptr,CacheRound(bytes),Shared);
 }
 #ifdef GRID_UVM
 void *MemoryManager::CpuAllocate(size_t bytes)
 {
+  bytes = CacheRound(bytes);
   void *ptr = (void *) Lookup(bytes,Cpu);
   if ( ptr == (void *) NULL ) {
     ptr = (void *) acceleratorAllocShared(bytes);
@@ -77,18 +95,10 @@ void *MemoryManager::CpuAllocate(size_t bytes)
   }
   return ptr;
 }
-void  MemoryManager::CpuFree    (void *_ptr,size_t bytes)
-{
-  NotifyDeletion(_ptr);
-  void *__freeme = Insert(_ptr,bytes,Cpu);
-  if ( __freeme ) { 
-    acceleratorFreeShared(__freeme);
-    total_host-=bytes;
-  }
-}
 #else
 void *MemoryManager::CpuAllocate(size_t bytes)
 {
+  bytes = CacheRound(bytes);
   void *ptr = (void *) Lookup(bytes,Cpu);
   if ( ptr == (void *) NULL ) {
     ptr = (void *) acceleratorAllocCpu(bytes);
@@ -96,16 +106,35 @@ void *MemoryManager::CpuAllocate(size_t bytes)
   }
   return ptr;
 }
+#endif
 void  MemoryManager::CpuFree    (void *_ptr,size_t bytes)
 {
   NotifyDeletion(_ptr);
-  void *__freeme = Insert(_ptr,bytes,Cpu);
-  if ( __freeme ) { 
-    acceleratorFreeCpu(__freeme);
+  Insert(_ptr,CacheRound(bytes),Cpu);
+}
+void MemoryManager::Release(void *ptr,size_t bytes,int type)
+{
+  switch(type) {
+  case Cpu:
+#ifdef GRID_UVM
+    acceleratorFreeShared(ptr);
+#else
+    acceleratorFreeCpu(ptr);
+#endif
     total_host-=bytes;
+    break;
+  case Acc:
+    acceleratorFreeDevice(ptr);
+    total_device-=bytes;
+    break;
+  case Shared:
+    acceleratorFreeShared(ptr);
+    total_shared-=bytes;
+    break;
+  default:
+    assert(0);
   }
 }
-#endif
 
 //////////////////////////////////////////
 // call only once
@@ -115,15 +144,12 @@ void MemoryManager::Init(void)
 
   char * str;
   int Nc;
-  int NcS;
   
   str= getenv("GRID_ALLOC_NCACHE_LARGE");
   if ( str ) {
     Nc = atoi(str);
     if ( (Nc>=0) && (Nc < NallocCacheMax)) {
-      Ncache[Cpu]=Nc;
-      Ncache[Acc]=Nc;
-      Ncache[Shared]=Nc;
+      Ncache[0]=Nc;
     }
   }
 
@@ -131,9 +157,16 @@ void MemoryManager::Init(void)
   if ( str ) {
     Nc = atoi(str);
     if ( (Nc>=0) && (Nc < NallocCacheMax)) {
-      Ncache[CpuSmall]=Nc;
-      Ncache[AccSmall]=Nc;
-      Ncache[SharedSmall]=Nc;
+      Ncache[1]=Nc;
+    }
+  }
+
+  str= getenv("GRID_ALLOC_CACHE_HIGHWATER_MB");
+  if ( str ) {
+    long long MB = atoll(str);
+    if ( MB>=0 ) {
+      CacheHighWater = MB*1024LL*1024LL;
+      CacheLowWater  = (CacheHighWater/4)*3;
     }
   }
 
@@ -147,7 +180,8 @@ void MemoryManager::InitMessage(void) {
   
   std::cout << GridLogMessage<< "MemoryManager::Init() setting up"<<std::endl;
 #ifdef ALLOCATION_CACHE
-  std::cout << GridLogMessage<< "MemoryManager::Init() cache pool for recent allocations: SMALL "<<Ncache[CpuSmall]<<" LARGE "<<Ncache[Cpu]<<std::endl;
+  std::cout << GridLogMessage<< "MemoryManager::Init() cache pool for recent allocations: per size class SMALL "<<Ncache[1]<<" LARGE "<<Ncache[0]<<std::endl;
+  std::cout << GridLogMessage<< "MemoryManager::Init() cache pool high water mark "<<CacheHighWater<<" bytes "<<std::endl;
 #endif
   
 #ifdef GRID_UVM
@@ -176,79 +210,201 @@ void MemoryManager::InitMessage(void) {
 
 }
 
-void *MemoryManager::Insert(void *ptr,size_t bytes,int type) 
+//////////////////////////////////////////////////////////////////////
+// Size classes: 2^e < bytes <= 2^(e+1) split into NallocClassSub
+// equal steps; class zero holds everything up to 2^NallocClassMin
+//////////////////////////////////////////////////////////////////////
+int MemoryManager::SizeClass(size_t bytes)
+{
+  if ( bytes <= (((size_t)1)<<NallocClassMin) ) return 0;
+  int e = 63 - __builtin_clzll(bytes-1);
+  assert(e < 48);
+  size_t base = ((size_t)1)<<e;
+  size_t step = base / NallocClassSub;
+  int sub = (bytes - base + step - 1) / step;
+  return (e-NallocClassMin)*NallocClassSub + sub;
+}
+size_t MemoryManager::SizeClassBytes(int sclass)
+{
+  if ( sclass==0 ) return ((size_t)1)<<NallocClassMin;
+  int e   = (sclass-1)/NallocClassSub + NallocClassMin;
+  int sub = (sclass-1)%NallocClassSub + 1;
+  size_t base = ((size_t)1)<<e;
+  return base + sub * (base / NallocClassSub);
+}
+size_t MemoryManager::CacheRound(size_t bytes)
 {
 #ifdef ALLOCATION_CACHE
-  bool small = (bytes < GRID_ALLOC_SMALL_LIMIT);
-  int cache = type + small;
-  return Insert(ptr,bytes,Entries[cache],Ncache[cache],Victim[cache]);  
+  return SizeClassBytes(SizeClass(bytes));
 #else
-  return ptr;
+  return bytes;
 #endif
 }
 
-void *MemoryManager::Insert(void *ptr,size_t bytes,AllocationCacheEntry *entries,int ncache,int &victim) 
+//////////////////////////////////////////////////////////////////////
+// Lock free stacks of entry indices. The head carries index+1 in the
+// low word and a modification count in the high word to defeat ABA.
+//////////////////////////////////////////////////////////////////////
+int MemoryManager::Pop(std::atomic<uint64_t> &head)
 {
-  assert(ncache>0);
-#ifdef GRID_OMP
-  assert(omp_in_parallel()==0);
-#endif 
-
-  void * ret = NULL;
-  int v = -1;
+  uint64_t old = head.load(std::memory_order_acquire);
+  uint64_t nxt;
+  do {
+    uint32_t e = old & 0xFFFFFFFF;
+    if ( e==0 ) return -1;
+    nxt = (((old>>32)+1)<<32) | Entries[e-1].next.load(std::memory_order_relaxed);
+  } while ( !head.compare_exchange_weak(old,nxt,std::memory_order_acq_rel,std::memory_order_acquire) );
+  return (int)(old & 0xFFFFFFFF) - 1;
+}
+void MemoryManager::Push(std::atomic<uint64_t> &head,int e)
+{
+  uint64_t old = head.load(std::memory_order_relaxed);
+  uint64_t nxt;
+  do {
+    Entries[e].next.store(old & 0xFFFFFFFF,std::memory_order_relaxed);
+    nxt = (((old>>32)+1)<<32) | (uint64_t)(e+1);
+  } while ( !head.compare_exchange_weak(old,nxt,std::memory_order_release,std::memory_order_relaxed) );
+}
 
-  for(int e=0;e<ncache;e++) {
-    if ( entries[e].valid==0 ) {
-      v=e; 
-      break;
+void *MemoryManager::CentralLookup(int type,int sclass)
+{
+  int e = Pop(CacheHead[type][sclass]);
+  if ( e<0 ) return NULL;
+  void *ptr = Entries[e].address;
+  Push(EntriesFree,e);
+  CacheCount[type][sclass]--;
+  CacheBytes[type]-=SizeClassBytes(sclass);
+  return ptr;
+}
+bool MemoryManager::CentralInsert(void *ptr,int type,int sclass)
+{
+  int small = (sclass < NallocSmallClass);
+  uint64_t bytes = SizeClassBytes(sclass);
+  if ( CacheBytes[type].fetch_add(bytes) + bytes > CacheHighWater ) {
+    CacheBytes[type]-=bytes;
+    return false;
+  }
+  if ( CacheCount[type][sclass]++ >= Ncache[small] ) {
+    CacheCount[type][sclass]--;
+    CacheBytes[type]-=bytes;
+    return false;
+  }
+  int e = Pop(EntriesFree);
+  if ( e<0 ) {
+    e = EntriesUsed++;
+    if ( e>=NallocCacheMax ) {
+      EntriesUsed--;
+      CacheCount[type][sclass]--;
+      CacheBytes[type]-=bytes;
+      return false;
     }
   }
+  Entries[e].address = ptr;
+  Push(CacheHead[type][sclass],e);
+  return true;
+}
 
-  if ( v==-1 ) {
-    v=victim;
-    victim = (victim+1)%ncache;
+//////////////////////////////////////////////////////////////////////
+// High water mark: release the largest cached blocks first, one
+// trimmer at a time per memory type, down to the low water mark
+//////////////////////////////////////////////////////////////////////
+void MemoryManager::Trim(int type)
+{
+  if ( CacheTrimming[type].test_and_set(std::memory_order_acquire) ) return;
+  for(int c=NallocClass-1;(c>=0) && (CacheBytes[type] > CacheLowWater);c--){
+    void *ptr;
+    while ( (CacheBytes[type] > CacheLowWater) && (ptr=CentralLookup(type,c)) ) {
+      Release(ptr,SizeClassBytes(c),type);
+    }
   }
+  CacheTrimming[type].clear(std::memory_order_release);
+}
 
-  if ( entries[v].valid ) {
-    ret = entries[v].address;
-    entries[v].valid = 0;
-    entries[v].address = NULL;
-    entries[v].bytes = 0;
+void MemoryManager::Insert(void *ptr,size_t bytes,int type) 
+{
+#ifdef ALLOCATION_CACHE
+  int c = SizeClass(bytes);
+  if ( c < NallocSmallClass ) {
+    int &n = ThreadCache.n[type][c];
+    if ( n < NallocThreadCache ) {
+      ThreadCacheDrain.armed = 1;
+      ThreadCache.slot[type][c][n++] = ptr;
+      return;
+    }
   }
+  if ( CentralInsert(ptr,type,c) ) return;
+  // Over the cap: make room and try once more
+  if ( CacheBytes[type] + SizeClassBytes(c) > CacheHighWater ) {
+    Trim(type);
+    if ( CentralInsert(ptr,type,c) ) return;
+  }
+#endif
+  Release(ptr,bytes,type);
+}
 
-  entries[v].address=ptr;
-  entries[v].bytes  =bytes;
-  entries[v].valid  =1;
-
-  return ret;
+void MemoryManager::DrainThreadCache(void)
+{
+#ifdef ALLOCATION_CACHE
+  for(int type=0;type<NallocType;type++){
+    for(int c=0;c<NallocSmallClass;c++){
+      int &n = ThreadCache.n[type][c];
+      while ( n > 0 ) {
+	void *ptr = ThreadCache.slot[type][c][--n];
+	if ( !CentralInsert(ptr,type,c) ) Release(ptr,SizeClassBytes(c),type);
+      }
+    }
+  }
+#endif
 }
 
 void *MemoryManager::Lookup(size_t bytes,int type)
 {
 #ifdef ALLOCATION_CACHE
-  bool small = (bytes < GRID_ALLOC_SMALL_LIMIT);
-  int cache = type+small;
-  return Lookup(bytes,Entries[cache],Ncache[cache]);
+  int c = SizeClass(bytes);
+  void *ptr = NULL;
+  if ( c < NallocSmallClass ) {
+    int &n = ThreadCache.n[type][c];
+    if ( n > 0 ) ptr = ThreadCache.slot[type][c][--n];
+  }
+  if ( ptr == NULL ) ptr = CentralLookup(type,c);
+  if ( ptr ) CacheHits[type][c].fetch_add(1,std::memory_order_relaxed);
+  else       CacheMisses[type][c].fetch_add(1,std::memory_order_relaxed);
+  return ptr;
 #else
   return NULL;
 #endif
 }
 
-void *MemoryManager::Lookup(size_t bytes,AllocationCacheEntry *entries,int ncache) 
+void MemoryManager::CacheStatistics(int type,std::vector<MemoryCacheStats> &stats)
 {
-  assert(ncache>0);
-#ifdef GRID_OMP
-  assert(omp_in_parallel()==0);
-#endif 
-  for(int e=0;e<ncache;e++){
-    if ( entries[e].valid && ( entries[e].bytes == bytes ) ) {
-      entries[e].valid = 0;
-      return entries[e].address;
-    }
+  assert( (type>=0) && (type<NallocType) );
+  stats.resize(0);
+  for(int c=0;c<NallocClass;c++){
+    MemoryCacheStats s;
+    s.bytes  = SizeClassBytes(c);
+    s.hits   = CacheHits[type][c];
+    s.misses = CacheMisses[type][c];
+    s.cached = CacheCount[type][c];
+    if ( s.hits || s.misses || s.cached ) stats.push_back(s);
   }
-  return NULL;
 }
 
+void MemoryManager::PrintCacheStatistics(void)
+{
+  const char *name[NallocType] = { "Cpu", "Acc", "Shared" };
+  std::vector<MemoryCacheStats> stats;
+  for(int t=0;t<NallocType;t++){
+    CacheStatistics(t,stats);
+    if ( stats.size()==0 ) continue;
+    std::cout << GridLogMessage << "MemoryManager "<<name[t]<<" allocation cache: "<<CacheBytes[t]<<" bytes cached"<<std::endl;
+    for(int s=0;s<stats.size();s++){
+      std::cout << GridLogMessage << "\t class "<<std::setw(12)<<stats[s].bytes
+		<< " hits "  <<std::setw(8)<<stats[s].hits
+		<< " misses "<<std::setw(8)<<stats[s].misses
+		<< " cached "<<stats[s].cached<<std::endl;
+    }
+  }
+}
 
 NAMESPACE_END(Grid);
 
@@ -28,6 +28,7 @@ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
 /*  END LEGAL */
 #pragma once
 #include <list> 
+#include <atomic>
 #include <unordered_map>  
 
 NAMESPACE_BEGIN(Grid);
@@ -70,26 +71,66 @@ private:
 
   ////////////////////////////////////////////////////////////
   // For caching recently freed allocations
+  //
+  // Requests are rounded up to a size class; 8 classes per
+  // power of two above 64 bytes, so at most 12.5% is wasted and
+  // fields of similar size share a pool.
+  //
+  // Each class keeps a lock free (tagged Treiber stack) central
+  // list of cached blocks per memory type. Small classes are
+  // fronted by a per thread cache, so temporaries may be
+  // allocated and freed inside threaded regions.
+  //
+  // The high water mark caps the bytes held per memory type. A
+  // block that does not fit triggers a release of the largest
+  // classes down to the low water mark, and is itself released
+  // if it still does not fit. A thread's cached small blocks go
+  // back to the central lists when the thread exits.
   ////////////////////////////////////////////////////////////
   typedef struct { 
     void *address;
-    size_t bytes;
-    int valid;
+    std::atomic<uint32_t> next;
   } AllocationCacheEntry;
 
-  static const int NallocCacheMax=128; 
-  static const int NallocType=6;
-  static AllocationCacheEntry Entries[NallocType][NallocCacheMax];
-  static int Victim[NallocType];
-  static int Ncache[NallocType];
+  static const int NallocCacheMax=4096; 
+  static const int NallocType=3;
+  static const int NallocClassMin=6;   // 64 byte smallest class
+  static const int NallocClassSub=8;   // classes per power of two
+  static const int NallocClass=NallocClassSub*(48-NallocClassMin)+1;
+  static const int NallocSmallClass=NallocClassSub*(12-NallocClassMin)+1; // up to GRID_ALLOC_SMALL_LIMIT
+  static const int NallocThreadCache=4;
+
+  static AllocationCacheEntry  Entries[NallocCacheMax];
+  static std::atomic<uint64_t> EntriesFree;  // tagged head of unused entries
+  static std::atomic<uint32_t> EntriesUsed;  // entries ever handed out
+
+  static std::atomic<uint64_t> CacheHead  [NallocType][NallocClass]; // tagged head of class list
+  static std::atomic<uint32_t> CacheCount [NallocType][NallocClass];
+  static std::atomic<uint64_t> CacheHits  [NallocType][NallocClass];
+  static std::atomic<uint64_t> CacheMisses[NallocType][NallocClass];
+  static std::atomic<uint64_t> CacheBytes [NallocType];
+  static std::atomic_flag      CacheTrimming[NallocType];
+
+  static int      Ncache[2];             // per class entry limit, large and small
+  static uint64_t CacheHighWater;        // bytes per memory type
+  static uint64_t CacheLowWater;
 
   /////////////////////////////////////////////////
   // Free pool
   /////////////////////////////////////////////////
-  static void *Insert(void *ptr,size_t bytes,int type) ;
-  static void *Lookup(size_t bytes,int type) ;
-  static void *Insert(void *ptr,size_t bytes,AllocationCacheEntry *entries,int ncache,int &victim) ;
-  static void *Lookup(size_t bytes,AllocationCacheEntry *entries,int ncache) ;
+  static int    SizeClass(size_t bytes);
+  static size_t SizeClassBytes(int sclass);
+  static size_t CacheRound(size_t bytes);
+  static int    Pop (std::atomic<uint64_t> &head);
+  static void   Push(std::atomic<uint64_t> &head,int e);
+  static void  *CentralLookup(int type,int sclass);
+  static bool   CentralInsert(void *ptr,int type,int sclass);
+  static void   Trim(int type);
+  static void   Release(void *ptr,size_t bytes,int type);
+  static void   Insert(void *ptr,size_t bytes,int type) ;
+  static void  *Lookup(size_t bytes,int type) ;
+
+  friend struct MemoryThreadCache;
 
   static void PrintBytes(void);
  public:
@@ -102,6 +143,15 @@ private:
   static void *CpuAllocate(size_t bytes);
   static void  CpuFree    (void *ptr,size_t bytes);
 
+  ////////////////////////////////////////////////////////
+  // Allocation cache statistics; type is 0 Cpu, 1 Acc, 2 Shared
+  ////////////////////////////////////////////////////////
+  static void CacheStatistics(int type,std::vector<MemoryCacheStats> &stats);
+  static void PrintCacheStatistics(void);
+  // Hand the calling thread's cached blocks to the central lists;
+  // runs automatically when a thread that cached blocks exits
+  static void DrainThreadCache(void);
+
   ////////////////////////////////////////////////////////
   // Footprint tracking
   ////////////////////////////////////////////////////////
@@ -38,6 +38,13 @@ struct MemoryStats
   size_t totalAllocated{0}, maxAllocated{0}, 
     currentlyAllocated{0}, totalFreed{0};
 };
+
+// Allocation cache activity for one size class
+struct MemoryCacheStats
+{
+  size_t   bytes{0};
+  uint64_t hits{0}, misses{0}, cached{0};
+};
     
 class MemoryProfiler
 {
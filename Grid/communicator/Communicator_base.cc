@@ -71,6 +71,20 @@ void CartesianCommunicator::GlobalSumVector(ComplexD *c,int N)
 {
   GlobalSumVector((double *)c,2*N);
 }
+void CartesianCommunicator::GlobalSumVectorBegin(ComplexF *c,int N,CommsRequest_t &req)
+{
+  GlobalSumVectorBegin((float *)c,2*N,req);
+}
+void CartesianCommunicator::GlobalSumVectorBegin(ComplexD *c,int N,CommsRequest_t &req)
+{
+  GlobalSumVectorBegin((double *)c,2*N,req);
+}
+void CartesianCommunicator::GlobalSumVectorComplete(std::vector<CommsRequest_t> &reqs)
+{
+  for(int i=0;i<reqs.size();i++){
+    GlobalSumVectorComplete(reqs[i]);
+  }
+}
   
 NAMESPACE_END(Grid);
 
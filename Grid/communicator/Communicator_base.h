@@ -129,6 +129,20 @@ public:
     scalar_type * ptr = (scalar_type *)& o;
     GlobalSumVector(ptr,words);
   }
+
+  ////////////////////////////////////////////////////////////
+  // Non-blocking reduction; in place, so the buffer must not be
+  // touched until the matching Complete. Test drives progress
+  // and returns 1 once the result is available.
+  ////////////////////////////////////////////////////////////
+  void GlobalSumVectorBegin(RealF *,int N,CommsRequest_t &req);
+  void GlobalSumVectorBegin(RealD *,int N,CommsRequest_t &req);
+  void GlobalSumVectorBegin(uint64_t*,int N,CommsRequest_t &req);
+  void GlobalSumVectorBegin(ComplexF *c,int N,CommsRequest_t &req);
+  void GlobalSumVectorBegin(ComplexD *c,int N,CommsRequest_t &req);
+  int  GlobalSumVectorTest(CommsRequest_t &req);
+  void GlobalSumVectorComplete(CommsRequest_t &req);
+  void GlobalSumVectorComplete(std::vector<CommsRequest_t> &reqs);
   
   ////////////////////////////////////////////////////////////
   // Face exchange, buffer swap in translational invariant way
@@ -156,6 +170,21 @@ public:
   void StencilSendToRecvFromComplete(std::vector<CommsRequest_t> &waitall,int i);
   void StencilBarrier(void);
 
+  ////////////////////////////////////////////////////////////
+  // Persistent form of the halo primitive: requests are set up
+  // once by Init, then restarted and waited on every exchange.
+  ////////////////////////////////////////////////////////////
+  double StencilSendToRecvFromInit(std::vector<CommsRequest_t> &list,
+				   void *xmit,
+				   int xmit_to_rank,
+				   void *recv,
+				   int recv_from_rank,
+				   int bytes,int dir);
+  void StencilSendToRecvFromStart(std::vector<CommsRequest_t> &list,int dir);
+  void StencilSendToRecvFromWait (std::vector<CommsRequest_t> &list,int dir);
+  int  StencilSendToRecvFromTest (std::vector<CommsRequest_t> &list,int dir);
+  static void StencilSendToRecvFromFree(std::vector<CommsRequest_t> &list);
+
   ////////////////////////////////////////////////////////////
   // Barrier
   ////////////////////////////////////////////////////////////
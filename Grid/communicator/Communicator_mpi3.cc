@@ -304,6 +304,33 @@ void CartesianCommunicator::GlobalSumVector(double *d,int N)
   int ierr = MPI_Allreduce(MPI_IN_PLACE,d,N,MPI_DOUBLE,MPI_SUM,communicator);
   assert(ierr==0);
 }
+void CartesianCommunicator::GlobalSumVectorBegin(float *f,int N,CommsRequest_t &req)
+{
+  int ierr=MPI_Iallreduce(MPI_IN_PLACE,f,N,MPI_FLOAT,MPI_SUM,communicator,&req);
+  assert(ierr==0);
+}
+void CartesianCommunicator::GlobalSumVectorBegin(double *d,int N,CommsRequest_t &req)
+{
+  int ierr=MPI_Iallreduce(MPI_IN_PLACE,d,N,MPI_DOUBLE,MPI_SUM,communicator,&req);
+  assert(ierr==0);
+}
+void CartesianCommunicator::GlobalSumVectorBegin(uint64_t *u,int N,CommsRequest_t &req)
+{
+  int ierr=MPI_Iallreduce(MPI_IN_PLACE,u,N,MPI_UINT64_T,MPI_SUM,communicator,&req);
+  assert(ierr==0);
+}
+int CartesianCommunicator::GlobalSumVectorTest(CommsRequest_t &req)
+{
+  int flag;
+  int ierr=MPI_Test(&req,&flag,MPI_STATUS_IGNORE);
+  assert(ierr==0);
+  return flag;
+}
+void CartesianCommunicator::GlobalSumVectorComplete(CommsRequest_t &req)
+{
+  int ierr=MPI_Wait(&req,MPI_STATUS_IGNORE);
+  assert(ierr==0);
+}
 // Basic Halo comms primitive
 void CartesianCommunicator::SendToRecvFrom(void *xmit,
 					   int dest,
@@ -403,6 +430,93 @@ void CartesianCommunicator::StencilSendToRecvFromComplete(std::vector<CommsReque
   assert(ierr==0);
   list.resize(0);
 }
+double CartesianCommunicator::StencilSendToRecvFromInit(std::vector<CommsRequest_t> &list,
+							void *xmit,
+							int dest,
+							void *recv,
+							int from,
+							int bytes,int dir)
+{
+  int ncomm  =communicator_halo.size();
+  int commdir=dir%ncomm;
+
+  MPI_Request xrq;
+  MPI_Request rrq;
+
+  int ierr;
+  int gdest = ShmRanks[dest];
+  int gfrom = ShmRanks[from];
+  int gme   = ShmRanks[_processor];
+
+  assert(dest != _processor);
+  assert(from != _processor);
+  assert(gme  == ShmRank);
+  double off_node_bytes=0.0;
+  int tag;
+
+  if ( gfrom ==MPI_UNDEFINED) {
+    tag= dir+from*32;
+    ierr=MPI_Recv_init(recv, bytes, MPI_CHAR,from,tag,communicator_halo[commdir],&rrq);
+    assert(ierr==0);
+    list.push_back(rrq);
+    off_node_bytes+=bytes;
+  }
+
+  if ( gdest == MPI_UNDEFINED ) {
+    tag= dir+_processor*32;
+    ierr =MPI_Send_init(xmit, bytes, MPI_CHAR,dest,tag,communicator_halo[commdir],&xrq);
+    assert(ierr==0);
+    list.push_back(xrq);
+    off_node_bytes+=bytes;
+  }
+
+  return off_node_bytes;
+}
+void CartesianCommunicator::StencilSendToRecvFromStart(std::vector<CommsRequest_t> &list,int dir)
+{
+  int nreq=list.size();
+
+  if (nreq==0) return;
+
+  int ierr = MPI_Startall(nreq,&list[0]);
+  assert(ierr==0);
+
+  if ( CommunicatorPolicy == CommunicatorPolicySequential ) {
+    this->StencilSendToRecvFromWait(list,dir);
+  }
+}
+void CartesianCommunicator::StencilSendToRecvFromWait(std::vector<CommsRequest_t> &list,int dir)
+{
+  int nreq=list.size();
+
+  if (nreq==0) return;
+
+  // Persistent requests become inactive, and are kept for the next start
+  int ierr = MPI_Waitall(nreq,&list[0],MPI_STATUSES_IGNORE);
+  assert(ierr==0);
+}
+int CartesianCommunicator::StencilSendToRecvFromTest(std::vector<CommsRequest_t> &list,int dir)
+{
+  int nreq=list.size();
+
+  if (nreq==0) return 1;
+
+  int flag;
+  int ierr = MPI_Testall(nreq,&list[0],&flag,MPI_STATUSES_IGNORE);
+  assert(ierr==0);
+  return flag;
+}
+void CartesianCommunicator::StencilSendToRecvFromFree(std::vector<CommsRequest_t> &list)
+{
+  int finalized;
+  MPI_Finalized(&finalized);
+  if ( !finalized ) {
+    for(int i=0;i<list.size();i++){
+      if ( list[i] != MPI_REQUEST_NULL ) MPI_Request_free(&list[i]);
+    }
+  }
+  list.resize(0);
+}
 void CartesianCommunicator::StencilBarrier(void)
 {
   MPI_Barrier  (ShmComm);
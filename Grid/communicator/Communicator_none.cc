@@ -78,6 +78,11 @@ void CartesianCommunicator::GlobalSum(uint64_t &){}
 void CartesianCommunicator::GlobalSumVector(uint64_t *,int N){}
 void CartesianCommunicator::GlobalXOR(uint32_t &){}
 void CartesianCommunicator::GlobalXOR(uint64_t &){}
+void CartesianCommunicator::GlobalSumVectorBegin(float *,int N,CommsRequest_t &req){ req=0; }
+void CartesianCommunicator::GlobalSumVectorBegin(double *,int N,CommsRequest_t &req){ req=0; }
+void CartesianCommunicator::GlobalSumVectorBegin(uint64_t *,int N,CommsRequest_t &req){ req=0; }
+int  CartesianCommunicator::GlobalSumVectorTest(CommsRequest_t &req){ return 1; }
+void CartesianCommunicator::GlobalSumVectorComplete(CommsRequest_t &req){}
 
 
 // Basic Halo comms primitive -- should never call in single node
@@ -131,6 +136,30 @@ void CartesianCommunicator::StencilSendToRecvFromComplete(std::vector<CommsReque
 {
 }
 
+double CartesianCommunicator::StencilSendToRecvFromInit(std::vector<CommsRequest_t> &list,
+							void *xmit,
+							int xmit_to_rank,
+							void *recv,
+							int recv_from_rank,
+							int bytes, int dir)
+{
+  return 2.0*bytes;
+}
+void CartesianCommunicator::StencilSendToRecvFromStart(std::vector<CommsRequest_t> &list,int dir)
+{
+}
+void CartesianCommunicator::StencilSendToRecvFromWait(std::vector<CommsRequest_t> &list,int dir)
+{
+}
+int CartesianCommunicator::StencilSendToRecvFromTest(std::vector<CommsRequest_t> &list,int dir)
+{
+  return 1;
+}
+void CartesianCommunicator::StencilSendToRecvFromFree(std::vector<CommsRequest_t> &list)
+{
+  list.resize(0);
+}
+
 void CartesianCommunicator::StencilBarrier(void){};
 
 NAMESPACE_END(Grid);
@@ -33,20 +33,79 @@ directory
 
 NAMESPACE_BEGIN(Grid);
 
+// w += sum_k a[k] basis[k] for k0<=k<k1 in one sweep over the sites
 template<class Field>
-void basisOrthogonalize(std::vector<Field> &basis,Field &w,int k) 
+void basisMultiAxpy(Field &w,const std::vector<Field> &basis,const std::vector<ComplexD> &a,int k0,int k1)
+{
+  typedef decltype(basis[0].View(AcceleratorRead)) View;
+  typedef typename Field::vector_object vobj;
+  typedef typename vobj::scalar_type Coeff_t;
+  GridBase* grid = w.Grid();
+
+  int nvec = k1-k0;
+  if ( nvec <= 0 ) return;
+
+  Vector<View> basis_v; basis_v.reserve(nvec);
+  for(int k=k0;k<k1;k++){
+    basis_v.push_back(basis[k].View(AcceleratorRead));
+  }
+  Vector<Coeff_t> a_v(nvec);
+  for(int k=0;k<nvec;k++) a_v[k] = a[k+k0];
+
+  auto basis_vp = &basis_v[0];
+  auto a_p      = &a_v[0];
+  autoView(w_v,w,AcceleratorWrite);
+  accelerator_for(ss, grid->oSites(),vobj::Nsimd(),{
+    auto B = coalescedRead(w_v[ss]);
+    for(int k=0; k<nvec; ++k){
+      B = B + a_p[k] * coalescedRead(basis_vp[k][ss]);
+    }
+    coalescedWrite(w_v[ss], B);
+  });
+  for(int k=0;k<nvec;k++) basis_v[k].ViewClose();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Orthogonalise w against the orthonormal basis[0..k) by block classical
+// Gram-Schmidt with one reorthogonalisation (CGS2). Each pass takes all the
+// overlaps in fused multi-dot sweeps and a single global sum, then removes
+// them in one fused sweep, so a pass costs one reduction however large k is.
+// The multi-dot runs in blocks of Nblock vectors to bound device scratch.
+// The overlaps removed over both passes are returned in coeff, so that
+// w_in = w_out + sum_j coeff[j] basis[j].
+//////////////////////////////////////////////////////////////////////////////
+template<class Field>
+void basisOrthogonalize(std::vector<Field> &basis,Field &w,int k,std::vector<ComplexD> &coeff) 
 {
-  // If assume basis[j] are already orthonormal,
-  // can take all inner products in parallel saving 2x bandwidth
-  // Save 3x bandwidth on the second line of loop.
-  // perhaps 2.5x speed up.
-  // 2x overall in Multigrid Lanczos  
-  for(int j=0; j<k; ++j){
-    auto ip = innerProduct(basis[j],w);
-    w = w - ip*basis[j];
+  const int Nblock = 64;
+  coeff.assign(k,ComplexD(0.0));
+  if ( k <= 0 ) return;
+
+  std::vector<ComplexD> ip(k);
+  for(int pass=0;pass<2;pass++){
+    if ( GridReproducibleReduction::Enabled ) {
+      for(int j=0; j<k; ++j) ip[j] = innerProduct(basis[j],w);
+    } else {
+      for(int k0=0; k0<k; k0+=Nblock){
+	rankInnerProductMulti(&ip[k0],basis,k0,MIN(k0+Nblock,k),w);
+      }
+      w.Grid()->GlobalSumVector(&ip[0],k);
+    }
+    for(int j=0; j<k; ++j) {
+      coeff[j] += ip[j];
+      ip[j] = -ip[j];
+    }
+    basisMultiAxpy(w,basis,ip,0,k);
   }
 }
 
+template<class Field>
+void basisOrthogonalize(std::vector<Field> &basis,Field &w,int k) 
+{
+  std::vector<ComplexD> coeff;
+  basisOrthogonalize(basis,w,k,coeff);
+}
+
 template<class VField, class Matrix>
 void basisRotate(VField &basis,Matrix& Qt,int j0, int j1, int k0,int k1,int Nm) 
 {
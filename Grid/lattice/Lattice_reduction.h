@@ -159,6 +159,235 @@ inline typename vobj::scalar_object sum(const Lattice<vobj> &arg)
   return ssum;
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reduction engine for site local double precision results.
+//
+// kernel(ss,i) returns the i-th of nred results for outer site ss. On the host each thread
+// accumulates partials over a contiguous share of the sites, combined in thread order; no per
+// site array is formed. Host scratch is owned by the call and returned to the MemoryManager,
+// whose allocation cache makes the round trip cheap in solver loops. On device one kernel tree
+// sums every result per block into nred x nblocks partials, added up on the host; the partials
+// buffer belongs to the calling thread and is kept between calls. Concurrent reductions on
+// different threads get separate buffers. Node local: the caller performs the global sum.
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+class ReductionScratch {
+  void  *buf;
+  size_t bytes;
+public:
+  ReductionScratch(size_t _bytes) : bytes(_bytes) { buf = MemoryManager::SharedAllocate(bytes); }
+  ~ReductionScratch() { MemoryManager::SharedFree(buf,bytes); }
+  ReductionScratch(const ReductionScratch &) = delete;
+  ReductionScratch &operator=(const ReductionScratch &) = delete;
+  void *ptr(void) const { return buf; }
+};
+
+// Grow only, per thread buffer for the device block partials; released when the thread exits
+class ReductionPartials {
+  void  *buf;
+  size_t bytes;
+  ReductionPartials() : buf(nullptr), bytes(0) {}
+public:
+  ~ReductionPartials() { if ( buf ) MemoryManager::SharedFree(buf,bytes); }
+  static void *Get(size_t _bytes) {
+    static thread_local ReductionPartials p;
+    if ( _bytes > p.bytes ) {
+      if ( p.buf ) MemoryManager::SharedFree(p.buf,p.bytes);
+      p.bytes = _bytes;
+      p.buf   = MemoryManager::SharedAllocate(p.bytes);
+    }
+    return p.buf;
+  }
+};
+
+template<class inner_t,class Kernel>
+inline void rankReduce(ComplexD *result,int nred,uint64_t osites,Kernel kernel)
+{
+#if defined(GRID_CUDA)||defined(GRID_HIP)
+  typedef typename inner_t::scalar_objectD sobj;
+  Integer sites = osites;
+  Integer numThreads, numBlocks;
+  getNumBlocksAndThreads(sites, sizeof(sobj), numThreads, numBlocks);
+  Integer smemSize = numThreads * sizeof(sobj);
+  sobj *partial = (sobj *) ReductionPartials::Get(nred*numBlocks*sizeof(sobj));
+  rankReduceKernel<inner_t><<< numBlocks, numThreads, smemSize >>>(kernel, nred, sites, partial);
+  accelerator_barrier();
+  for(int i=0;i<nred;i++) {
+    result[i] = 0.0;
+    for(Integer b=0;b<numBlocks;b++){
+      result[i] = result[i] + ComplexD(TensorRemove(partial[i*numBlocks+b]));
+    }
+  }
+#else
+  const int nthread = GridThread::GetThreads();
+  // pad each thread's partials to avoid false sharing
+  const int stride  = nred + (256+sizeof(inner_t)-1)/sizeof(inner_t);
+  ReductionScratch scratch(nthread*stride*sizeof(inner_t));
+  inner_t *acc = (inner_t *) scratch.ptr();
+  thread_for(thr,nthread, {
+    int nwork, mywork, myoff;
+    nwork = osites;
+    GridThread::GetWork(nwork,thr,mywork,myoff);
+    inner_t *myacc = &acc[thr*stride];
+    for(int i=0;i<nred;i++) myacc[i] = Zero();
+    for(int ss=myoff;ss<mywork+myoff; ss++){
+      for(int i=0;i<nred;i++) myacc[i] = myacc[i] + kernel(ss,i);
+    }
+  });
+  for(int i=0;i<nred;i++){
+    result[i] = 0.0;
+    for(int thr=0;thr<nthread;thr++){
+      result[i] = result[i] + ComplexD(TensorRemove(Reduce(acc[thr*stride+i])));
+    }
+  }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+// Bitwise reproducible reductions, opt in with --reproducible-reductions.
+//
+// Per lattice site results are independent of the thread and rank decomposition; only the order
+// of the global sum is not. Each per site value is converted exactly to fixed point relative to
+// a global scale fixed by the global maximum magnitude and the global term count, then summed in
+// integer arithmetic, which is associative. Threads and ranks combine integer limbs, so the result
+// is the same whatever --threads and --mpi are. Costs an extra pass and a GlobalMax.
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+class GridReproducibleReduction {
+public:
+  static int Enabled;
+};
+
+// value = (limb[0] + limb[1] 2^-40 + limb[2] 2^-80 + limb[3] 2^-120) 2^-scale
+class ReproducibleAccumulator {
+public:
+  static const int     Nlimb = 4;
+  static const int     Bits  = 40;
+  static const int64_t Interval = 1<<20; // adds between carry propagations
+  int64_t limb[Nlimb];
+
+  inline void zero(void) { for(int l=0;l<Nlimb;l++) limb[l]=0; }
+  // y is the term already multiplied by 2^scale
+  inline void add(RealD y) {
+    const RealD radix = (RealD)(INT64_C(1)<<Bits);
+    for(int l=0;l<Nlimb;l++){
+      RealD f = std::floor(y);
+      limb[l] += (int64_t) f;
+      y = (y - f) * radix;
+    }
+  }
+  inline void normalise(void) {
+    for(int l=Nlimb-1;l>0;l--){
+      int64_t carry = limb[l] >> Bits;
+      limb[l]  -= carry * (INT64_C(1)<<Bits);
+      limb[l-1]+= carry;
+    }
+  }
+  inline void operator += (const ReproducibleAccumulator &r) {
+    for(int l=0;l<Nlimb;l++) limb[l]+=r.limb[l];
+  }
+  inline RealD value(int scale) const {
+    const RealD iradix = 1.0/(RealD)(INT64_C(1)<<Bits);
+    RealD v = (RealD) limb[Nlimb-1];
+    for(int l=Nlimb-2;l>=0;l--) v = v*iradix + (RealD)limb[l];
+    return std::ldexp(v,-scale);
+  }
+};
+
+// Largest scale for which nterms terms bounded by lmax cannot overflow the leading limb.
+// For tiny lmax the scale exceeds the double exponent range, so terms are scaled one by
+// one with ldexp rather than by a precomputed 2^scale.
+inline int reproducibleScale(GridBase *grid,RealD lmax,uint64_t nterms)
+{
+  grid->GlobalMax(lmax);
+  if ( lmax == 0.0 ) return 0;
+  int e = std::ilogb(lmax)+1;
+  int h = 1;
+  while ( (UINT64_C(1)<<(h-1)) < nterms ) h++;
+  return 62 - h - e;
+}
+
+inline void reproducibleGlobalSum(GridBase *grid,std::vector<ReproducibleAccumulator> &acc)
+{
+  for(int i=0;i<acc.size();i++) acc[i].normalise();
+  grid->GlobalSumVector((uint64_t *)&acc[0].limb[0],acc.size()*ReproducibleAccumulator::Nlimb);
+  for(int i=0;i<acc.size();i++) acc[i].normalise();
+}
+
+// Sum over all lanes of all sites of per site values reducing to a complex scalar
+template<class inner_t>
+inline ComplexD reproducibleSum(GridBase *grid,const inner_t *vals,uint64_t osites)
+{
+  const int Nsimd   = grid->Nsimd();
+  const int nthread = GridThread::GetThreads();
+
+  std::vector<RealD> tmax(nthread,0.0);
+  thread_for(thr,nthread, {
+    int nwork, mywork, myoff;
+    nwork = osites;
+    GridThread::GetWork(nwork,thr,mywork,myoff);
+    RealD m = 0.0;
+    for(int ss=myoff;ss<mywork+myoff; ss++){
+      for(int lane=0;lane<Nsimd;lane++){
+	ComplexD c = TensorRemove(extractLane(lane,vals[ss]));
+	m = std::max(m,std::max(std::fabs(real(c)),std::fabs(imag(c))));
+      }
+    }
+    tmax[thr] = m;
+  });
+  RealD lmax = 0.0;
+  for(int thr=0;thr<nthread;thr++) lmax = std::max(lmax,tmax[thr]);
+
+  int   scale = reproducibleScale(grid,lmax,grid->gSites());
+
+  std::vector<ReproducibleAccumulator> tacc(2*nthread);
+  thread_for(thr,nthread, {
+    int nwork, mywork, myoff;
+    nwork = osites;
+    GridThread::GetWork(nwork,thr,mywork,myoff);
+    ReproducibleAccumulator re, im;
+    re.zero(); im.zero();
+    int64_t count = 0;
+    for(int ss=myoff;ss<mywork+myoff; ss++){
+      for(int lane=0;lane<Nsimd;lane++){
+	ComplexD c = TensorRemove(extractLane(lane,vals[ss]));
+	re.add(std::ldexp(real(c),scale));
+	im.add(std::ldexp(imag(c),scale));
+	if ( (++count % ReproducibleAccumulator::Interval) == 0 ) { re.normalise(); im.normalise(); }
+      }
+    }
+    re.normalise(); im.normalise();
+    tacc[2*thr]   = re;
+    tacc[2*thr+1] = im;
+  });
+
+  std::vector<ReproducibleAccumulator> acc(2);
+  acc[0].zero(); acc[1].zero();
+  for(int thr=0;thr<nthread;thr++){
+    acc[0] += tacc[2*thr];
+    acc[1] += tacc[2*thr+1];
+  }
+  reproducibleGlobalSum(grid,acc);
+  return ComplexD(acc[0].value(scale),acc[1].value(scale));
+}
+
+template<class vobj>
+inline ComplexD reproducibleInnerProduct(const Lattice<vobj> &left,const Lattice<vobj> &right)
+{
+  typedef decltype(innerProductD(vobj(),vobj())) inner_t;
+  conformable(left,right);
+  GridBase *grid = left.Grid();
+  const uint64_t sites = grid->oSites();
+  ReductionScratch scratch(sites*sizeof(inner_t));
+  inner_t *inner = (inner_t *) scratch.ptr();
+  {
+    autoView( left_v , left, CpuRead);
+    autoView( right_v,right, CpuRead);
+    thread_for(ss,sites,{
+      inner[ss] = innerProductD(left_v[ss],right_v[ss]);
+    });
+  }
+  return reproducibleSum(grid,inner,sites);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Deterministic Reduction operations
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -197,46 +426,79 @@ template<class vobj> inline RealD maxLocalNorm2(const Lattice<vobj> &arg)
 template<class vobj>
 inline ComplexD rankInnerProduct(const Lattice<vobj> &left,const Lattice<vobj> &right)
 {
-  typedef typename vobj::scalar_type scalar_type;
-  typedef typename vobj::vector_typeD vector_type;
   ComplexD  nrm;
   
   GridBase *grid = left.Grid();
 
-  const uint64_t nsimd = grid->Nsimd();
   const uint64_t sites = grid->oSites();
   
-  // Might make all code paths go this way.
   typedef decltype(innerProductD(vobj(),vobj())) inner_t;
-  Vector<inner_t> inner_tmp(sites);
-  auto inner_tmp_v = &inner_tmp[0];
-    
   {
     autoView( left_v , left, AcceleratorRead);
     autoView( right_v,right, AcceleratorRead);
 
-    // GPU - SIMT lane compliance...
-    accelerator_for( ss, sites, 1,{
-	auto x_l = left_v[ss];
-	auto y_l = right_v[ss];
-	inner_tmp_v[ss]=innerProductD(x_l,y_l);
+    rankReduce<inner_t>(&nrm,1,sites,[=] accelerator (uint64_t ss,int i) {
+	return innerProductD(left_v[ss],right_v[ss]);
     });
   }
-
-  // This is in single precision and fails some tests
-  auto anrm = sum(inner_tmp_v,sites);  
-  nrm = anrm;
   return nrm;
 }
 
 template<class vobj>
 inline ComplexD innerProduct(const Lattice<vobj> &left,const Lattice<vobj> &right) {
+  if ( GridReproducibleReduction::Enabled ) return reproducibleInnerProduct(left,right);
   GridBase *grid = left.Grid();
   ComplexD nrm = rankInnerProduct(left,right);
   grid->GlobalSum(nrm);
   return nrm;
 }
 
+/////////////////////////////////////////////////////////////////////////
+// Multi-dot: ip[k-k0] = <left[k],right> for k0<=k<k1 in one sweep,
+// with a single global sum
+/////////////////////////////////////////////////////////////////////////
+template<class vobj>
+inline void rankInnerProductMulti(ComplexD *ip,const std::vector<Lattice<vobj> > &left,int k0,int k1,const Lattice<vobj> &right)
+{
+  int nred = k1-k0;
+  if ( nred <= 0 ) return;
+
+  GridBase *grid = right.Grid();
+  const uint64_t sites = grid->oSites();
+
+  typedef decltype(innerProductD(vobj(),vobj())) inner_t;
+  typedef decltype(left[0].View(AcceleratorRead)) View;
+
+  Vector<View> left_v; left_v.reserve(nred);
+  for(int k=k0;k<k1;k++){
+    conformable(left[k],right);
+    left_v.push_back(left[k].View(AcceleratorRead));
+  }
+  {
+    auto left_vp = &left_v[0];
+    autoView( right_v,right, AcceleratorRead);
+    rankReduce<inner_t>(ip,nred,sites,[=] accelerator (uint64_t ss,int i) {
+	return innerProductD(left_vp[i][ss],right_v[ss]);
+    });
+  }
+  for(int k=0;k<nred;k++) left_v[k].ViewClose();
+}
+
+template<class vobj>
+inline void innerProductMulti(std::vector<ComplexD> &ip,const std::vector<Lattice<vobj> > &left,int k0,int k1,const Lattice<vobj> &right)
+{
+  ip.resize(k1-k0);
+  if ( k1 <= k0 ) return;
+  rankInnerProductMulti(&ip[0],left,k0,k1,right);
+  right.Grid()->GlobalSumVector(&ip[0],k1-k0);
+}
+
+template<class vobj>
+inline void innerProductMulti(std::vector<ComplexD> &ip,const std::vector<Lattice<vobj> > &left,const Lattice<vobj> &right)
+{
+  innerProductMulti(ip,left,0,left.size(),right);
+}
+
 
 /////////////////////////
 // Fast axpby_norm
@@ -260,6 +522,11 @@ axpby_norm_fast(Lattice<vobj> &z,sobj a,sobj b,const Lattice<vobj> &x,const Latt
   typedef typename vobj::scalar_type scalar_type;
   typedef typename vobj::vector_typeD vector_type;
   RealD  nrm;
+
+  if ( GridReproducibleReduction::Enabled ) {
+    z = a*x+b*y;
+    return norm2(z);
+  }
   
   GridBase *grid = x.Grid();
 
@@ -272,54 +539,57 @@ axpby_norm_fast(Lattice<vobj> &z,sobj a,sobj b,const Lattice<vobj> &x,const Latt
   autoView( z_v, z, AcceleratorWrite);
 
   typedef decltype(innerProductD(x_v[0],y_v[0])) inner_t;
-  Vector<inner_t> inner_tmp(sites);
-  auto inner_tmp_v = &inner_tmp[0];
-
-  accelerator_for( ss, sites, 1,{
+  ComplexD znrm;
+  rankReduce<inner_t>(&znrm,1,sites,[=] accelerator (uint64_t ss,int i) {
       auto tmp = a*x_v[ss]+b*y_v[ss];
-      inner_tmp_v[ss]=innerProductD(tmp,tmp);
       z_v[ss]=tmp;
+      return innerProductD(tmp,tmp);
   });
-  nrm = real(TensorRemove(sum(inner_tmp_v,sites)));
+  nrm = real(znrm);
   grid->GlobalSum(nrm);
   return nrm; 
 }
  
+// Node local ip = <left,right> and nrm = |left|^2 in one sweep; caller performs the global sum.
+// Lets solvers fuse these into a single GlobalSumVector with other reductions.
 template<class vobj> strong_inline void
-innerProductNorm(ComplexD& ip, RealD &nrm, const Lattice<vobj> &left,const Lattice<vobj> &right)
+rankInnerProductNorm(ComplexD& ip, ComplexD &nrm, const Lattice<vobj> &left,const Lattice<vobj> &right)
 {
   conformable(left,right);
 
   typedef typename vobj::scalar_type scalar_type;
   typedef typename vobj::vector_typeD vector_type;
-  Vector<ComplexD> tmp(2);
 
   GridBase *grid = left.Grid();
 
   const uint64_t nsimd = grid->Nsimd();
   const uint64_t sites = grid->oSites();
 
-  // GPU
   typedef decltype(innerProductD(vobj(),vobj())) inner_t;
-  typedef decltype(innerProductD(vobj(),vobj())) norm_t;
-  Vector<inner_t> inner_tmp(sites);
-  Vector<norm_t>  norm_tmp(sites);
-  auto inner_tmp_v = &inner_tmp[0];
-  auto norm_tmp_v = &norm_tmp[0];
+  ComplexD tmp[2];
   {
     autoView(left_v,left, AcceleratorRead);
     autoView(right_v,right,AcceleratorRead);
-    accelerator_for( ss, sites, 1,{
+    rankReduce<inner_t>(tmp,2,sites,[=] accelerator (uint64_t ss,int i) {
 	auto left_tmp = left_v[ss];
-	inner_tmp_v[ss]=innerProductD(left_tmp,right_v[ss]);
-        norm_tmp_v [ss]=innerProductD(left_tmp,left_tmp);
-      });
+	return (i==0) ? innerProductD(left_tmp,right_v[ss]) : innerProductD(left_tmp,left_tmp);
+    });
   }
+  ip  = tmp[0];
+  nrm = tmp[1];
+}
 
-  tmp[0] = TensorRemove(sum(inner_tmp_v,sites));
-  tmp[1] = TensorRemove(sum(norm_tmp_v,sites));
-
-  grid->GlobalSumVector(&tmp[0],2); // keep norm Complex -> can use GlobalSumVector
+template<class vobj> strong_inline void
+innerProductNorm(ComplexD& ip, RealD &nrm, const Lattice<vobj> &left,const Lattice<vobj> &right)
+{
+  if ( GridReproducibleReduction::Enabled ) {
+    ip  = innerProduct(left,right);
+    nrm = norm2(left);
+    return;
+  }
+  Vector<ComplexD> tmp(2);
+  rankInnerProductNorm(tmp[0],tmp[1],left,right);
+  left.Grid()->GlobalSumVector(&tmp[0],2); // keep norm Complex -> can use GlobalSumVector
   ip = tmp[0];
   nrm = real(tmp[1]);
 }
@@ -353,8 +623,104 @@ inline auto sum(const LatticeTrinaryExpression<Op,T1,T2,T3> & expr)
 // sliceSum, sliceInnerProduct, sliceAxpy, sliceNorm etc...
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Reproducible sliceSum; every real word of every slice gets its own fixed point accumulator
+template<class vobj> inline void reproducibleSliceSum(const Lattice<vobj> &Data,std::vector<typename vobj::scalar_object> &result,int orthogdim)
+{
+  typedef typename vobj::scalar_object sobj;
+  typedef typename vobj::scalar_type   scalar_type;
+  typedef typename GridTypeMapper<scalar_type>::Realified real_t;
+  const int words = sizeof(sobj)/sizeof(real_t);
+
+  GridBase  *grid = Data.Grid();
+  assert(grid!=NULL);
+
+  const int    Nd = grid->_ndimension;
+  const int Nsimd = grid->Nsimd();
+
+  assert(orthogdim >= 0);
+  assert(orthogdim < Nd);
+
+  const int fd=grid->_fdimensions[orthogdim];
+  const int ld=grid->_ldimensions[orthogdim];
+  const int rd=grid->_rdimensions[orthogdim];
+  const int ostride = grid->_ostride[orthogdim];
+  const int poff    = grid->_processor_coor[orthogdim]*ld;
+  const uint64_t osites = grid->oSites();
+  const int nthread = GridThread::GetThreads();
+
+  std::vector<int> lane_t(Nsimd);
+  Coordinate icoor(Nd);
+  for(int lane=0;lane<Nsimd;lane++){
+    grid->iCoorFromIindex(icoor,lane);
+    lane_t[lane] = icoor[orthogdim]*rd;
+  }
+
+  autoView( Data_v, Data, CpuRead);
+
+  std::vector<RealD> tmax(nthread,0.0);
+  thread_for(thr,nthread, {
+    int nwork, mywork, myoff;
+    nwork = osites;
+    GridThread::GetWork(nwork,thr,mywork,myoff);
+    RealD m = 0.0;
+    for(int ss=myoff;ss<mywork+myoff; ss++){
+      for(int lane=0;lane<Nsimd;lane++){
+	sobj so = extractLane(lane,Data_v[ss]);
+	real_t *w = (real_t *)&so;
+	for(int i=0;i<words;i++) m = std::max(m,(RealD)std::fabs(w[i]));
+      }
+    }
+    tmax[thr] = m;
+  });
+  RealD lmax = 0.0;
+  for(int thr=0;thr<nthread;thr++) lmax = std::max(lmax,tmax[thr]);
+
+  int   scale = reproducibleScale(grid,lmax,grid->gSites());
+
+  const int nacc = fd*words;
+  std::vector<ReproducibleAccumulator> tacc(nthread*nacc);
+  thread_for(thr,nthread, {
+    int nwork, mywork, myoff;
+    nwork = osites;
+    GridThread::GetWork(nwork,thr,mywork,myoff);
+    ReproducibleAccumulator *acc = &tacc[thr*nacc];
+    for(int a=0;a<nacc;a++) acc[a].zero();
+    int64_t count = 0;
+    for(int ss=myoff;ss<mywork+myoff; ss++){
+      int r = (ss/ostride)%rd;
+      for(int lane=0;lane<Nsimd;lane++){
+	int t = poff + r + lane_t[lane];
+	sobj so = extractLane(lane,Data_v[ss]);
+	real_t *w = (real_t *)&so;
+	for(int i=0;i<words;i++) acc[t*words+i].add(std::ldexp((RealD)w[i],scale));
+	if ( (++count % ReproducibleAccumulator::Interval) == 0 ) {
+	  for(int a=0;a<nacc;a++) acc[a].normalise();
+	}
+      }
+    }
+  });
+
+  std::vector<ReproducibleAccumulator> gacc(nacc);
+  for(int a=0;a<nacc;a++) {
+    gacc[a].zero();
+    for(int thr=0;thr<nthread;thr++) gacc[a] += tacc[thr*nacc+a];
+  }
+  reproducibleGlobalSum(grid,gacc);
+
+  result.resize(fd);
+  for(int t=0;t<fd;t++){
+    real_t *w = (real_t *)&result[t];
+    for(int i=0;i<words;i++) w[i] = gacc[t*words+i].value(scale);
+  }
+}
+
 template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,std::vector<typename vobj::scalar_object> &result,int orthogdim)
 {
+  if ( GridReproducibleReduction::Enabled ) {
+    reproducibleSliceSum(Data,result,orthogdim);
+    return;
+  }
+
   ///////////////////////////////////////////////////////
   // FIXME precision promoted summation
   // may be important for correlation functions
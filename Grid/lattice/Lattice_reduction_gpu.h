@@ -191,6 +191,35 @@ __global__ void reduceKernel(const vobj *lat, sobj *buffer, Iterator n) {
   }
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// nred site local reductions in one pass, for rankReduce. kernel(ss,r) is evaluated once per outer
+// site and result; each block sums its share of result r into partial[r*gridDim.x+blockIdx.x].
+// Nothing is stored per site.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <class vobj, class sobj, class Kernel, class Iterator>
+__global__ void rankReduceKernel(Kernel kernel, int nred, Iterator osites, sobj *partial) {
+
+  constexpr Iterator nsimd = vobj::Nsimd();
+
+  extern __shared__ __align__(COALESCE_GRANULARITY) unsigned char shmem_pointer[];
+  sobj *sdata = (sobj *)shmem_pointer;
+
+  Iterator tid = threadIdx.x;
+  for (int r = 0; r < nred; r++) {
+    sobj mySum = Zero();
+    for (Iterator ss = blockIdx.x*blockDim.x + tid; ss < osites; ss += blockDim.x*gridDim.x) {
+      vobj v = kernel(ss,r);
+      for (Iterator lane = 0; lane < nsimd; lane++) {
+        sobj tmpD;
+        tmpD = extractLane(lane,v);
+        mySum += tmpD;
+      }
+    }
+    reduceBlock(sdata, mySum, tid);
+    if (tid == 0) partial[r*gridDim.x+blockIdx.x] = sdata[0];
+  }
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Possibly promote to double and sum
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
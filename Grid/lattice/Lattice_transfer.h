@@ -776,6 +776,70 @@ void ExtractSliceLocal(Lattice<vobj> &lowDim,const Lattice<vobj> & higherDim,int
 }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Multiple right hand sides interleaved in an extra, innermost, unvectorised dimension.
+// The batch grid is the 5d grid of the fields with the s-extent multiplied by nrhs
+// (a 4d field batches into Ls=nrhs). Site (x,s) of rhs r lives at (x, r*Ls+s), so one
+// gauge link applies to every rhs from the same cache line, and a stencil on the batch
+// grid carries all right hand sides in one message per direction. Fewer fields than
+// the batch holds may be passed; the trailing slots are left untouched.
+//////////////////////////////////////////////////////////////////////////////////////////
+template<class vobj>
+void InsertRHS(const std::vector<Lattice<vobj> > &rhs,Lattice<vobj> &batch)
+{
+  int nrhs = rhs.size();
+  assert(nrhs>0);
+  GridBase *rg = rhs[0].Grid();
+  GridBase *bg = batch.Grid();
+  int inner = (rg->_ndimension==bg->_ndimension) ? rg->_rdimensions[0] : 1;
+  assert(bg->_ndimension==rg->_ndimension || bg->_ndimension==rg->_ndimension+1);
+  assert(bg->_simd_layout[0]==1);
+  int nslot = bg->_rdimensions[0]/inner;
+  assert(bg->_rdimensions[0]==nslot*inner);
+  assert(bg->oSites()==nslot*rg->oSites());
+  assert(nrhs<=nslot);
+
+  batch.Checkerboard() = rhs[0].Checkerboard();
+  autoView( batch_v , batch, AcceleratorWrite);
+  for(int r=0;r<nrhs;r++){
+    assert(rhs[r].Grid()==rg);
+    autoView( rhs_v , rhs[r], AcceleratorRead);
+    accelerator_for(ss,rg->oSites(),vobj::Nsimd(),{
+      int s4 = ss/inner;
+      int s  = ss%inner;
+      coalescedWrite(batch_v[(s4*nslot+r)*inner+s],rhs_v(ss));
+    });
+  }
+}
+
+template<class vobj>
+void ExtractRHS(std::vector<Lattice<vobj> > &rhs,const Lattice<vobj> &batch)
+{
+  int nrhs = rhs.size();
+  assert(nrhs>0);
+  GridBase *rg = rhs[0].Grid();
+  GridBase *bg = batch.Grid();
+  int inner = (rg->_ndimension==bg->_ndimension) ? rg->_rdimensions[0] : 1;
+  assert(bg->_ndimension==rg->_ndimension || bg->_ndimension==rg->_ndimension+1);
+  assert(bg->_simd_layout[0]==1);
+  int nslot = bg->_rdimensions[0]/inner;
+  assert(bg->_rdimensions[0]==nslot*inner);
+  assert(bg->oSites()==nslot*rg->oSites());
+  assert(nrhs<=nslot);
+
+  autoView( batch_v , batch, AcceleratorRead);
+  for(int r=0;r<nrhs;r++){
+    assert(rhs[r].Grid()==rg);
+    rhs[r].Checkerboard() = batch.Checkerboard();
+    autoView( rhs_v , rhs[r], AcceleratorWrite);
+    accelerator_for(ss,rg->oSites(),vobj::Nsimd(),{
+      int s4 = ss/inner;
+      int s  = ss%inner;
+      coalescedWrite(rhs_v[ss],batch_v((s4*nslot+r)*inner+s));
+    });
+  }
+}
+
 template<class vobj>
 void Replicate(Lattice<vobj> &coarse,Lattice<vobj> & fine)
 {
@@ -1002,6 +1066,196 @@ vectorizeFromRevLexOrdArray( std::vector<sobj> &in, Lattice<vobj> &out)
   });
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Precision change without a host side lexicographic copy.
+//
+// Requires the two grids to share their local geometry: the same local and
+// reduced dimensions (simd layouts may differ), checkerboarding, and the same
+// processor coordinate, so this rank holds the same global sites in both. When the
+// wide grid (2n lanes) doubles a dimension with no narrow simd layout, and that
+// dimension is the most significant lane dimension, wide lane l is lane l%n
+// of one of two narrow objects. Whole vector words then convert with the simd
+// precisionChange. Otherwise each lane is gathered from its site in the input.
+////////////////////////////////////////////////////////////////////////////////
+inline bool precisionChangeGeometryMatch(GridBase *out_grid,GridBase *in_grid)
+{
+  int nd = out_grid->Nd();
+  if ( in_grid->Nd() != nd ) return false;
+  if ( out_grid->_isCheckerBoarded != in_grid->_isCheckerBoarded ) return false;
+  for(int d=0;d<nd;d++){
+    if ( out_grid->_ldimensions[d] != in_grid->_ldimensions[d] ) return false;
+    if ( out_grid->_processors[d]  != in_grid->_processors[d] ) return false;
+    if ( out_grid->_processor_coor[d] != in_grid->_processor_coor[d] ) return false;
+    if ( out_grid->_checker_dim_mask[d] != in_grid->_checker_dim_mask[d] ) return false;
+    if ( out_grid->_rdimensions[d]*out_grid->_simd_layout[d] !=
+	 in_grid->_rdimensions[d]*in_grid->_simd_layout[d] ) return false;
+  }
+  return true;
+}
+
+// Dimension mu doubled by the wide layout when lanes map word for word, else -1
+inline int precisionChangeLaneDim(GridBase *wide,GridBase *narrow)
+{
+  int nd = wide->Nd();
+  if ( wide->Nsimd() != 2*narrow->Nsimd() ) return -1;
+  int mu=-1;
+  for(int d=0;d<nd;d++){
+    if ( wide->_simd_layout[d] == narrow->_simd_layout[d] ) continue;
+    if ( (mu>=0) || (narrow->_simd_layout[d]!=1) || (wide->_simd_layout[d]!=2) ) return -1;
+    mu=d;
+  }
+  if ( mu<0 ) return -1;
+  for(int d=mu+1;d<nd;d++){
+    if ( wide->_simd_layout[d]!=1 ) return -1;
+  }
+  return mu;
+}
+
+// Narrowing: two input objects, at ocoor and ocoor + half the reduced extent in mu
+template<class VobjOut, class VobjIn>
+bool precisionChangeWords(Lattice<VobjOut> &out, const Lattice<VobjIn> &in,int mu,std::integral_constant<int,1>)
+{
+  typedef typename VobjOut::vector_type Vout;
+  typedef typename VobjIn::vector_type  Vin;
+  const int words = sizeof(VobjOut)/sizeof(Vout);
+
+  GridBase *out_grid = out.Grid();
+  Coordinate out_rdim = out_grid->_rdimensions;
+  Coordinate in_rdim  = in.Grid()->_rdimensions;
+  int nd = out_grid->Nd();
+
+  autoView( out_v , out, AcceleratorWrite);
+  autoView( in_v  , in , AcceleratorRead);
+  accelerator_for(oo,out_grid->oSites(),1,{
+    Coordinate ocoor(nd);
+    int a,b;
+    Lexicographic::CoorFromIndex(ocoor,oo,out_rdim);
+    Lexicographic::IndexFromCoor(ocoor,a,in_rdim);
+    ocoor[mu]+=out_rdim[mu];
+    Lexicographic::IndexFromCoor(ocoor,b,in_rdim);
+    Vout *vout = (Vout *)&out_v[oo];
+    Vin  *va   = (Vin *)&in_v[a];
+    Vin  *vb   = (Vin *)&in_v[b];
+    for(int w=0;w<words;w++){
+      Vin pair[2];
+      pair[0] = va[w];
+      pair[1] = vb[w];
+      precisionChange(&vout[w],pair,2);
+    }
+  });
+  return true;
+}
+// Widening: one half of one input object
+template<class VobjOut, class VobjIn>
+bool precisionChangeWords(Lattice<VobjOut> &out, const Lattice<VobjIn> &in,int mu,std::integral_constant<int,-1>)
+{
+  typedef typename VobjOut::vector_type Vout;
+  typedef typename VobjIn::vector_type  Vin;
+  const int words = sizeof(VobjOut)/sizeof(Vout);
+
+  GridBase *out_grid = out.Grid();
+  Coordinate out_rdim = out_grid->_rdimensions;
+  Coordinate in_rdim  = in.Grid()->_rdimensions;
+  int nd = out_grid->Nd();
+
+  autoView( out_v , out, AcceleratorWrite);
+  autoView( in_v  , in , AcceleratorRead);
+  accelerator_for(oo,out_grid->oSites(),1,{
+    Coordinate ocoor(nd);
+    int a;
+    Lexicographic::CoorFromIndex(ocoor,oo,out_rdim);
+    int h = ocoor[mu]/in_rdim[mu];
+    ocoor[mu] = ocoor[mu]%in_rdim[mu];
+    Lexicographic::IndexFromCoor(ocoor,a,in_rdim);
+    Vout *vout = (Vout *)&out_v[oo];
+    Vin  *va   = (Vin *)&in_v[a];
+    for(int w=0;w<words;w++){
+      Vout pair[2];
+      precisionChange(pair,&va[w],2);
+      vout[w] = pair[h];
+    }
+  });
+  return true;
+}
+template<class VobjOut, class VobjIn>
+bool precisionChangeWords(Lattice<VobjOut> &out, const Lattice<VobjIn> &in,int mu,std::integral_constant<int,0>)
+{
+  return false;
+}
+
+template<class VobjOut, class VobjIn>
+bool precisionChangeLanes(Lattice<VobjOut> &out, const Lattice<VobjIn> &in,std::true_type)
+{
+  typedef typename VobjOut::scalar_type ScalarOut;
+  typedef typename VobjIn::scalar_type  ScalarIn;
+  typedef typename VobjOut::vector_type Vout;
+  const int words = sizeof(VobjOut)/sizeof(Vout);
+
+  GridBase *out_grid = out.Grid();
+  GridBase *in_grid  = in.Grid();
+  Coordinate out_rdim = out_grid->_rdimensions;
+  Coordinate in_rdim  = in_grid->_rdimensions;
+  Coordinate out_simd = out_grid->_simd_layout;
+  Coordinate in_simd  = in_grid->_simd_layout;
+  int out_nsimd = out_grid->Nsimd();
+  int in_nsimd  = in_grid->Nsimd();
+  int nd = out_grid->Nd();
+
+  autoView( out_v , out, AcceleratorWrite);
+  autoView( in_v  , in , AcceleratorRead);
+  accelerator_for(oo,out_grid->oSites(),1,{
+    Coordinate ocoor(nd), icoor(nd), io(nd), ii(nd);
+    Lexicographic::CoorFromIndex(ocoor,oo,out_rdim);
+    ScalarOut *sout = (ScalarOut *)&out_v[oo];
+    for(int lane=0;lane<out_nsimd;lane++){
+      Lexicographic::CoorFromIndex(icoor,lane,out_simd);
+      for(int d=0;d<nd;d++){
+	int r = ocoor[d]+out_rdim[d]*icoor[d];
+	io[d] = r%in_rdim[d];
+	ii[d] = r/in_rdim[d];
+      }
+      int iosite,ilane;
+      Lexicographic::IndexFromCoor(io,iosite,in_rdim);
+      Lexicographic::IndexFromCoor(ii,ilane,in_simd);
+      ScalarIn *sin = (ScalarIn *)&in_v[iosite];
+      for(int w=0;w<words;w++){
+	sout[w*out_nsimd+lane] = ScalarOut(sin[w*in_nsimd+ilane]);
+      }
+    }
+  });
+  return true;
+}
+template<class VobjOut, class VobjIn>
+bool precisionChangeLanes(Lattice<VobjOut> &out, const Lattice<VobjIn> &in,std::false_type)
+{
+  return false;
+}
+
+template<class VobjOut, class VobjIn>
+bool precisionChangeFast(Lattice<VobjOut> &out, const Lattice<VobjIn> &in)
+{
+  typedef typename VobjOut::vector_type Vout;
+  typedef typename VobjIn::vector_type  Vin;
+  typedef typename RealPart<typename VobjOut::scalar_type>::type RealOut;
+  typedef typename RealPart<typename VobjIn::scalar_type>::type  RealIn;
+  static_assert(sizeof(VobjOut)/sizeof(Vout)==sizeof(VobjIn)/sizeof(Vin),"precisionChange between different tensor types");
+
+  const int ratio = (Vout::Nsimd()==2*Vin::Nsimd()) ? 1 : ( (Vin::Nsimd()==2*Vout::Nsimd()) ? -1 : 0 );
+  // Half precision is stored as integers and can only convert word by word
+  const bool lanes = std::is_floating_point<RealOut>::value && std::is_floating_point<RealIn>::value;
+
+  GridBase *out_grid = out.Grid();
+  GridBase *in_grid  = in.Grid();
+  if ( !precisionChangeGeometryMatch(out_grid,in_grid) ) return false;
+
+  int mu = -1;
+  if ( ratio== 1 ) mu = precisionChangeLaneDim(out_grid,in_grid);
+  if ( ratio==-1 ) mu = precisionChangeLaneDim(in_grid,out_grid);
+  if ( mu>=0 ) return precisionChangeWords(out,in,mu,std::integral_constant<int,ratio>());
+
+  return precisionChangeLanes(out,in,std::integral_constant<bool,lanes>());
+}
+
 //Convert a Lattice from one precision to another
 template<class VobjOut, class VobjIn>
 void precisionChange(Lattice<VobjOut> &out, const Lattice<VobjIn> &in)
@@ -1011,6 +1265,8 @@ void precisionChange(Lattice<VobjOut> &out, const Lattice<VobjIn> &in)
     assert(out.Grid()->FullDimensions()[d] == in.Grid()->FullDimensions()[d]);
   }
   out.Checkerboard() = in.Checkerboard();
+  if ( precisionChangeFast(out,in) ) return;
+
   GridBase *in_grid=in.Grid();
   GridBase *out_grid = out.Grid();
 
@@ -0,0 +1,350 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/parallelIO/BinaryIOAsync.h
+
+    Copyright (C) 2015
+
+    Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#pragma once
+
+#include <thread>
+#include <functional>
+#include <fcntl.h>
+#include <unistd.h>
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////////
+// Background writer producing the same files as BinaryIO::writeLatticeObject
+// and BinaryIO::writeRNG.
+//
+//  writeLatticeObject/writeRNG : collective; unvectorise and munge into a host
+//                                staging buffer, nothing touches the file
+//  Commit                      : collective; fence the previous batch, then
+//                                hand the staged files to a background thread
+//  Fence                       : collective; wait for the thread, reduce the
+//                                checksums and rename "file.partial" -> "file"
+//
+// The background thread uses no MPI: each rank computes its partial checksums
+// (on one core) and pwrites its own lexicographic runs of the shared file.
+// A file therefore only appears under its final name once every rank has
+// written and synced its part. Fence must be called before Grid_finalize.
+/////////////////////////////////////////////////////////////////////////////////
+class BinaryIOAsync {
+public:
+  struct Job {
+    std::string file;
+    std::string partial;
+    uint32_t nersc_csum;   // rank local until the fence
+    uint32_t scidac_csuma;
+    uint32_t scidac_csumb;
+    uint32_t error;
+    uint64_t bytes;
+    std::function<void(Job &)> work;
+  };
+
+private:
+  GridBase *grid;
+  std::vector<Job> staged;
+  std::vector<Job> running;
+  std::thread worker;
+  GridStopWatch background;
+
+public:
+  // Checksums of the most recently fenced batch, in order of staging
+  std::vector<Job> finished;
+
+  BinaryIOAsync() : grid(nullptr) {};
+  ~BinaryIOAsync() { Fence(); };
+
+  bool Busy(void) const { return worker.joinable(); }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Snapshot a lattice; same arguments and file layout as BinaryIO
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj,class fobj,class munger>
+  void writeLatticeObject(Lattice<vobj> &Umu,
+			  std::string file,
+			  munger munge,
+			  uint64_t offset,
+			  const std::string &format)
+  {
+    typedef typename vobj::scalar_object sobj;
+    GridBase *lgrid = Umu.Grid();
+    uint64_t lsites = lgrid->lSites();
+
+    std::shared_ptr<std::vector<fobj> > iodata(new std::vector<fobj>(lsites));
+    {
+      std::vector<sobj> scalardata(lsites);
+      unvectorizeToLexOrdArray(scalardata,Umu);
+      std::vector<fobj> &io = *iodata;
+      thread_for(x, lsites, { munge(scalardata[x],io[x]); });
+    }
+
+    Stage(lgrid,file,[lgrid,iodata,offset,format](Job &job) {
+      int fd = OpenPartial(job);
+      if ( fd < 0 ) return;
+      WriteLocal(lgrid,fd,*iodata,offset,format,job);
+      ClosePartial(fd,job);
+    });
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Snapshot the RNG state; the serial state is appended by rank zero
+  /////////////////////////////////////////////////////////////////////////////
+  void writeRNG(GridSerialRNG &serial_rng,
+		GridParallelRNG &parallel_rng,
+		std::string file,
+		uint64_t offset)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+    typedef std::array<RngStateType,RngStateCount> RNGstate;
+
+    GridBase *lgrid = parallel_rng.Grid();
+    uint64_t gsites = lgrid->gSites();
+    uint64_t lsites = lgrid->lSites();
+    int master = lgrid->IsBoss();
+
+    std::shared_ptr<std::vector<RNGstate> > iodata(new std::vector<RNGstate>(lsites));
+    std::shared_ptr<std::vector<RNGstate> > serial(new std::vector<RNGstate>(1));
+    {
+      std::vector<RNGstate> &io = *iodata;
+      thread_for(lidx,lsites,{
+	std::vector<RngStateType> tmp(RngStateCount);
+	Coordinate lcoor;
+	lgrid->LocalIndexToLocalCoor(lidx, lcoor);
+	int o_idx=lgrid->oIndex(lcoor);
+	int i_idx=lgrid->iIndex(lcoor);
+	int gidx=parallel_rng.generator_idx(o_idx,i_idx);
+	parallel_rng.GetState(tmp,gidx);
+	std::copy(tmp.begin(),tmp.end(),io[lidx].begin());
+      });
+      std::vector<RngStateType> tmp(RngStateCount);
+      serial_rng.GetState(tmp,0);
+      std::copy(tmp.begin(),tmp.end(),(*serial)[0].begin());
+    }
+
+    std::string format = "IEEE32BIG";
+    Stage(lgrid,file,[lgrid,iodata,serial,offset,gsites,master,format](Job &job) {
+      int fd = OpenPartial(job);
+      if ( fd < 0 ) return;
+      WriteLocal(lgrid,fd,*iodata,offset,format,job);
+      // Single object checksums are not reduced over ranks in BinaryIO;
+      // fold them in once from rank zero
+      if ( master ) {
+	uint32_t nersc_csum=0, scidac_csuma=0, scidac_csumb=0;
+	uint64_t append = offset + gsites*sizeof(RNGstate);
+	WriteObject(lgrid,fd,*serial,append,format,nersc_csum,scidac_csuma,scidac_csumb,job);
+	job.nersc_csum   += nersc_csum;
+	job.scidac_csuma ^= scidac_csuma;
+	job.scidac_csumb ^= scidac_csumb;
+      }
+      ClosePartial(fd,job);
+    });
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Hand the staged files to the background thread
+  /////////////////////////////////////////////////////////////////////////////
+  void Commit(void)
+  {
+    Fence();
+    if ( staged.size()==0 ) return;
+
+    // Clear stale partial files before any rank opens them
+    if ( grid->IsBoss() ) {
+      for(auto &job : staged) std::remove(job.partial.c_str());
+    }
+    grid->Barrier();
+
+    running.swap(staged);
+    staged.resize(0);
+
+    background.Reset();
+    worker = std::thread([this] () {
+#ifdef GRID_OMP
+      omp_set_num_threads(1); // leave the cores to the main thread
+#endif
+      background.Start();
+      for(auto &job : running) job.work(job);
+      background.Stop();
+    });
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Wait for the background writes; reduce checksums and publish the files
+  /////////////////////////////////////////////////////////////////////////////
+  void Fence(void)
+  {
+    if ( !worker.joinable() ) return;
+
+    GridStopWatch timer;
+    timer.Start();
+    worker.join();
+    timer.Stop();
+
+    uint64_t bytes=0;
+    uint32_t error=0;
+    for(auto &job : running) {
+      error |= job.error;
+      bytes += job.bytes;
+    }
+    grid->GlobalSum(error);
+    grid->GlobalSum(bytes);
+    if ( error ) {
+      std::cout << GridLogError << "BinaryIOAsync: background write failed; leaving partial files" << std::endl;
+      exit(1);
+    }
+
+    for(auto &job : running) {
+      grid->GlobalSum(job.nersc_csum);
+      grid->GlobalXOR(job.scidac_csuma);
+      grid->GlobalXOR(job.scidac_csumb);
+    }
+
+    grid->Barrier(); // all ranks have synced their part
+    if ( grid->IsBoss() ) {
+      for(auto &job : running) {
+	if ( std::rename(job.partial.c_str(),job.file.c_str()) ) {
+	  std::cout << GridLogError << "BinaryIOAsync: could not rename " << job.partial << std::endl;
+	  error = 1;
+	}
+      }
+    }
+    grid->GlobalSum(error);
+    if ( error ) exit(1);
+
+    std::cout << GridLogMessage << "BinaryIOAsync: wrote " << bytes << " bytes in background "
+	      << background.Elapsed() << " ; fence waited " << timer.Elapsed() << std::endl;
+    for(auto &job : running) {
+      std::cout << GridLogMessage << "BinaryIOAsync: " << job.file << " checksum " << std::hex
+		<< job.nersc_csum << "/" << job.scidac_csuma << "/" << job.scidac_csumb
+		<< std::dec << std::endl;
+    }
+    finished.swap(running);
+    running.resize(0);
+  }
+
+private:
+
+  void Stage(GridBase *lgrid,const std::string &file,std::function<void(Job &)> work)
+  {
+    if ( grid==nullptr ) grid = lgrid;
+    Job job;
+    job.file         = file;
+    job.partial      = file + ".partial";
+    job.nersc_csum   = 0;
+    job.scidac_csuma = 0;
+    job.scidac_csumb = 0;
+    job.error        = 0;
+    job.bytes        = 0;
+    job.work         = work;
+    staged.push_back(job);
+  }
+
+  static int OpenPartial(Job &job)
+  {
+    int fd = ::open(job.partial.c_str(),O_WRONLY|O_CREAT,0644);
+    if ( fd < 0 ) job.error = 1;
+    return fd;
+  }
+  static void ClosePartial(int fd,Job &job)
+  {
+    if ( ::fsync(fd) ) job.error = 1;
+    if ( ::close(fd) ) job.error = 1;
+  }
+
+  static void ToFileOrder(void *buf,uint64_t bytes,const std::string &format)
+  {
+    int ieee32big = (format == std::string("IEEE32BIG"));
+    int ieee32    = (format == std::string("IEEE32"));
+    int ieee64big = (format == std::string("IEEE64BIG"));
+    int ieee64    = (format == std::string("IEEE64") || format == std::string("IEEE64LITTLE"));
+    assert((ieee64+ieee32+ieee64big+ieee32big)==1);
+    // byte swaps are involutions
+    if (ieee32big) BinaryIO::be32toh_v(buf,bytes);
+    if (ieee32)    BinaryIO::le32toh_v(buf,bytes);
+    if (ieee64big) BinaryIO::be64toh_v(buf,bytes);
+    if (ieee64)    BinaryIO::le64toh_v(buf,bytes);
+  }
+
+  static void PWrite(int fd,const char *buf,uint64_t bytes,uint64_t offset,Job &job)
+  {
+    while ( bytes ) {
+      ssize_t ret = ::pwrite(fd,buf,bytes,offset);
+      if ( ret <= 0 ) { job.error = 1; return; }
+      buf    += ret;
+      offset += ret;
+      bytes  -= ret;
+      job.bytes += ret;
+    }
+  }
+
+  // A single object at a given offset, as BINARYIO_MASTER_APPEND
+  template<class fobj>
+  static void WriteObject(GridBase *lgrid,int fd,std::vector<fobj> &iodata,uint64_t offset,
+			  const std::string &format,uint32_t &nersc_csum,uint32_t &scidac_csuma,
+			  uint32_t &scidac_csumb,Job &job)
+  {
+    BinaryIO::NerscChecksum(lgrid,iodata,nersc_csum);
+    ToFileOrder((void *)&iodata[0],sizeof(fobj)*iodata.size(),format);
+    BinaryIO::ScidacChecksum(lgrid,iodata,scidac_csuma,scidac_csumb);
+    PWrite(fd,(char *)&iodata[0],sizeof(fobj)*iodata.size(),offset,job);
+  }
+
+  // This rank's sites in global lexicographic order, as BINARYIO_LEXICOGRAPHIC
+  template<class fobj>
+  static void WriteLocal(GridBase *lgrid,int fd,std::vector<fobj> &iodata,uint64_t offset,
+			 const std::string &format,Job &job)
+  {
+    int nd = lgrid->_ndimension;
+    Coordinate ldims  = lgrid->LocalDimensions();
+    Coordinate gdims  = lgrid->GlobalDimensions();
+    Coordinate lstart = lgrid->LocalStarts();
+    uint64_t lsites   = lgrid->lSites();
+
+    BinaryIO::NerscChecksum(lgrid,iodata,job.nersc_csum);
+    ToFileOrder((void *)&iodata[0],sizeof(fobj)*lsites,format);
+    BinaryIO::ScidacChecksum(lgrid,iodata,job.scidac_csuma,job.scidac_csumb);
+
+    // Longest run of sites contiguous in both the local and the file order
+    uint64_t run = 1;
+    for(int d=0;d<nd;d++){
+      run *= ldims[d];
+      if ( ldims[d] != gdims[d] ) break;
+    }
+
+    Coordinate coor(nd);
+    for(uint64_t lsite=0;lsite<lsites;lsite+=run){
+      int gsite;
+      Lexicographic::CoorFromIndex(coor,lsite,ldims);
+      for(int d=0;d<nd;d++) coor[d] += lstart[d];
+      Lexicographic::IndexFromCoor(coor,gsite,gdims);
+      PWrite(fd,(char *)&iodata[lsite],run*sizeof(fobj),offset+uint64_t(gsite)*sizeof(fobj),job);
+      if ( job.error ) return;
+    }
+  }
+};
+
+NAMESPACE_END(Grid);
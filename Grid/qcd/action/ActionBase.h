@@ -46,6 +46,7 @@ public:
   virtual void deriv(const GaugeField& U, GaugeField& dSdU) = 0;        // evaluate the action derivative
   virtual std::string action_name()    = 0;                             // return the action name
   virtual std::string LogParameters()  = 0;                             // prints action parameters
+  virtual void reset_history(void) {};                                   // forget solver guesses carried between MD steps
   virtual ~Action(){}
 };
 
@@ -75,6 +75,14 @@ public:
     this->DhopDerivEO(mat, U, V, dag);
   };
 
+  // EOFA replaces Mooee and MooeeInv, so the fused Cayley path does not apply
+  virtual void SchurDiagMooee(const FermionField& in, FermionField& out){
+    CheckerBoardedSparseMatrixBase<FermionField>::SchurDiagMooee(in, out);
+  };
+  virtual void SchurDiagMooeeDag(const FermionField& in, FermionField& out){
+    CheckerBoardedSparseMatrixBase<FermionField>::SchurDiagMooeeDag(in, out);
+  };
+
   // Recompute 5D coefficients for different value of shift constant
   // (needed for heatbath loop over poles)
   virtual void RefreshShiftCoefficients(RealD new_shift) = 0;
@@ -52,6 +52,10 @@ public:
   virtual void   MooeeInvDag (const FermionField &in, FermionField &out);
   virtual void   Meo5D (const FermionField &psi, FermionField &chi);
 
+  // Schur complement with the 5d work fused into the hopping term
+  virtual void   SchurDiagMooee    (const FermionField &in, FermionField &out);
+  virtual void   SchurDiagMooeeDag (const FermionField &in, FermionField &out);
+
   virtual void   M5D   (const FermionField &psi, FermionField &chi);
   virtual void   M5Ddag(const FermionField &psi, FermionField &chi);
 
@@ -107,6 +111,10 @@ public:
   void   Meooe5D       (const FermionField &in, FermionField &out);
   void   MeooeDag5D    (const FermionField &in, FermionField &out);
 
+  // Tridiagonal coefficients of Meooe5D and Mooee, or their daggers
+  void   Meooe5DCoefficients(int dag,Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+  void   MooeeCoefficients  (int dag,Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+
   //    protected:
   RealD mass;
 
@@ -187,6 +195,11 @@ public:
   double MooeeInvTime;
 
 protected:
+  void SchurDiagMooeeInternal(const FermionField &in, FermionField &out,int dag);
+  void SchurHop(StencilImpl &st,DoubledGaugeField &U,
+		const FermionField &in, FermionField &out,
+		const CayleySchurEpilogue<Impl> &epilogue);
+
   virtual void SetCoefficientsZolotarev(RealD zolohi,Approx::zolotarev_data *zdata,RealD b,RealD c);
   virtual void SetCoefficientsTanh(Approx::zolotarev_data *zdata,RealD b,RealD c);
   virtual void SetCoefficientsInternal(RealD zolo_hi,Vector<Coeff_t> & gamma,RealD b,RealD c);
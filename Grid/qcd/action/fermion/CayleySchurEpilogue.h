@@ -0,0 +1,185 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/action/fermion/CayleySchurEpilogue.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////////
+// Fifth dimension work of the Cayley form Schur complement
+//
+//   Mpc    = Mooee    - Meooe    MooeeInv    Meooe
+//   MpcDag = MooeeDag - MeooeDag MooeeInvDag MeooeDag
+//
+// with Meooe = Dhop Meooe5D and MeooeDag = MeooeDag5D Dhop^dag. All but the
+// hopping term is local to a 4d site, so it is applied to the site's Ls
+// vector as soon as the hopping kernel has written it:
+//
+//   Mpc:    chi = Dhop (Meooe5D in)   then chi <- Meooe5D MooeeInv chi
+//           out = Dhop chi            then out <- Mooee in - out
+//
+//   MpcDag: chi = Dhop^dag in         then chi <- MooeeInvDag MeooeDag5D chi
+//           out = Dhop^dag chi        then out <- MooeeDag in - MeooeDag5D out
+//
+// The tridiagonal matrices follow the M5D/M5Ddag convention of
+// CayleyFermion5D and are applied in place with a rolling window in s.
+///////////////////////////////////////////////////////////////////////////////
+template<class Impl>
+class CayleySchurEpilogue {
+public:
+  typedef typename Impl::Coeff_t    Coeff_t;
+  typedef typename Impl::SiteSpinor SiteSpinor;
+
+  int Ls;
+  int dag;    // MpcDag rather than Mpc
+  int last;   // epilogue of the second hopping term
+
+  // LDU factorisation of Mooee
+  Coeff_t *lee, *leem, *uee, *ueem, *dee;
+
+  // Tridiagonal Meooe5D and Mooee, or their daggers
+  Coeff_t *eo_lower, *eo_diag, *eo_upper;
+  Coeff_t *ee_lower, *ee_diag, *ee_upper;
+
+  // Schur complement source, read by the last epilogue
+  const SiteSpinor *src;
+
+  template<class View> accelerator_inline void operator()(View &chi,uint64_t ss) const
+  {
+    if ( !last ) {
+      if ( dag ) {
+	M5D(chi,ss,eo_lower,eo_diag,eo_upper);
+	MooeeInv(chi,ss);
+      } else {
+	MooeeInv(chi,ss);
+	M5D(chi,ss,eo_lower,eo_diag,eo_upper);
+      }
+    } else {
+      if ( dag ) M5D(chi,ss,eo_lower,eo_diag,eo_upper);
+      typedef decltype(coalescedRead(chi[0])) spinor;
+      spinor tmp1, tmp2;
+      for(int s=0;s<Ls;s++){
+	spinor up = coalescedRead(src[ss+(s+1)%Ls]);
+	spinor lo = coalescedRead(src[ss+(s+Ls-1)%Ls]);
+	if ( dag ) {
+	  spProj5p(tmp1,up);
+	  spProj5m(tmp2,lo);
+	} else {
+	  spProj5m(tmp1,up);
+	  spProj5p(tmp2,lo);
+	}
+	coalescedWrite(chi[ss+s],ee_diag[s]*coalescedRead(src[ss+s])+ee_upper[s]*tmp1+ee_lower[s]*tmp2-chi(ss+s));
+      }
+    }
+  }
+
+  // chi <- M chi on one 4d site, M tridiagonal in s
+  template<class View> accelerator_inline
+  void M5D(View &chi,uint64_t ss,const Coeff_t *lower,const Coeff_t *diag,const Coeff_t *upper) const
+  {
+    typedef decltype(coalescedRead(chi[0])) spinor;
+    spinor tmp1, tmp2;
+    spinor first = chi(ss);
+    spinor prev  = chi(ss+Ls-1);
+    spinor cur   = first;
+    for(int s=0;s<Ls;s++){
+      spinor next = (s<Ls-1) ? chi(ss+s+1) : first;
+      if ( dag ) {
+	spProj5p(tmp1,next);
+	spProj5m(tmp2,prev);
+      } else {
+	spProj5m(tmp1,next);
+	spProj5p(tmp2,prev);
+      }
+      coalescedWrite(chi[ss+s],diag[s]*cur+upper[s]*tmp1+lower[s]*tmp2);
+      prev = cur;
+      cur  = next;
+    }
+  }
+
+  // chi <- Mooee^-1 chi (or its dagger) on one 4d site; as CayleyFermion5D::MooeeInv
+  template<class View> accelerator_inline void MooeeInv(View &chi,uint64_t ss) const
+  {
+    typedef decltype(coalescedRead(chi[0])) spinor;
+    spinor tmp, acc, res;
+    if ( !dag ) {
+      // Apply (L^{\prime})^{-1} L_m^{-1}
+      res = chi(ss);
+      spProj5m(tmp,res);
+      acc = leem[0]*tmp;
+      spProj5p(tmp,res);
+      for(int s=1;s<Ls-1;s++){
+	res = chi(ss+s);
+	res -= lee[s-1]*tmp;
+	spProj5m(tmp,res);
+	acc += leem[s]*tmp;
+	spProj5p(tmp,res);
+	coalescedWrite(chi[ss+s],res);
+      }
+      res = chi(ss+Ls-1) - lee[Ls-2]*tmp - acc;
+
+      // Apply U_m^{-1} D^{-1} U^{-1}
+      res = (1.0/dee[Ls-1])*res;
+      coalescedWrite(chi[ss+Ls-1],res);
+      spProj5p(acc,res);
+      spProj5m(tmp,res);
+      for (int s=Ls-2;s>=0;s--){
+	res = (1.0/dee[s])*chi(ss+s) - uee[s]*tmp - ueem[s]*acc;
+	spProj5m(tmp,res);
+	coalescedWrite(chi[ss+s],res);
+      }
+    } else {
+      // Apply (U^{\prime})^{-dagger} U_m^{-\dagger}
+      res = chi(ss);
+      spProj5p(tmp,res);
+      acc = conjugate(ueem[0])*tmp;
+      spProj5m(tmp,res);
+      for(int s=1;s<Ls-1;s++){
+	res = chi(ss+s);
+	res -= conjugate(uee[s-1])*tmp;
+	spProj5p(tmp,res);
+	acc += conjugate(ueem[s])*tmp;
+	spProj5m(tmp,res);
+	coalescedWrite(chi[ss+s],res);
+      }
+      res = chi(ss+Ls-1) - conjugate(uee[Ls-2])*tmp - acc;
+
+      // Apply L_m^{-\dagger} D^{-dagger} L^{-dagger}
+      res = conjugate(1.0/dee[Ls-1])*res;
+      coalescedWrite(chi[ss+Ls-1],res);
+      spProj5m(acc,res);
+      spProj5p(tmp,res);
+      for (int s=Ls-2;s>=0;s--){
+	res = conjugate(1.0/dee[s])*chi(ss+s) - conjugate(lee[s])*tmp - conjugate(leem[s])*acc;
+	spProj5p(tmp,res);
+	coalescedWrite(chi[ss+s],res);
+      }
+    }
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -0,0 +1,353 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./Grid/qcd/action/fermion/CompressedWilsonImpl.h
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////
+// Wilson fermions with the doubled gauge field held in compressed form.
+//
+// Nreal=12 : first two rows, third row rebuilt as conj(r0 x r1)
+// Nreal=8  : a2,a3,b1 and the phases of a1,c1; rest rebuilt from unitarity
+//
+// The Dslash is bandwidth bound and the links are close to half of the
+// traffic; the rebuild is a few flops per link in registers.
+//
+// The doubled links must be -1/2 U with U in SU(3), as every Wilson type
+// ImportGauge produces; anisotropy factors and twists are not supported.
+// Boundary phases cannot be folded into two rows, so they are applied to
+// U chi in multLink and the hand kernels for the legs that wrap around
+// the world. The 8 real form is singular where |a1|=1, e.g. on a unit
+// gauge. DoubleStore checks the rebuilt links against the input.
+/////////////////////////////////////////////////////////////////////////////
+template <class S, int Nreal, class Options = CoeffReal >
+class CompressedWilsonImpl : public WilsonImpl<S, FundamentalRepresentation, Options> {
+public:
+
+  typedef WilsonImpl<S, FundamentalRepresentation, Options> Base;
+  typedef typename Base::Gimpl Gimpl;
+  INHERIT_GIMPL_TYPES(Gimpl);
+
+  static const int Dimension = Base::Dimension;
+  static const int Ncompress = Nreal/2;
+  static_assert((Nreal==12)||(Nreal==8),"Compressed links are 12 or 8 real");
+  static_assert(Dimension==3,"Compressed links are SU(3) only");
+
+  typedef typename Base::Coeff_t     Coeff_t;
+  typedef typename Base::SiteSpinor  SiteSpinor;
+  typedef typename Base::FermionField FermionField;
+  typedef typename Base::ImplParams  ImplParams;
+  typedef typename Base::StencilImpl StencilImpl;
+  typedef typename Base::StencilView StencilView;
+
+  template <typename vtype> using iImplDoubledGaugeField = iVector<iScalar<iVector<vtype, Ncompress> >, Nds>;
+
+  typedef iImplDoubledGaugeField<Simd>   SiteDoubledGaugeField;
+  typedef Lattice<SiteDoubledGaugeField> DoubledGaugeField;
+
+#ifdef GRID_SIMT
+  typedef typename Simd::scalar_type SimtComplex;
+#else
+  typedef Simd SimtComplex;
+#endif
+  typedef iScalar<iMatrix<SimtComplex, Dimension> > SimtLink;
+
+  // Hopping normalisation carried by the doubled links
+  static accelerator_inline RealD LinkScale(void) { return -0.5; }
+
+  using Base::Params;
+
+  CompressedWilsonImpl(const ImplParams &p = ImplParams()) : Base(p) {};
+
+  ////////////////////////////////////////////////////////////////////////
+  // Rebuild
+  ////////////////////////////////////////////////////////////////////////
+  template<class cplx>
+  static accelerator_inline void reconstruct(iMatrix<cplx,3> &M,const iVector<cplx,6> &C)
+  {
+    cplx sinv(1.0/LinkScale());
+    for(int j=0;j<3;j++){
+      M(0,j) = C(j);
+      M(1,j) = C(3+j);
+    }
+    M(2,0) = conjugate(M(0,1)*M(1,2)-M(0,2)*M(1,1))*sinv;
+    M(2,1) = conjugate(M(0,2)*M(1,0)-M(0,0)*M(1,2))*sinv;
+    M(2,2) = conjugate(M(0,0)*M(1,1)-M(0,1)*M(1,0))*sinv;
+  }
+  template<class cplx>
+  static accelerator_inline void reconstruct(iMatrix<cplx,3> &M,const iVector<cplx,4> &C)
+  {
+    cplx one(1.0);
+    cplx half(0.5);
+    cplx scale(LinkScale());
+    cplx a2 = C(0);
+    cplx a3 = C(1);
+    cplx b1 = C(2);
+    cplx ta = (C(3)+conjugate(C(3)))*half;
+    cplx tc = timesMinusI(C(3)-conjugate(C(3)))*half;
+    cplx N  = a2*conjugate(a2)+a3*conjugate(a3);
+    cplx a1 = sqrt(one-N)*(cos(ta)+timesI(sin(ta)));
+    cplx c1 = sqrt(N-b1*conjugate(b1))*(cos(tc)+timesI(sin(tc)));
+    cplx Ninv = one/N;
+    M(0,0) = a1;
+    M(0,1) = a2;
+    M(0,2) = a3;
+    M(1,0) = b1;
+    M(1,1) =-(conjugate(c1)*conjugate(a3)+conjugate(a1)*a2*b1)*Ninv;
+    M(1,2) = (conjugate(c1)*conjugate(a2)-conjugate(a1)*a3*b1)*Ninv;
+    M(2,0) = c1;
+    M(2,1) = (conjugate(b1)*conjugate(a3)-conjugate(a1)*a2*c1)*Ninv;
+    M(2,2) =-(conjugate(b1)*conjugate(a2)+conjugate(a1)*a3*c1)*Ninv;
+    for(int i=0;i<3;i++){
+      for(int j=0;j<3;j++){
+	M(i,j) = M(i,j)*scale;
+      }
+    }
+  }
+  template<class cplx>
+  static inline void compress(iVector<cplx,6> &C,const iMatrix<cplx,3> &M)
+  {
+    for(int j=0;j<3;j++){
+      C(j)   = M(0,j);
+      C(3+j) = M(1,j);
+    }
+  }
+  template<class cplx>
+  static inline void compress(iVector<cplx,4> &C,const iMatrix<cplx,3> &M)
+  {
+    cplx sinv(1.0/LinkScale());
+    C(0) = M(0,1)*sinv;
+    C(1) = M(0,2)*sinv;
+    C(2) = M(1,0)*sinv;
+    C(3) = cplx(arg(M(0,0)*sinv),arg(M(2,0)*sinv));
+  }
+
+  static accelerator_inline SimtLink loadLink(const SiteDoubledGaugeField &U,int mu)
+  {
+    auto UU = coalescedRead(U(mu));
+    SimtLink M;
+    reconstruct(M(),UU());
+    return M;
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Boundary phase for a leg that wraps around the world. With SIMD lanes
+  // in the direction only the lane at the edge of the lattice wraps.
+  ////////////////////////////////////////////////////////////////////////
+  static accelerator_inline int hasBoundaryPhase(int mu,StencilView &St)
+  {
+    auto pha = St.parameters.boundary_phases[mu%Nd];
+    return (real(pha)!=1.0)||(imag(pha)!=0.0);
+  }
+  static accelerator_inline SimtComplex boundaryPhase(int mu,StencilView &St)
+  {
+    typedef typename Simd::scalar_type scalar_type;
+    int direction = St._directions[mu];
+    int distance  = St._distances[mu];
+    int sl        = St._simd_layout[direction];
+    auto pha      = St.parameters.boundary_phases[mu%Nd];
+    scalar_type phase(real(pha),imag(pha));
+    scalar_type one(1.0);
+    if ( mu >= Nd ) phase = conjugate(phase);
+    Coordinate icoor;
+#ifdef GRID_SIMT
+    int lane = acceleratorSIMTlane(Simd::Nsimd());
+    St.iCoorFromIindex(icoor,lane);
+    int wrap = (sl==1)
+      || ((distance== 1)&&(icoor[direction]==sl-1))
+      || ((distance==-1)&&(icoor[direction]==0));
+    return wrap ? phase : one;
+#else
+    const int Nsimd = Simd::Nsimd();
+    ExtractBuffer<scalar_type> vals(Nsimd);
+    for(int s=0;s<Nsimd;s++){
+      St.iCoorFromIindex(icoor,s);
+      int wrap = (sl==1)
+	|| ((distance== 1)&&(icoor[direction]==sl-1))
+	|| ((distance==-1)&&(icoor[direction]==0));
+      vals[s] = wrap ? phase : one;
+    }
+    Simd ret;
+    vset(ret,&vals[0]);
+    return ret;
+#endif
+  }
+  template<class cplx,int Nspin>
+  static accelerator_inline void multPhase(iScalar<iVector<iVector<cplx,Dimension>,Nspin> > &phi,const cplx &ph)
+  {
+    for(int s=0;s<Nspin;s++){
+      for(int c=0;c<Dimension;c++){
+	phi()(s)(c) = ph*phi()(s)(c);
+      }
+    }
+  }
+
+  template<class _Spinor>
+  static accelerator_inline void multLink(_Spinor &phi,
+					  const SiteDoubledGaugeField &U,
+					  const _Spinor &chi,
+					  int mu)
+  {
+    auto UU = loadLink(U,mu);
+    mult(&phi(), &UU, &chi());
+  }
+  template<class _Spinor>
+  static accelerator_inline void multLink(_Spinor &phi,
+					  const SiteDoubledGaugeField &U,
+					  const _Spinor &chi,
+					  int mu,
+					  StencilEntry *SE,
+					  StencilView &St)
+  {
+    multLink(phi,U,chi,mu);
+    if ( SE->_around_the_world && hasBoundaryPhase(mu,St) ) {
+      multPhase(phi,boundaryPhase(mu,St));
+    }
+  }
+
+  template<class _Field>
+  inline void applyBoundaryPhase(_Field &f,int mu)
+  {
+    typedef typename Simd::scalar_type scalar_type;
+    int mmu = mu%Nd;
+    auto pha = Params.boundary_phases[mmu];
+    if ( (real(pha)==1.0) && (imag(pha)==0.0) ) return;
+    scalar_type phase(real(pha),imag(pha));
+    if ( mu >= Nd ) phase = conjugate(phase);
+
+    GridBase *grid = f.Grid();
+    int L    = grid->GlobalDimensions()[mmu];
+    int edge = (mu < Nd) ? L-1 : 0;
+    Lattice<iScalar<vInteger> > coor(grid);
+    LatticeCoordinate(coor,mmu);
+    f = where(coor==edge,phase*f,f);
+  }
+
+  template<class _SpinorField>
+  inline void multLinkField(_SpinorField & out,
+			    const DoubledGaugeField &Umu,
+			    const _SpinorField & phi,
+			    int mu)
+  {
+    const int Nsimd = SiteSpinor::Nsimd();
+    {
+      autoView( out_v, out, AcceleratorWrite);
+      autoView( phi_v, phi, AcceleratorRead);
+      autoView( Umu_v, Umu, AcceleratorRead);
+      typedef decltype(coalescedRead(out_v[0]))   calcSpinor;
+      accelerator_for(sss,out.Grid()->oSites(),Nsimd,{
+	calcSpinor tmp;
+	multLink(tmp,Umu_v[sss],phi_v(sss),mu);
+	coalescedWrite(out_v[sss],tmp);
+      });
+    }
+    applyBoundaryPhase(out,mu);
+  }
+
+  inline void extractLinkField(std::vector<GaugeLinkField> &mat, DoubledGaugeField &Uds)
+  {
+    for (int mu = 0; mu < Nd; mu++) {
+      ReconstructLinkField(mat[mu],Uds,mu);
+      applyBoundaryPhase(mat[mu],mu);
+    }
+  }
+
+  static inline void ReconstructLinkField(GaugeLinkField &U,const DoubledGaugeField &Uds,int mu)
+  {
+    const int Nsimd = Simd::Nsimd();
+    autoView( U_v  , U  , AcceleratorWrite);
+    autoView( Uds_v, Uds, AcceleratorRead);
+    accelerator_for(ss,U.Grid()->oSites(),Nsimd,{
+      auto M = loadLink(Uds_v[ss],mu);
+      coalescedWrite(U_v[ss](),M);
+    });
+  }
+
+  // All directions through one view; a CpuWrite view does not preserve the rest
+  static inline void CompressLinkFields(DoubledGaugeField &Uds,const std::vector<GaugeLinkField> &U)
+  {
+    typedef typename GaugeLinkField::vector_object::scalar_object sobj;
+    typedef typename SiteDoubledGaugeField::element::scalar_object cobj;
+    const int Nsimd = Simd::Nsimd();
+    autoView( Uds_v, Uds, CpuWrite);
+    for (int mu = 0; mu < Nds; mu++) {
+      autoView( U_v  , U[mu], CpuRead);
+      thread_for(ss,Uds.Grid()->oSites(),{
+	ExtractBuffer<sobj> links(Nsimd);
+	ExtractBuffer<cobj> compressed(Nsimd);
+	extract(U_v[ss],links);
+	for(int s=0;s<Nsimd;s++){
+	  compress(compressed[s](),links[s]()());
+	}
+	merge(Uds_v[ss](mu),compressed);
+      });
+    }
+  }
+
+  inline void DoubleStore(GridBase *GaugeGrid,
+			  DoubledGaugeField &Uds,
+			  const GaugeField &Umu)
+  {
+    conformable(Uds.Grid(), GaugeGrid);
+    conformable(Umu.Grid(), GaugeGrid);
+
+    for (int mu = 0; mu < Nd; mu++) {
+      assert(Params.twist_n_2pi_L[mu]==0.0);
+    }
+
+    std::vector<GaugeLinkField> U(Nds,GaugeGrid);
+    for (int mu = 0; mu < Nd; mu++) {
+      U[mu]    = PeekIndex<LorentzIndex>(Umu, mu);
+      U[mu+Nd] = adj(Cshift(U[mu], mu, -1));
+    }
+    CompressLinkFields(Uds,U);
+
+    GaugeLinkField R(GaugeGrid);
+    for (int mu = 0; mu < Nds; mu++) {
+      ReconstructLinkField(R,Uds,mu);
+      RealD nrm = norm2(U[mu]);
+      R = R - U[mu];
+      RealD err = norm2(R)/nrm;
+      if ( !(err < 1.0e-8) ) {
+	std::cout << GridLogError << "CompressedWilsonImpl: "<<Nreal<<" real links do not reproduce the gauge field in direction "
+		  << mu << " relative error " << err << std::endl;
+	std::cout << GridLogError << "CompressedWilsonImpl: links must be -1/2 U with U in SU(3)" << std::endl;
+	assert(0);
+      }
+    }
+  }
+};
+
+typedef CompressedWilsonImpl<vComplex,  12, CoeffReal > WilsonImpl12R;  // Real.. whichever prec
+typedef CompressedWilsonImpl<vComplexF, 12, CoeffReal > WilsonImpl12F;  // Float
+typedef CompressedWilsonImpl<vComplexD, 12, CoeffReal > WilsonImpl12D;  // Double
+
+typedef CompressedWilsonImpl<vComplex,   8, CoeffReal > WilsonImpl8R;   // Real.. whichever prec
+typedef CompressedWilsonImpl<vComplexF,  8, CoeffReal > WilsonImpl8F;   // Float
+typedef CompressedWilsonImpl<vComplexD,  8, CoeffReal > WilsonImpl8D;   // Double
+
+NAMESPACE_END(Grid);
@@ -93,6 +93,12 @@ NAMESPACE_CHECK(Overlap);
 #include <Grid/qcd/action/fermion/WilsonTMFermion5D.h>   
 NAMESPACE_CHECK(WilsonTM5);
 
+///////////////////////////////////////////////////////////////////////////////
+// Wilson on multiple right hand sides batched in the fifth dimension
+///////////////////////////////////////////////////////////////////////////////
+#include <Grid/qcd/action/fermion/WilsonFermionMultiRHS.h>
+NAMESPACE_CHECK(WilsonMultiRHS);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Move this group to a DWF specific tools/algorithms subdir? 
 ////////////////////////////////////////////////////////////////////////////////
@@ -279,6 +285,31 @@ typedef MobiusEOFAFermion<GparityWilsonImplRL> GparityMobiusEOFAFermionRL;
 typedef MobiusEOFAFermion<GparityWilsonImplFH> GparityMobiusEOFAFermionFH;
 typedef MobiusEOFAFermion<GparityWilsonImplDF> GparityMobiusEOFAFermionDF;
 
+// Compressed gauge links; partial list
+typedef WilsonFermion<WilsonImpl12R> WilsonFermion12R;
+typedef WilsonFermion<WilsonImpl12F> WilsonFermion12F;
+typedef WilsonFermion<WilsonImpl12D> WilsonFermion12D;
+
+typedef WilsonFermion<WilsonImpl8R> WilsonFermion8R;
+typedef WilsonFermion<WilsonImpl8F> WilsonFermion8F;
+typedef WilsonFermion<WilsonImpl8D> WilsonFermion8D;
+
+typedef DomainWallFermion<WilsonImpl12R> DomainWallFermion12R;
+typedef DomainWallFermion<WilsonImpl12F> DomainWallFermion12F;
+typedef DomainWallFermion<WilsonImpl12D> DomainWallFermion12D;
+
+typedef DomainWallFermion<WilsonImpl8R> DomainWallFermion8R;
+typedef DomainWallFermion<WilsonImpl8F> DomainWallFermion8F;
+typedef DomainWallFermion<WilsonImpl8D> DomainWallFermion8D;
+
+typedef MobiusFermion<WilsonImpl12R> MobiusFermion12R;
+typedef MobiusFermion<WilsonImpl12F> MobiusFermion12F;
+typedef MobiusFermion<WilsonImpl12D> MobiusFermion12D;
+
+typedef MobiusFermion<WilsonImpl8R> MobiusFermion8R;
+typedef MobiusFermion<WilsonImpl8F> MobiusFermion8F;
+typedef MobiusFermion<WilsonImpl8D> MobiusFermion8D;
+
 typedef ImprovedStaggeredFermion<StaggeredImplR> ImprovedStaggeredFermionR;
 typedef ImprovedStaggeredFermion<StaggeredImplF> ImprovedStaggeredFermionF;
 typedef ImprovedStaggeredFermion<StaggeredImplD> ImprovedStaggeredFermionD;
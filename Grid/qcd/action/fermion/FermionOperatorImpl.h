@@ -167,6 +167,12 @@ NAMESPACE_CHECK(ImplBase);
 /////////////////////////////////////////////////////////////////////////////
 #include <Grid/qcd/action/fermion/WilsonImpl.h> 
 NAMESPACE_CHECK(ImplWilson);  
+
+/////////////////////////////////////////////////////////////////////////////
+// As above with the doubled gauge field stored as 12 or 8 reals
+/////////////////////////////////////////////////////////////////////////////
+#include <Grid/qcd/action/fermion/CompressedWilsonImpl.h> 
+NAMESPACE_CHECK(ImplCompressedWilson);  
    
 ////////////////////////////////////////////////////////////////////////////////////////
 // Flavour doubled spinors; is Gparity the only? what about C*?
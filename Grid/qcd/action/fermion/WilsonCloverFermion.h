@@ -30,6 +30,7 @@
 #pragma once
 
 #include <Grid/Grid.h>
+#include <Grid/qcd/action/fermion/WilsonCloverHelpers.h>
 
 NAMESPACE_BEGIN(Grid);
 
@@ -47,6 +48,10 @@ NAMESPACE_BEGIN(Grid);
 // Wilson Dirac operator
 //
 // csw_r = csw_t to recover the isotropic version
+//
+// The clover term and its inverse are held as two packed Hermitian
+// chiral blocks per site (CloverChiralBlock), a quarter of the full
+// spin-colour matrix; being Hermitian, no dagger copies are kept.
 //////////////////////////////////////////////////////////////////
 
 template <class Impl>
@@ -60,6 +65,12 @@ public:
   typedef iImplClover<Simd> SiteCloverType;
   typedef Lattice<SiteCloverType> CloverFieldType;
 
+  typedef CloverChiralBlock<Impl::Dimension> CloverPacking;
+  template <typename vtype>
+  using iImplCloverPacked = iVector<iVector<vtype, CloverPacking::Npacked>, 2>;
+  typedef iImplCloverPacked<Simd> SiteCloverPackedType;
+  typedef Lattice<SiteCloverPackedType> CloverPackedFieldType;
+
 public:
   typedef WilsonFermion<Impl> WilsonBase;
 
@@ -81,11 +92,7 @@ public:
                                                                  CloverTermEven(&Hgrid),
                                                                  CloverTermOdd(&Hgrid),
                                                                  CloverTermInvEven(&Hgrid),
-                                                                 CloverTermInvOdd(&Hgrid),
-                                                                 CloverTermDagEven(&Hgrid),
-                                                                 CloverTermDagOdd(&Hgrid),
-                                                                 CloverTermInvDagEven(&Hgrid),
-                                                                 CloverTermInvDagOdd(&Hgrid)
+                                                                 CloverTermInvOdd(&Hgrid)
   {
     assert(Nd == 4); // require 4 dimensions
 
@@ -251,15 +258,13 @@ protected:
   RealD csw_r;                                               // Clover coefficient - spatial
   RealD csw_t;                                               // Clover coefficient - temporal
   RealD diag_mass;                                           // Mass term
-  CloverFieldType CloverTerm, CloverTermInv;                 // Clover term
-  CloverFieldType CloverTermEven, CloverTermOdd;             // Clover term EO
-  CloverFieldType CloverTermInvEven, CloverTermInvOdd;       // Clover term Inv EO
-  CloverFieldType CloverTermDagEven, CloverTermDagOdd;       // Clover term Dag EO
-  CloverFieldType CloverTermInvDagEven, CloverTermInvDagOdd; // Clover term Inv Dag EO
+  CloverPackedFieldType CloverTerm, CloverTermInv;           // Clover term
+  CloverPackedFieldType CloverTermEven, CloverTermOdd;       // Clover term EO
+  CloverPackedFieldType CloverTermInvEven, CloverTermInvOdd; // Clover term Inv EO
 
  public:
-  // eventually these can be compressed into 6x6 blocks instead of the 12x12
-  // using the DeGrand-Rossi basis for the gamma matrices
+  // Full 12x12 form of the individual terms; ImportGauge builds the
+  // packed chiral blocks directly, see CloverChiralBlock::Build
   CloverFieldType fillCloverYZ(const GaugeLinkField &F)
   {
     CloverFieldType T(F.Grid());
@@ -0,0 +1,171 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/action/fermion/WilsonCloverHelpers.h
+
+    Copyright (C) 2017
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+/*  END LEGAL */
+
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////
+// Packed chiral blocks of the clover term
+//
+// In the chiral gamma basis sigma_{mu nu} is block diagonal in the
+// spin pairs (0,1) and (2,3), so the clover term is two Hermitian
+// N x N blocks, N = 2*Nrep, indexed i = spin*Nrep + colour. A block
+// is stored in Npacked complex words:
+//
+//   [0, N/2)        real diagonal, entries 2k and 2k+1 in the real and
+//                   imaginary parts of word k
+//   [N/2, Npacked)  strict lower triangle, row by row
+//
+// The upper triangle follows by hermiticity. For SU(3) this is 18
+// words a block, against 144 for the full 12x12 spin-colour matrix.
+//
+// All routines work on an element type T that is either a SIMD
+// vector, so that one call treats every lane of an outer site at
+// once, or a scalar under SIMT.
+///////////////////////////////////////////////////////////////////
+template<int Nrep>
+class CloverChiralBlock {
+public:
+  static constexpr int N       = 2*Nrep;
+  static constexpr int Ndiag   = N/2;
+  static constexpr int Npacked = Ndiag + (N*(N-1))/2;
+
+  // Word holding element (i,j) of the strict lower triangle, i > j
+  static accelerator_inline int Lower(int i,int j) { return Ndiag + (i*(i-1))/2 + j; }
+
+  template<class T> static accelerator_inline T Re(const T &z) { return T(0.5)*(z+conjugate(z)); }
+
+  template<class T> static accelerator_inline T Diag(const iVector<T,Npacked> &P,int i)
+  {
+    return (i&1) ? Re(timesMinusI(P(i/2))) : Re(P(i/2));
+  }
+
+  template<class T> static accelerator_inline void SetDiag(iVector<T,Npacked> &P,const T *d)
+  {
+    for(int k=0;k<Ndiag;k++) P(k) = Re(d[2*k]) + timesI(Re(d[2*k+1]));
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // Pack both blocks from the field strength colour matrices. Entries
+  // follow WilsonCloverFermion::fillClover*; the E terms flip sign
+  // between the two chiralities.
+  //////////////////////////////////////////////////////////////////////
+  template<class T,class cmat>
+  static accelerator_inline void Build(iVector<iVector<T,Npacked>,2> &P,
+				       const cmat &Bx,const cmat &By,const cmat &Bz,
+				       const cmat &Ex,const cmat &Ey,const cmat &Ez,
+				       RealD csw_r,RealD csw_t,RealD diag_mass)
+  {
+    T r(csw_r);
+    T t(csw_t);
+    for(int b=0;b<2;b++){
+      T sig( (b==0) ? 1.0 : -1.0 );
+      T d[N];
+      for(int a=0;a<Nrep;a++){
+	for(int c=0;c<=a;c++){
+	  // spin (0,0) and (1,1)
+	  T s00 = timesMinusI(r*Bz(a,c)) + sig*timesI(t*Ez(a,c));
+	  T s11 = T(0.0) - s00;
+	  if ( a==c ) {
+	    d[a]      = Re(s00) + T(diag_mass);
+	    d[Nrep+a] = Re(s11) + T(diag_mass);
+	  } else {
+	    P(b)(Lower(a,c))           = s00;
+	    P(b)(Lower(Nrep+a,Nrep+c)) = s11;
+	  }
+	}
+	// spin (1,0)
+	for(int c=0;c<Nrep;c++){
+	  P(b)(Lower(Nrep+a,c)) = timesMinusI(r*Bx(a,c)) + r*By(a,c)
+	                        + sig*(timesI(t*Ex(a,c)) + t*Ey(a,c));
+	}
+      }
+      SetDiag(P(b),d);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // In place inverse through A = L D L^dag, L unit lower triangular,
+  // D real. Then A^-1 = X^dag D^-1 X with X = L^-1. No pivoting: the
+  // clover term is dominated by its diagonal.
+  //////////////////////////////////////////////////////////////////////
+  template<class T> static accelerator_inline void Invert(iVector<T,Npacked> &P)
+  {
+    T L[N][N];
+    T Dinv[N];
+    T D[N];
+    for(int j=0;j<N;j++){
+      T dj = Diag(P,j);
+      for(int k=0;k<j;k++) dj = dj - L[j][k]*conjugate(L[j][k])*D[k];
+      D[j]    = Re(dj);
+      Dinv[j] = T(1.0)/D[j];
+      for(int i=j+1;i<N;i++){
+	T l = P(Lower(i,j));
+	for(int k=0;k<j;k++) l = l - L[i][k]*conjugate(L[j][k])*D[k];
+	L[i][j] = l*Dinv[j];
+      }
+    }
+    // X = L^-1, overwrite L below the diagonal
+    for(int j=0;j<N;j++){
+      for(int i=j+1;i<N;i++){
+	T x = T(0.0) - L[i][j];
+	for(int k=j+1;k<i;k++) x = x - L[i][k]*L[k][j];
+	L[i][j] = x;
+      }
+    }
+    T d[N];
+    for(int i=0;i<N;i++){
+      T a = Dinv[i];
+      for(int k=i+1;k<N;k++) a = a + conjugate(L[k][i])*Dinv[k]*L[k][i];
+      d[i] = Re(a);
+      for(int j=0;j<i;j++){
+	T o = Dinv[i]*L[i][j];
+	for(int k=i+1;k<N;k++) o = o + conjugate(L[k][i])*Dinv[k]*L[k][j];
+	P(Lower(i,j)) = o;
+      }
+    }
+    SetDiag(P,d);
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // y = P x on spins s0, s0+1 of a spinor site
+  //////////////////////////////////////////////////////////////////////
+  template<class T,class spinor>
+  static accelerator_inline void Mult(spinor &y,const iVector<T,Npacked> &P,const spinor &x,int s0)
+  {
+    T xv[N];
+    for(int i=0;i<N;i++) xv[i] = x()(s0+i/Nrep)(i%Nrep);
+    for(int i=0;i<N;i++){
+      T acc = Diag(P,i)*xv[i];
+      for(int j=0;j<i;j++)   acc = acc + P(Lower(i,j))*xv[j];
+      for(int j=i+1;j<N;j++) acc = acc + conjugate(P(Lower(j,i)))*xv[j];
+      y()(s0+i/Nrep)(i%Nrep) = acc;
+    }
+  }
+};
+
+NAMESPACE_END(Grid);
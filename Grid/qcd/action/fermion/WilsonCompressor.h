@@ -314,12 +314,12 @@ public:
 	surface_list.push_back(site);
       }
     }
+    this->BuildSurfaceListPoint(Ls,vol4);
   }
 
   template < class compressor>
   void HaloExchangeOpt(const Lattice<vobj> &source,compressor &compress) 
   {
-    std::vector<std::vector<CommsRequest_t> > reqs;
     this->HaloExchangeOptGather(source,compress);
     double t1=usecond();
     // Asynchronous MPI calls multidirectional, Isend etc...
@@ -360,6 +360,8 @@ public:
     this->halogtime-=usecond();
     
     this->u_comm_offset=0;
+
+    this->PlanBegin(compress);
       
     WilsonXpCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> XpCompress; 
     WilsonYpCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> YpCompress; 
@@ -393,6 +395,7 @@ public:
     }
     this->face_table_computed=1;
     assert(this->u_comm_offset==this->_unified_buffer_size);
+    this->PlanEnd();
     this->halogtime+=usecond();
     accelerator_barrier();
   }
@@ -0,0 +1,202 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./Grid/qcd/action/fermion/WilsonFermionMultiRHS.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#pragma once
+
+#include <Grid/qcd/action/fermion/FermionCore.h>
+#include <Grid/qcd/action/fermion/WilsonFermion5D.h>
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Wilson operator on several right hand sides at once.
+//
+// The right hand sides are interleaved in the s-direction of a 5d grid, see
+// InsertRHS/ExtractRHS, and the 5d hopping term applies each gauge link to all
+// of them; the halo exchange sends one message per direction for the batch.
+//
+// With FiveDimGrid = makeFiveDimGrid(nrhs,UGrid) this is nrhs copies of the
+// 4d Wilson operator. The hopping term is diagonal in s, so on a grid of
+// extent Ls*nrhs Dhop is also the batched hopping term of nrhs 5d (DWF) fields.
+//
+// M, Mdag, Meooe and MeooeDag act on a whole batch when given fields on the
+// batch grid; a field on any other grid is treated as a batch of one, so the
+// class can stand in for the single field operator (e.g. in the Schur
+// operators) at the cost of sweeping the unused slots.
+////////////////////////////////////////////////////////////////////////////////
+template<class Impl>
+class WilsonFermionMultiRHS : public WilsonFermion5D<Impl>
+{
+public:
+  INHERIT_IMPL_TYPES(Impl);
+
+  virtual void Instantiatable(void) {};
+
+  WilsonFermionMultiRHS(GaugeField &_Umu,
+			GridCartesian         &FiveDimGrid,
+			GridRedBlackCartesian &FiveDimRedBlackGrid,
+			GridCartesian         &FourDimGrid,
+			GridRedBlackCartesian &FourDimRedBlackGrid,
+			RealD _mass,
+			const ImplParams &p= ImplParams()) :
+    WilsonFermion5D<Impl>(_Umu,
+			  FiveDimGrid,
+			  FiveDimRedBlackGrid,
+			  FourDimGrid,
+			  FourDimRedBlackGrid,
+			  4.0,p),
+    mass(_mass),
+    BatchIn   (&FiveDimGrid),
+    BatchOut  (&FiveDimGrid),
+    BatchInRB (&FiveDimRedBlackGrid),
+    BatchOutRB(&FiveDimRedBlackGrid)
+  {
+    // Slots beyond a partial batch are still swept by the kernels
+    BatchIn  = Zero();
+    BatchInRB= Zero();
+  }
+
+  virtual RealD Mass(void) { return mass; }
+
+  virtual void M(const FermionField &in, FermionField &out)
+  {
+    if ( !OnBatchGrid(in) ) { Single(&WilsonFermionMultiRHS::MMultiRHS, in, out); return; }
+    out.Checkerboard() = in.Checkerboard();
+    this->Dhop(in, out, DaggerNo);
+    axpy(out, 4.0+mass, in, out);
+  }
+  virtual void Mdag(const FermionField &in, FermionField &out)
+  {
+    if ( !OnBatchGrid(in) ) { Single(&WilsonFermionMultiRHS::MdagMultiRHS, in, out); return; }
+    out.Checkerboard() = in.Checkerboard();
+    this->Dhop(in, out, DaggerYes);
+    axpy(out, 4.0+mass, in, out);
+  }
+
+  virtual void Meooe(const FermionField &in, FermionField &out)
+  {
+    if ( !OnBatchGrid(in) ) { Single(&WilsonFermionMultiRHS::MeooeMultiRHS, in, out); return; }
+    if (in.Checkerboard() == Odd) {
+      this->DhopEO(in, out, DaggerNo);
+    } else {
+      this->DhopOE(in, out, DaggerNo);
+    }
+  }
+  virtual void MeooeDag(const FermionField &in, FermionField &out)
+  {
+    if ( !OnBatchGrid(in) ) { Single(&WilsonFermionMultiRHS::MeooeDagMultiRHS, in, out); return; }
+    if (in.Checkerboard() == Odd) {
+      this->DhopEO(in, out, DaggerYes);
+    } else {
+      this->DhopOE(in, out, DaggerYes);
+    }
+  }
+
+  virtual void Mooee(const FermionField &in, FermionField &out)
+  {
+    out.Checkerboard() = in.Checkerboard();
+    out = (4.0+mass)*in;
+  }
+  virtual void MooeeDag(const FermionField &in, FermionField &out)
+  {
+    Mooee(in, out);
+  }
+  virtual void MooeeInv(const FermionField &in, FermionField &out)
+  {
+    out.Checkerboard() = in.Checkerboard();
+    out = (1.0/(4.0+mass))*in;
+  }
+  virtual void MooeeInvDag(const FermionField &in, FermionField &out)
+  {
+    MooeeInv(in, out);
+  }
+
+  ///////////////////////////////////////////////////////////////
+  // Unbatched interface, up to Ls fields. DhopMultiRHS and the Meooe
+  // variants take full or half checkerboard fields, MMultiRHS and
+  // MdagMultiRHS full ones.
+  ///////////////////////////////////////////////////////////////
+  void DhopMultiRHS(const std::vector<FermionField> &in, std::vector<FermionField> &out, int dag)
+  {
+    assert(in.size()>0);
+    if ( in[0].Grid()->_isCheckerBoarded ) {
+      InsertRHS(in, BatchInRB);
+      if ( BatchInRB.Checkerboard() == Odd ) this->DhopEO(BatchInRB, BatchOutRB, dag);
+      else                                   this->DhopOE(BatchInRB, BatchOutRB, dag);
+      ExtractRHS(out, BatchOutRB);
+    } else {
+      InsertRHS(in, BatchIn);
+      this->Dhop(BatchIn, BatchOut, dag);
+      ExtractRHS(out, BatchOut);
+    }
+  }
+  virtual void MeooeMultiRHS(const std::vector<FermionField> &in, std::vector<FermionField> &out)
+  {
+    DhopMultiRHS(in, out, DaggerNo);
+  }
+  virtual void MeooeDagMultiRHS(const std::vector<FermionField> &in, std::vector<FermionField> &out)
+  {
+    DhopMultiRHS(in, out, DaggerYes);
+  }
+  virtual void MMultiRHS(const std::vector<FermionField> &in, std::vector<FermionField> &out)
+  {
+    InsertRHS(in, BatchIn);
+    M(BatchIn, BatchOut);
+    ExtractRHS(out, BatchOut);
+  }
+  virtual void MdagMultiRHS(const std::vector<FermionField> &in, std::vector<FermionField> &out)
+  {
+    InsertRHS(in, BatchIn);
+    Mdag(BatchIn, BatchOut);
+    ExtractRHS(out, BatchOut);
+  }
+
+private:
+  int OnBatchGrid(const FermionField &in)
+  {
+    return (in.Grid()==this->FermionGrid()) || (in.Grid()==this->FermionRedBlackGrid());
+  }
+  // Apply a batched entry point to one unbatched field
+  void Single(void (WilsonFermionMultiRHS::*op)(const std::vector<FermionField> &,std::vector<FermionField> &),
+	      const FermionField &in, FermionField &out)
+  {
+    std::vector<FermionField> vin (1,in);
+    std::vector<FermionField> vout(1,in.Grid());
+    (this->*op)(vin,vout);
+    out = vout[0];
+  }
+
+  RealD mass;
+  FermionField BatchIn;
+  FermionField BatchOut;
+  FermionField BatchInRB;
+  FermionField BatchOutRB;
+};
+
+typedef WilsonFermionMultiRHS<WilsonImplR> WilsonFermionMultiRHSR;
+typedef WilsonFermionMultiRHS<WilsonImplF> WilsonFermionMultiRHSF;
+typedef WilsonFermionMultiRHS<WilsonImplD> WilsonFermionMultiRHSD;
+
+NAMESPACE_END(Grid);
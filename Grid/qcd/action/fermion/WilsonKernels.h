@@ -40,8 +40,11 @@ class WilsonKernelsStatic {
 public:
   enum { OptGeneric, OptHandUnroll, OptInlineAsm };
   enum { CommsAndCompute, CommsThenCompute };
+  enum { ExteriorAfterComms, ExteriorByPoint };
   static int Opt;  
   static int Comms;
+  static int Exterior; // with CommsAndCompute, run the exterior as each point's data arrives
+  static int FusedSchur; // Cayley Schur complement in two fused sweeps; CommsThenCompute only
 };
  
 template<class Impl> class WilsonKernels : public FermionOperator<Impl> , public WilsonKernelsStatic { 
@@ -74,6 +77,16 @@ public:
   static void DhopDirKernel(StencilImpl &st, DoubledGaugeField &U,SiteHalfSpinor * buf,
 			    int Ls, int Nsite, const FermionField &in, FermionField &out, int dirdisp, int gamma);
 
+  // Exterior contribution of one stencil point, over that point's surface sites
+  static void DhopPointExtKernel(StencilImpl &st, DoubledGaugeField &U,SiteHalfSpinor * buf,
+				 int Ls, const FermionField &in, FermionField &out, int point, int dag);
+
+  // Hopping term a whole 4d site at a time, followed by the fifth dimension
+  // work of the Cayley Schur complement while the site's Ls vector is in cache
+  static void DhopKernelCayleySchur(int Opt,StencilImpl &st, DoubledGaugeField &U,SiteHalfSpinor * buf,
+				    int Ls, int Nsite, const FermionField &in, FermionField &out,
+				    const CayleySchurEpilogue<Impl> &epilogue);
+
 private:
 
   static accelerator_inline void DhopDirK(StencilView &st, DoubledGaugeFieldView &U,SiteHalfSpinor * buf,
@@ -107,6 +120,10 @@ private:
   static accelerator void GenericDhopSiteDagExt(StencilView &st,  DoubledGaugeFieldView &U, SiteHalfSpinor * buf,
 						       int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
 
+  static accelerator void GenericDhopSitePointExt(StencilView &st,  DoubledGaugeFieldView &U, SiteHalfSpinor * buf,
+						  int sF, int sU, const FermionFieldView &in, FermionFieldView &out,
+						  int point, int dag);
+
   static void AsmDhopSite(StencilView &st,  DoubledGaugeFieldView &U, SiteHalfSpinor * buf,
 			  int sF, int sU, int Ls, int Nsite, const FermionFieldView &in,FermionFieldView &out);
   
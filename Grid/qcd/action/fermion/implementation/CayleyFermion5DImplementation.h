@@ -214,54 +214,49 @@ void CayleyFermion5D<Impl>::M5D   (const FermionField &psi, FermionField &chi)
   M5D(psi,chi,chi,lower,diag,upper);
 }
 template<class Impl>
-void CayleyFermion5D<Impl>::Meooe5D    (const FermionField &psi, FermionField &Din)
-{
-  int Ls=this->Ls;
-  Vector<Coeff_t> diag = bs;
-  Vector<Coeff_t> upper= cs;
-  Vector<Coeff_t> lower= cs; 
-  upper[Ls-1]=-mass*upper[Ls-1];
-  lower[0]   =-mass*lower[0];
-  M5D(psi,psi,Din,lower,diag,upper);
-}
-// FIXME Redunant with the above routine; check this and eliminate
-template<class Impl> void CayleyFermion5D<Impl>::Meo5D     (const FermionField &psi, FermionField &chi)
+void CayleyFermion5D<Impl>::Meooe5DCoefficients(int dag,Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag = beo;
-  Vector<Coeff_t> upper(Ls);
-  Vector<Coeff_t> lower(Ls);
-  for(int i=0;i<Ls;i++) {
-    upper[i]=-ceo[i];
-    lower[i]=-ceo[i];
+  diag = bs;
+  upper= cs;
+  lower= cs;
+  if ( dag == DaggerNo ) {
+    upper[Ls-1]=-mass*upper[Ls-1];
+    lower[0]   =-mass*lower[0];
+    return;
   }
-  upper[Ls-1]=-mass*upper[Ls-1];
-  lower[0]   =-mass*lower[0];
-  M5D(psi,psi,chi,lower,diag,upper);
-}
-template<class Impl>
-void CayleyFermion5D<Impl>::Mooee       (const FermionField &psi, FermionField &chi)
-{
-  int Ls=this->Ls;
-  Vector<Coeff_t> diag = bee;
-  Vector<Coeff_t> upper(Ls);
-  Vector<Coeff_t> lower(Ls);
-  for(int i=0;i<Ls;i++) {
-    upper[i]=-cee[i];
-    lower[i]=-cee[i];
+  for (int s=0;s<Ls;s++){
+    if ( s== 0 ) {
+      upper[s] = cs[s+1];
+      lower[s] =-mass*cs[Ls-1];
+    } else if ( s==(Ls-1) ) { 
+      upper[s] =-mass*cs[0];
+      lower[s] = cs[s-1];
+    } else { 
+      upper[s] = cs[s+1];
+      lower[s] = cs[s-1];
+    }
+    upper[s] = conjugate(upper[s]);
+    lower[s] = conjugate(lower[s]);
+    diag[s]  = conjugate(diag[s]);
   }
-  upper[Ls-1]=-mass*upper[Ls-1];
-  lower[0]   =-mass*lower[0];
-  M5D(psi,psi,chi,lower,diag,upper);
 }
 template<class Impl>
-void CayleyFermion5D<Impl>::MooeeDag    (const FermionField &psi, FermionField &chi)
+void CayleyFermion5D<Impl>::MooeeCoefficients(int dag,Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag = bee;
-  Vector<Coeff_t> upper(Ls);
-  Vector<Coeff_t> lower(Ls);
-
+  diag = bee;
+  upper.resize(Ls);
+  lower.resize(Ls);
+  if ( dag == DaggerNo ) {
+    for(int i=0;i<Ls;i++) {
+      upper[i]=-cee[i];
+      lower[i]=-cee[i];
+    }
+    upper[Ls-1]=-mass*upper[Ls-1];
+    lower[0]   =-mass*lower[0];
+    return;
+  }
   for (int s=0;s<Ls;s++){
     // Assemble the 5d matrix
     if ( s==0 ) {
@@ -281,6 +276,41 @@ void CayleyFermion5D<Impl>::MooeeDag    (const FermionField &psi, FermionField &
     upper[s]=conjugate(upper[s]);
     lower[s]=conjugate(lower[s]);
   }
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::Meooe5D    (const FermionField &psi, FermionField &Din)
+{
+  Vector<Coeff_t> diag, upper, lower;
+  Meooe5DCoefficients(DaggerNo,lower,diag,upper);
+  M5D(psi,psi,Din,lower,diag,upper);
+}
+// FIXME Redunant with the above routine; check this and eliminate
+template<class Impl> void CayleyFermion5D<Impl>::Meo5D     (const FermionField &psi, FermionField &chi)
+{
+  int Ls=this->Ls;
+  Vector<Coeff_t> diag = beo;
+  Vector<Coeff_t> upper(Ls);
+  Vector<Coeff_t> lower(Ls);
+  for(int i=0;i<Ls;i++) {
+    upper[i]=-ceo[i];
+    lower[i]=-ceo[i];
+  }
+  upper[Ls-1]=-mass*upper[Ls-1];
+  lower[0]   =-mass*lower[0];
+  M5D(psi,psi,chi,lower,diag,upper);
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::Mooee       (const FermionField &psi, FermionField &chi)
+{
+  Vector<Coeff_t> diag, upper, lower;
+  MooeeCoefficients(DaggerNo,lower,diag,upper);
+  M5D(psi,psi,chi,lower,diag,upper);
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::MooeeDag    (const FermionField &psi, FermionField &chi)
+{
+  Vector<Coeff_t> diag, upper, lower;
+  MooeeCoefficients(DaggerYes,lower,diag,upper);
   M5Ddag(psi,psi,chi,lower,diag,upper);
 }
 
@@ -299,26 +329,8 @@ void CayleyFermion5D<Impl>::M5Ddag (const FermionField &psi, FermionField &chi)
 template<class Impl>
 void CayleyFermion5D<Impl>::MeooeDag5D    (const FermionField &psi, FermionField &Din)
 {
-  int Ls=this->Ls;
-  Vector<Coeff_t> diag =bs;
-  Vector<Coeff_t> upper=cs;
-  Vector<Coeff_t> lower=cs; 
-
-  for (int s=0;s<Ls;s++){
-    if ( s== 0 ) {
-      upper[s] = cs[s+1];
-      lower[s] =-mass*cs[Ls-1];
-    } else if ( s==(Ls-1) ) { 
-      upper[s] =-mass*cs[0];
-      lower[s] = cs[s-1];
-    } else { 
-      upper[s] = cs[s+1];
-      lower[s] = cs[s-1];
-    }
-    upper[s] = conjugate(upper[s]);
-    lower[s] = conjugate(lower[s]);
-    diag[s]  = conjugate(diag[s]);
-  }
+  Vector<Coeff_t> diag, upper, lower;
+  Meooe5DCoefficients(DaggerYes,lower,diag,upper);
   M5Ddag(psi,psi,Din,lower,diag,upper);
 }
 
@@ -380,6 +392,27 @@ void CayleyFermion5D<Impl>::MeooeDag    (const FermionField &psi, FermionField &
   MeooeDag5D(this->tmp(),chi); 
 }
 
+// The fused sweeps exchange the halo up front, so the overlapped
+// (and progress thread) comms keep the separate passes
+template<class Impl>
+void CayleyFermion5D<Impl>::SchurDiagMooee    (const FermionField &in, FermionField &out)
+{
+  if ( WilsonKernelsStatic::FusedSchur && (WilsonKernelsStatic::Comms == WilsonKernelsStatic::CommsThenCompute) ) {
+    SchurDiagMooeeInternal(in,out,DaggerNo);
+  } else {
+    CheckerBoardedSparseMatrixBase<FermionField>::SchurDiagMooee(in,out);
+  }
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::SchurDiagMooeeDag (const FermionField &in, FermionField &out)
+{
+  if ( WilsonKernelsStatic::FusedSchur && (WilsonKernelsStatic::Comms == WilsonKernelsStatic::CommsThenCompute) ) {
+    SchurDiagMooeeInternal(in,out,DaggerYes);
+  } else {
+    CheckerBoardedSparseMatrixBase<FermionField>::SchurDiagMooeeDag(in,out);
+  }
+}
+
 template<class Impl>
 void  CayleyFermion5D<Impl>::Mdir (const FermionField &psi, FermionField &chi,int dir,int disp)
 {
@@ -248,4 +248,88 @@ CayleyFermion5D<Impl>::MooeeInvDag (const FermionField &psi_i, FermionField &chi
 
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Schur complement in two sweeps of the hopping term, each followed by the
+// site local 5d work; see CayleySchurEpilogue.h. Opt in with
+// --dslash-fused-schur; the halo exchange is not overlapped with compute.
+///////////////////////////////////////////////////////////////////////////////
+template<class Impl>
+void
+CayleyFermion5D<Impl>::SchurDiagMooeeInternal(const FermionField &in, FermionField &out,int dag)
+{
+  GridBase *grid=in.Grid();
+  int Ls=this->Ls;
+  assert(grid->_rdimensions[0]==Ls);
+  conformable(grid,this->FermionRedBlackGrid());
+  conformable(grid,out.Grid());
+
+  int cb = in.Checkerboard();
+  assert(cb==Even || cb==Odd);
+  StencilImpl       &st_oe = (cb==Odd) ? this->StencilOdd  : this->StencilEven;
+  DoubledGaugeField &U_oe  = (cb==Odd) ? this->UmuEven     : this->UmuOdd;
+  StencilImpl       &st_eo = (cb==Odd) ? this->StencilEven : this->StencilOdd;
+  DoubledGaugeField &U_eo  = (cb==Odd) ? this->UmuOdd      : this->UmuEven;
+
+  Vector<Coeff_t> eo_lower, eo_diag, eo_upper;
+  Vector<Coeff_t> ee_lower, ee_diag, ee_upper;
+  Meooe5DCoefficients(dag,eo_lower,eo_diag,eo_upper);
+  MooeeCoefficients  (dag,ee_lower,ee_diag,ee_upper);
+
+  CayleySchurEpilogue<Impl> epilogue;
+  epilogue.Ls   = Ls;
+  epilogue.dag  = dag;
+  epilogue.last = 0;
+  epilogue.lee  = &lee[0];
+  epilogue.leem = &leem[0];
+  epilogue.uee  = &uee[0];
+  epilogue.ueem = &ueem[0];
+  epilogue.dee  = &dee[0];
+  epilogue.eo_lower = &eo_lower[0];
+  epilogue.eo_diag  = &eo_diag[0];
+  epilogue.eo_upper = &eo_upper[0];
+  epilogue.ee_lower = &ee_lower[0];
+  epilogue.ee_diag  = &ee_diag[0];
+  epilogue.ee_upper = &ee_upper[0];
+  epilogue.src      = nullptr;
+
+  FermionField chi(grid);
+  chi.Checkerboard() = !cb;
+  out.Checkerboard() = cb;
+
+  if ( dag == DaggerNo ) {
+    Meooe5D(in,this->tmp());
+    SchurHop(st_oe,U_oe,this->tmp(),chi,epilogue);
+  } else {
+    SchurHop(st_oe,U_oe,in,chi,epilogue);
+  }
+
+  autoView(in_v,in,AcceleratorRead);
+  epilogue.last = 1;
+  epilogue.src  = &in_v[0];
+  SchurHop(st_eo,U_eo,chi,out,epilogue);
+}
+
+template<class Impl>
+void
+CayleyFermion5D<Impl>::SchurHop(StencilImpl &st,DoubledGaugeField &U,
+				const FermionField &in, FermionField &out,
+				const CayleySchurEpilogue<Impl> &epilogue)
+{
+  Compressor compressor(epilogue.dag);
+
+  this->DhopCalls++;
+  this->DhopTotalTime-=usecond();
+
+  this->DhopCommTime-=usecond();
+  st.HaloExchangeOpt(in,compressor);
+  this->DhopCommTime+=usecond();
+
+  this->DhopComputeTime-=usecond();
+  int Opt = WilsonKernelsStatic::Opt;
+  WilsonKernels<Impl>::DhopKernelCayleySchur(Opt,st,U,st.CommBuf(),this->Ls,U.oSites(),in,out,epilogue);
+  this->DhopComputeTime+=usecond();
+
+  this->DhopTotalTime+=usecond();
+}
+
 NAMESPACE_END(Grid);
@@ -304,8 +304,7 @@ void ImprovedStaggeredFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl &
   DhopFaceTime+=usecond();
 
   DhopCommTime -=usecond();
-  std::vector<std::vector<CommsRequest_t> > requests;
-  st.CommunicateBegin(requests);
+  st.CommunicateBegin();
 
   //  st.HaloExchangeOptGather(in,compressor); // Wilson compressor
   DhopFaceTime-=usecond();
@@ -327,7 +326,7 @@ void ImprovedStaggeredFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl &
   st.CommsMerge(compressor);
   DhopFaceTime+=usecond();
 
-  st.CommunicateComplete(requests);
+  st.CommunicateComplete();
   DhopCommTime +=usecond();
 
   DhopComputeTime2-=usecond();
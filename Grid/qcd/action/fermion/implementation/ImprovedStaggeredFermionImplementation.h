@@ -426,8 +426,7 @@ void ImprovedStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st
   DhopFaceTime    += usecond();
 
   DhopCommTime -=usecond();
-  std::vector<std::vector<CommsRequest_t> > requests;
-  st.CommunicateBegin(requests);
+  st.CommunicateBegin();
 
   DhopFaceTime-=usecond();
   st.CommsMergeSHM(compressor);
@@ -444,7 +443,7 @@ void ImprovedStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st
   }
   DhopComputeTime    += usecond();
 
-  st.CommunicateComplete(requests);
+  st.CommunicateComplete();
   DhopCommTime +=usecond();
 
   // First to enter, last to leave timing
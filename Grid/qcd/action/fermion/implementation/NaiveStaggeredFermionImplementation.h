@@ -353,8 +353,7 @@ void NaiveStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, L
   DhopFaceTime    += usecond();
 
   DhopCommTime -=usecond();
-  std::vector<std::vector<CommsRequest_t> > requests;
-  st.CommunicateBegin(requests);
+  st.CommunicateBegin();
 
   DhopFaceTime-=usecond();
   st.CommsMergeSHM(compressor);
@@ -371,7 +370,7 @@ void NaiveStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, L
   }
   DhopComputeTime    += usecond();
 
-  st.CommunicateComplete(requests);
+  st.CommunicateComplete();
   DhopCommTime +=usecond();
 
   // First to enter, last to leave timing
@@ -79,49 +79,33 @@ void WilsonCloverFermion<Impl>::ImportGauge(const GaugeField &_Umu)
   WilsonLoops<Impl>::FieldStrength(Ey, _Umu, Tdir, Ydir);
   WilsonLoops<Impl>::FieldStrength(Ez, _Umu, Tdir, Zdir);
 
-  // Compute the Clover Operator acting on Colour and Spin
-  // multiply here by the clover coefficients for the anisotropy
-  CloverTerm  = fillCloverYZ(Bx) * csw_r;
-  CloverTerm += fillCloverXZ(By) * csw_r;
-  CloverTerm += fillCloverXY(Bz) * csw_r;
-  CloverTerm += fillCloverXT(Ex) * csw_t;
-  CloverTerm += fillCloverYT(Ey) * csw_t;
-  CloverTerm += fillCloverZT(Ez) * csw_t;
-  CloverTerm += diag_mass;
-
-  int lvol = _Umu.Grid()->lSites();
-  int DimRep = Impl::Dimension;
-
+  // Build the packed chiral blocks of the clover term and invert them
+  // site by site; each SIMD lane is an independent site
   {
-    autoView(CTv,CloverTerm,CpuRead);
-    autoView(CTIv,CloverTermInv,CpuWrite);
-    thread_for(site, lvol, {
-      Coordinate lcoor;
-      grid->LocalIndexToLocalCoor(site, lcoor);
-      Eigen::MatrixXcd EigenCloverOp = Eigen::MatrixXcd::Zero(Ns * DimRep, Ns * DimRep);
-      Eigen::MatrixXcd EigenInvCloverOp = Eigen::MatrixXcd::Zero(Ns * DimRep, Ns * DimRep);
-      typename SiteCloverType::scalar_object Qx = Zero(), Qxinv = Zero();
-      peekLocalSite(Qx, CTv, lcoor);
-      //if (csw!=0){
-      for (int j = 0; j < Ns; j++)
-	for (int k = 0; k < Ns; k++)
-	  for (int a = 0; a < DimRep; a++)
-	    for (int b = 0; b < DimRep; b++){
-	      auto zz =  Qx()(j, k)(a, b);
-	      EigenCloverOp(a + j * DimRep, b + k * DimRep) = std::complex<double>(zz);
-	    }
-      //   if (site==0) std::cout << "site =" << site << "\n" << EigenCloverOp << std::endl;
-      
-      EigenInvCloverOp = EigenCloverOp.inverse();
-      //std::cout << EigenInvCloverOp << std::endl;
-      for (int j = 0; j < Ns; j++)
-	for (int k = 0; k < Ns; k++)
-	  for (int a = 0; a < DimRep; a++)
-	    for (int b = 0; b < DimRep; b++)
-	      Qxinv()(j, k)(a, b) = EigenInvCloverOp(a + j * DimRep, b + k * DimRep);
-      //    if (site==0) std::cout << "site =" << site << "\n" << EigenInvCloverOp << std::endl;
-      //  }
-      pokeLocalSite(Qxinv, CTIv, lcoor);
+    RealD cr = csw_r;
+    RealD ct = csw_t;
+    RealD dm = diag_mass;
+    autoView(Bx_v, Bx, AcceleratorRead);
+    autoView(By_v, By, AcceleratorRead);
+    autoView(Bz_v, Bz, AcceleratorRead);
+    autoView(Ex_v, Ex, AcceleratorRead);
+    autoView(Ey_v, Ey, AcceleratorRead);
+    autoView(Ez_v, Ez, AcceleratorRead);
+    autoView(CT_v, CloverTerm, AcceleratorWrite);
+    autoView(CTI_v, CloverTermInv, AcceleratorWrite);
+    accelerator_for(ss, grid->oSites(), Simd::Nsimd(), {
+      auto bx = coalescedRead(Bx_v[ss]);
+      auto by = coalescedRead(By_v[ss]);
+      auto bz = coalescedRead(Bz_v[ss]);
+      auto ex = coalescedRead(Ex_v[ss]);
+      auto ey = coalescedRead(Ey_v[ss]);
+      auto ez = coalescedRead(Ez_v[ss]);
+      decltype(coalescedRead(CT_v[ss])) C;
+      CloverPacking::Build(C, bx()(), by()(), bz()(), ex()(), ey()(), ez()(), cr, ct, dm);
+      coalescedWrite(CT_v[ss], C);
+      CloverPacking::Invert(C(0));
+      CloverPacking::Invert(C(1));
+      coalescedWrite(CTI_v[ss], C);
     });
   }
 
@@ -129,14 +113,8 @@ void WilsonCloverFermion<Impl>::ImportGauge(const GaugeField &_Umu)
   pickCheckerboard(Even, CloverTermEven, CloverTerm);
   pickCheckerboard(Odd, CloverTermOdd, CloverTerm);
 
-  pickCheckerboard(Even, CloverTermDagEven, adj(CloverTerm));
-  pickCheckerboard(Odd, CloverTermDagOdd, adj(CloverTerm));
-
   pickCheckerboard(Even, CloverTermInvEven, CloverTermInv);
   pickCheckerboard(Odd, CloverTermInvOdd, CloverTermInv);
-
-  pickCheckerboard(Even, CloverTermInvDagEven, adj(CloverTermInv));
-  pickCheckerboard(Odd, CloverTermInvDagOdd, adj(CloverTermInv));
 }
 
 template <class Impl>
@@ -167,54 +145,38 @@ template <class Impl>
 void WilsonCloverFermion<Impl>::MooeeInternal(const FermionField &in, FermionField &out, int dag, int inv)
 {
   out.Checkerboard() = in.Checkerboard();
-  CloverFieldType *Clover;
+  CloverPackedFieldType *Clover;
   assert(in.Checkerboard() == Odd || in.Checkerboard() == Even);
 
-  if (dag)
+  // The clover term is Hermitian, so dag needs no separate field
+  if (in.Grid()->_isCheckerBoarded)
   {
-    if (in.Grid()->_isCheckerBoarded)
+    if (in.Checkerboard() == Odd)
     {
-      if (in.Checkerboard() == Odd)
-      {
-        Clover = (inv) ? &CloverTermInvDagOdd : &CloverTermDagOdd;
-      }
-      else
-      {
-        Clover = (inv) ? &CloverTermInvDagEven : &CloverTermDagEven;
-      }
-      out = *Clover * in;
+      Clover = (inv) ? &CloverTermInvOdd : &CloverTermOdd;
     }
     else
     {
-      Clover = (inv) ? &CloverTermInv : &CloverTerm;
-      out = adj(*Clover) * in;
+      Clover = (inv) ? &CloverTermInvEven : &CloverTermEven;
     }
   }
   else
   {
-    if (in.Grid()->_isCheckerBoarded)
-    {
-
-      if (in.Checkerboard() == Odd)
-      {
-        //  std::cout << "Calling clover term Odd" << std::endl;
-        Clover = (inv) ? &CloverTermInvOdd : &CloverTermOdd;
-      }
-      else
-      {
-        //  std::cout << "Calling clover term Even" << std::endl;
-        Clover = (inv) ? &CloverTermInvEven : &CloverTermEven;
-      }
-      out = *Clover * in;
-      //  std::cout << GridLogMessage << "*Clover.Checkerboard() "  << (*Clover).Checkerboard() << std::endl;
-    }
-    else
-    {
-      Clover = (inv) ? &CloverTermInv : &CloverTerm;
-      out = *Clover * in;
-    }
+    Clover = (inv) ? &CloverTermInv : &CloverTerm;
   }
 
+  autoView(C_v, (*Clover), AcceleratorRead);
+  autoView(in_v, in, AcceleratorRead);
+  autoView(out_v, out, AcceleratorWrite);
+  accelerator_for(ss, in.Grid()->oSites(), Simd::Nsimd(), {
+    auto C = coalescedRead(C_v[ss]);
+    auto x = coalescedRead(in_v[ss]);
+    decltype(x) y;
+    CloverPacking::Mult(y, C(0), x, 0);
+    CloverPacking::Mult(y, C(1), x, 2);
+    coalescedWrite(out_v[ss], y);
+  });
+
 } // MooeeInternal
 
 
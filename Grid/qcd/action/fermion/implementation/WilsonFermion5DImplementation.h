@@ -387,8 +387,7 @@ void WilsonFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl & st, Lebesg
   DhopFaceTime+=usecond();
 
   DhopCommTime -=usecond();
-  std::vector<std::vector<CommsRequest_t> > requests;
-  st.CommunicateBegin(requests);
+  st.CommunicateBegin();
 
   /////////////////////////////
   // Overlap with comms
@@ -396,6 +395,11 @@ void WilsonFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl & st, Lebesg
   DhopFaceTime-=usecond();
   st.CommsMergeSHM(compressor);// Could do this inside parallel region overlapped with comms
   DhopFaceTime+=usecond();
+
+  /////////////////////////////
+  // Off node completion and merge on the progress thread, if there is one
+  /////////////////////////////
+  st.CommunicateProgressBegin(compressor);
       
   /////////////////////////////
   // do the compute interior
@@ -409,19 +413,43 @@ void WilsonFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl & st, Lebesg
   }
   DhopComputeTime+=usecond();
 
+  /////////////////////////////
+  // Complete comms and compute the exterior a point at a time
+  /////////////////////////////
+  if ( WilsonKernelsStatic::Exterior == WilsonKernelsStatic::ExteriorByPoint ) {
+    int point;
+    while ( (point=st.CommunicateCompletePoint()) >= 0 ) {
+      DhopCommTime   +=usecond();
+      DhopFaceTime-=usecond();
+      st.CommsMergePoint(compressor,point);
+      DhopFaceTime+=usecond();
+      DhopComputeTime2-=usecond();
+      Kernels::DhopPointExtKernel(st,U,st.CommBuf(),LLs,in,out,point,dag);
+      DhopComputeTime2+=usecond();
+      DhopCommTime   -=usecond();
+    }
+    DhopCommTime   +=usecond();
+    return;
+  }
+
   /////////////////////////////
   // Complete comms
   /////////////////////////////
-  st.CommunicateComplete(requests);
-  DhopCommTime   +=usecond();
+  if ( GridThread::ProgressThreadRunning() ) {
+    st.CommunicateProgressComplete(compressor);
+    DhopCommTime   +=usecond();
+  } else {
+    st.CommunicateComplete();
+    DhopCommTime   +=usecond();
+
+    DhopFaceTime-=usecond();
+    st.CommsMerge(compressor);
+    DhopFaceTime+=usecond();
+  }
 
   /////////////////////////////
   // do the compute exterior
   /////////////////////////////
-  DhopFaceTime-=usecond();
-  st.CommsMerge(compressor);
-  DhopFaceTime+=usecond();
-
   DhopComputeTime2-=usecond();
   if (dag == DaggerYes) {
     Kernels::DhopDagKernel(Opt,st,U,st.CommBuf(),LLs,U.oSites(),in,out,0,1);
@@ -511,14 +511,13 @@ void WilsonFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, LebesgueO
   /////////////////////////////
   // Start comms  // Gather intranode and extra node differentiated??
   /////////////////////////////
-  std::vector<std::vector<CommsRequest_t> > requests;
   st.Prepare();
   DhopFaceTime-=usecond();
   st.HaloGather(in,compressor);
   DhopFaceTime+=usecond();
 
   DhopCommTime -=usecond();
-  st.CommunicateBegin(requests);
+  st.CommunicateBegin();
 
   /////////////////////////////
   // Overlap with comms
@@ -527,6 +526,11 @@ void WilsonFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, LebesgueO
   st.CommsMergeSHM(compressor);
   DhopFaceTime+=usecond();
 
+  /////////////////////////////
+  // Off node completion and merge on the progress thread, if there is one
+  /////////////////////////////
+  st.CommunicateProgressBegin(compressor);
+
   /////////////////////////////
   // do the compute interior
   /////////////////////////////
@@ -539,15 +543,39 @@ void WilsonFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, LebesgueO
   }
   DhopComputeTime+=usecond();
 
+  /////////////////////////////
+  // Complete comms and compute the exterior a point at a time
+  /////////////////////////////
+  if ( WilsonKernelsStatic::Exterior == WilsonKernelsStatic::ExteriorByPoint ) {
+    int point;
+    while ( (point=st.CommunicateCompletePoint()) >= 0 ) {
+      DhopCommTime   +=usecond();
+      DhopFaceTime-=usecond();
+      st.CommsMergePoint(compressor,point);
+      DhopFaceTime+=usecond();
+      DhopComputeTime2-=usecond();
+      Kernels::DhopPointExtKernel(st,U,st.CommBuf(),1,in,out,point,dag);
+      DhopComputeTime2+=usecond();
+      DhopCommTime   -=usecond();
+    }
+    DhopCommTime   +=usecond();
+    return;
+  }
+
   /////////////////////////////
   // Complete comms
   /////////////////////////////
-  st.CommunicateComplete(requests);
-  DhopCommTime   +=usecond();
+  if ( GridThread::ProgressThreadRunning() ) {
+    st.CommunicateProgressComplete(compressor);
+    DhopCommTime   +=usecond();
+  } else {
+    st.CommunicateComplete();
+    DhopCommTime   +=usecond();
 
-  DhopFaceTime-=usecond();
-  st.CommsMerge(compressor);
-  DhopFaceTime+=usecond();
+    DhopFaceTime-=usecond();
+    st.CommsMerge(compressor);
+    DhopFaceTime+=usecond();
+  }
 
   /////////////////////////////
   // do the compute exterior
@@ -118,6 +118,39 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 
 #endif
 
+#ifdef WILSON_COMPRESSED_LINKS
+// Link rebuilt in registers from compressed storage; the boundary phase
+// cannot live in the stored rows and is applied on the wrapping legs
+#define MULT_2SPIN(A)\
+  {auto UU = Impl::loadLink(U[sU],A);			\
+    UChi_00 = UU()(0,0)*Chi_00;				\
+    UChi_10 = UU()(0,0)*Chi_10;				\
+    UChi_01 = UU()(1,0)*Chi_00;				\
+    UChi_11 = UU()(1,0)*Chi_10;				\
+    UChi_02 = UU()(2,0)*Chi_00;				\
+    UChi_12 = UU()(2,0)*Chi_10;				\
+    UChi_00+= UU()(0,1)*Chi_01;				\
+    UChi_10+= UU()(0,1)*Chi_11;				\
+    UChi_01+= UU()(1,1)*Chi_01;				\
+    UChi_11+= UU()(1,1)*Chi_11;				\
+    UChi_02+= UU()(2,1)*Chi_01;				\
+    UChi_12+= UU()(2,1)*Chi_11;				\
+    UChi_00+= UU()(0,2)*Chi_02;				\
+    UChi_10+= UU()(0,2)*Chi_12;				\
+    UChi_01+= UU()(1,2)*Chi_02;				\
+    UChi_11+= UU()(1,2)*Chi_12;				\
+    UChi_02+= UU()(2,2)*Chi_02;				\
+    UChi_12+= UU()(2,2)*Chi_12;				\
+    if ( SE->_around_the_world && Impl::hasBoundaryPhase(A,st) ) {	\
+      auto ph = Impl::boundaryPhase(A,st);		\
+      UChi_00 = ph*UChi_00;				\
+      UChi_10 = ph*UChi_10;				\
+      UChi_01 = ph*UChi_01;				\
+      UChi_11 = ph*UChi_11;				\
+      UChi_02 = ph*UChi_02;				\
+      UChi_12 = ph*UChi_12;				\
+    }}
+#else
 #define MULT_2SPIN(A)\
   {auto & ref(U[sU](A));					\
   U_00=coalescedRead(ref()(0,0));				\
@@ -147,6 +180,7 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
     UChi_11+= U_10*Chi_12;					\
     UChi_02+= U_20*Chi_02;					\
     UChi_12+= U_20*Chi_12;}
+#endif
 
 #define LOAD_CHI				\
   {const SiteHalfSpinor &ref(buf[offset]);	\
@@ -546,7 +580,7 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 NAMESPACE_BEGIN(Grid);
 
 
-#ifdef SYCL_HACK
+#if defined(SYCL_HACK) && !defined(WILSON_COMPRESSED_LINKS)
 template<class Impl> accelerator_inline void 
 WilsonKernels<Impl>::HandDhopSiteSycl(StencilVector st_perm,StencilEntry *st_p, SiteDoubledGaugeField *U,SiteHalfSpinor  *buf,
 				      int ss,int sU,const SiteSpinor *in, SiteSpinor *out)
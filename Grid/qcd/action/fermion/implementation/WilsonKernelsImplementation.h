@@ -289,6 +289,54 @@ void WilsonKernels<Impl>::GenericDhopSiteExt(StencilView &st,  DoubledGaugeField
   }
 };
 
+////////////////////////////////////////////////////////////////////
+// Exterior contribution of a single point. Dhop reconstructs point mu
+// with the projector of the opposite direction, Dhop^dag with its own.
+////////////////////////////////////////////////////////////////////
+#define GENERIC_POINT_LEG_EXT(Dir,ReconDhop,ReconDag)		\
+  case Dir :							\
+    if ( dag ) {						\
+      GENERIC_STENCIL_LEG_EXT(Dir,spProjXp,ReconDag);		\
+    } else {							\
+      GENERIC_STENCIL_LEG_EXT(Dir,spProjXp,ReconDhop);		\
+    }								\
+    break;
+
+template <class Impl> accelerator_inline
+void WilsonKernels<Impl>::GenericDhopSitePointExt(StencilView &st,  DoubledGaugeFieldView &U,
+						  SiteHalfSpinor *buf, int sF,
+						  int sU, const FermionFieldView &in, FermionFieldView &out,
+						  int point, int dag)
+{
+  typedef decltype(coalescedRead(buf[0])) calcHalfSpinor;
+  typedef decltype(coalescedRead(in[0]))  calcSpinor;
+  calcHalfSpinor Uchi;
+  calcSpinor result;
+  StencilEntry *SE;
+  int ptype;
+  int nmu=0;
+  const int Nsimd = SiteHalfSpinor::Nsimd();
+  const int lane=acceleratorSIMTlane(Nsimd);
+  result=Zero();
+  switch(point){
+    GENERIC_POINT_LEG_EXT(Xp,accumReconXm,accumReconXp);
+    GENERIC_POINT_LEG_EXT(Yp,accumReconYm,accumReconYp);
+    GENERIC_POINT_LEG_EXT(Zp,accumReconZm,accumReconZp);
+    GENERIC_POINT_LEG_EXT(Tp,accumReconTm,accumReconTp);
+    GENERIC_POINT_LEG_EXT(Xm,accumReconXp,accumReconXm);
+    GENERIC_POINT_LEG_EXT(Ym,accumReconYp,accumReconYm);
+    GENERIC_POINT_LEG_EXT(Zm,accumReconZp,accumReconZm);
+    GENERIC_POINT_LEG_EXT(Tm,accumReconTp,accumReconTm);
+  default: break;
+  }
+  if ( nmu ) {
+    auto out_t = coalescedRead(out[sF],lane);
+    out_t = out_t + result;
+    coalescedWrite(out[sF],out_t,lane);
+  }
+};
+#undef GENERIC_POINT_LEG_EXT
+
 #define DhopDirMacro(Dir,spProj,spRecon)	\
   template <class Impl> accelerator_inline				\
   void WilsonKernels<Impl>::DhopDir##Dir(StencilView &st, DoubledGaugeFieldView &U,SiteHalfSpinor *buf, int sF, \
@@ -416,6 +464,29 @@ void WilsonKernels<Impl>::DhopDirKernel( StencilImpl &st, DoubledGaugeField &U,S
 #undef LoopBody
 }
 
+////////////////////////////////////////////////////////////////////
+// One launch per point; a site on several faces is updated by
+// successive launches, never concurrently.
+////////////////////////////////////////////////////////////////////
+template <class Impl>
+void WilsonKernels<Impl>::DhopPointExtKernel(StencilImpl &st, DoubledGaugeField &U,SiteHalfSpinor *buf,
+					     int Ls, const FermionField &in, FermionField &out, int point, int dag)
+{
+  uint64_t Nsite = st.surface_list_point[point].size();
+  if ( Nsite==0 ) return;
+
+  autoView(U_v  ,U  ,AcceleratorRead);
+  autoView(in_v ,in ,AcceleratorRead);
+  autoView(out_v,out,AcceleratorWrite);
+  autoView(st_v ,st ,AcceleratorRead);
+  auto sites = &st.surface_list_point[point][0];
+  accelerator_for(ss,Nsite*Ls,Simd::Nsimd(),{
+    int sU = sites[ss/Ls];
+    int sF = ss%Ls + Ls*sU;
+    WilsonKernels<Impl>::GenericDhopSitePointExt(st_v,U_v,buf,sF,sU,in_v,out_v,point,dag);
+  });
+}
+
 #define KERNEL_CALL_TMP(A) \
   const uint64_t    NN = Nsite*Ls;					\
   auto U_p = & U_v[0];							\
@@ -459,7 +530,7 @@ void WilsonKernels<Impl>::DhopKernel(int Opt,StencilImpl &st,  DoubledGaugeField
 
    if( interior && exterior ) {
      if (Opt == WilsonKernelsStatic::OptGeneric    ) { KERNEL_CALL(GenericDhopSite); return;}
-#ifdef SYCL_HACK     
+#if defined(SYCL_HACK) && !defined(WILSON_COMPRESSED_LINKS)
      if (Opt == WilsonKernelsStatic::OptHandUnroll ) { KERNEL_CALL_TMP(HandDhopSiteSycl);    return; }
 #else
      if (Opt == WilsonKernelsStatic::OptHandUnroll ) { KERNEL_CALL(HandDhopSite);    return;}
@@ -514,6 +585,35 @@ void WilsonKernels<Impl>::DhopKernel(int Opt,StencilImpl &st,  DoubledGaugeField
    assert(0 && " Kernel optimisation case not covered ");
   }
 
+template <class Impl>
+void WilsonKernels<Impl>::DhopKernelCayleySchur(int Opt,StencilImpl &st, DoubledGaugeField &U,SiteHalfSpinor * buf,
+						int Ls, int Nsite, const FermionField &in, FermionField &out,
+						const CayleySchurEpilogue<Impl> &epilogue)
+{
+  autoView(U_v  ,  U,AcceleratorRead);
+  autoView(in_v , in,AcceleratorRead);
+  autoView(out_v,out,AcceleratorWrite);
+  autoView(st_v , st,AcceleratorRead);
+
+  // The assembly kernels fall back to the hand unrolled ones here
+  CayleySchurEpilogue<Impl> epi = epilogue;
+  int dag  = epilogue.dag;
+  int hand = (Opt != WilsonKernelsStatic::OptGeneric);
+  accelerator_for(sU, Nsite, Simd::Nsimd(), {
+    uint64_t sF = sU*Ls;
+    for(int s=0;s<Ls;s++){
+      if ( dag ) {
+	if ( hand ) WilsonKernels<Impl>::HandDhopSiteDag   (st_v,U_v,buf,sF+s,sU,in_v,out_v);
+	else        WilsonKernels<Impl>::GenericDhopSiteDag(st_v,U_v,buf,sF+s,sU,in_v,out_v);
+      } else {
+	if ( hand ) WilsonKernels<Impl>::HandDhopSite      (st_v,U_v,buf,sF+s,sU,in_v,out_v);
+	else        WilsonKernels<Impl>::GenericDhopSite   (st_v,U_v,buf,sF+s,sU,in_v,out_v);
+      }
+    }
+    epi(out_v,sF);
+  });
+}
+
 #undef KERNEL_CALLNB
 #undef KERNEL_CALL
 #undef ASM_CALL
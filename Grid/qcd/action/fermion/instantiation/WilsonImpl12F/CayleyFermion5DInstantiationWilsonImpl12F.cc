@@ -0,0 +1 @@
+../CayleyFermion5DInstantiation.cc.master
\ No newline at end of file
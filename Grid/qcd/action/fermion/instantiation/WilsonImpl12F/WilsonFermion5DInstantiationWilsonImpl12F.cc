@@ -0,0 +1 @@
+../WilsonFermion5DInstantiation.cc.master
\ No newline at end of file
@@ -0,0 +1 @@
+#define IMPLEMENTATION WilsonImpl12F
@@ -0,0 +1 @@
+../WilsonKernelsInstantiationCompressed.cc.master
\ No newline at end of file
@@ -38,8 +38,14 @@ GDWF_IMPL_LIST=" \
 	   GparityWilsonImplFH \
 	   GparityWilsonImplDF"
 
+COMPRESSED_IMPL_LIST=" \
+	   WilsonImpl12F \
+	   WilsonImpl12D \
+	   WilsonImpl8F \
+	   WilsonImpl8D "
 
-IMPL_LIST="$STAG_IMPL_LIST  $WILSON_IMPL_LIST $DWF_IMPL_LIST $GDWF_IMPL_LIST"
+
+IMPL_LIST="$STAG_IMPL_LIST  $WILSON_IMPL_LIST $DWF_IMPL_LIST $GDWF_IMPL_LIST $COMPRESSED_IMPL_LIST"
 
 for impl in $IMPL_LIST
 do
@@ -84,6 +90,21 @@ do
   ln -f -s ../WilsonKernelsInstantiationGparity.cc.master $impl/WilsonKernelsInstantiation$impl.cc 
 done
 
+# compressed links: Wilson, DWF and Mobius only, with their own kernels
+CC_LIST=" \
+  CayleyFermion5DInstantiation \
+  WilsonFermionInstantiation \
+  WilsonFermion5DInstantiation "
+
+for impl in $COMPRESSED_IMPL_LIST
+do
+for f in $CC_LIST
+do
+  ln -f -s ../$f.cc.master $impl/$f$impl.cc 
+done
+  ln -f -s ../WilsonKernelsInstantiationCompressed.cc.master $impl/WilsonKernelsInstantiation$impl.cc 
+done
+
 
 CC_LIST=" \
   ImprovedStaggeredFermion5DInstantiation \
@@ -43,6 +43,7 @@ public:
 private:
   RealD c_plaq;
   RealD c_rect;
+  std::shared_ptr<GaugeStaples<Gimpl> > Staples;
 
 public:
   PlaqPlusRectangleAction(RealD b,RealD c): c_plaq(b),c_rect(c){};
@@ -78,6 +79,35 @@ public:
 
     GridBase *grid = Umu.Grid();
 
+    if ( GaugeStaples<Gimpl>::Usable(grid,2) ) {
+      // Plaquette and rectangle staples from a single depth two halo exchange
+      GridCartesian *fgrid = dynamic_cast<GridCartesian *>(grid);
+      if ( !Staples || (Staples->Grid()!=fgrid) ) {
+	Staples = std::make_shared<GaugeStaples<Gimpl> >(fgrid,2);
+      }
+      GaugeField staple(grid);
+      GaugeField rect(grid);
+      Staples->ImportGauge(Umu);
+      Staples->Staple(staple);
+      Staples->RectStaple(rect);
+
+      dSdU.Checkerboard() = Umu.Checkerboard();
+      autoView( U_v    , Umu   , AcceleratorRead);
+      autoView( st_v   , staple, AcceleratorRead);
+      autoView( rt_v   , rect  , AcceleratorRead);
+      autoView( dSdU_v , dSdU  , AcceleratorWrite);
+      accelerator_for(ss,grid->oSites(),GaugeField::vector_object::Nsimd(),{
+	for(int mu=0;mu<Nd;mu++){
+	  auto U_mu = coalescedRead(U_v[ss](mu));
+	  auto stp  = coalescedRead(st_v[ss](mu));
+	  auto rct  = coalescedRead(rt_v[ss](mu));
+	  coalescedWrite(dSdU_v[ss](mu),Ta(U_mu*stp)*factor_p + Ta(U_mu*rct)*factor_r);
+	}
+      });
+      Staples->ReleaseGauge();
+      return;
+    }
+
     std::vector<GaugeLinkField> U (Nd,grid);
     std::vector<GaugeLinkField> U2(Nd,grid);
 
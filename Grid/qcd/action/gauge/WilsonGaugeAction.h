@@ -69,6 +69,31 @@ public:
 
     RealD factor = 0.5 * beta / RealD(Nc);
 
+    if ( GaugeStaples<Gimpl>::Usable(U.Grid(),1) ) {
+      // All staples from a single halo exchange
+      GridCartesian *grid = dynamic_cast<GridCartesian *>(U.Grid());
+      if ( !Staples || (Staples->Grid()!=grid) ) {
+	Staples = std::make_shared<GaugeStaples<Gimpl> >(grid,1);
+      }
+      GaugeField staple(grid);
+      Staples->ImportGauge(U);
+      Staples->Staple(staple);
+
+      dSdU.Checkerboard() = U.Checkerboard();
+      autoView( U_v    , U     , AcceleratorRead);
+      autoView( st_v   , staple, AcceleratorRead);
+      autoView( dSdU_v , dSdU  , AcceleratorWrite);
+      accelerator_for(ss,grid->oSites(),GaugeField::vector_object::Nsimd(),{
+	for(int mu=0;mu<Nd;mu++){
+	  auto Umu = coalescedRead(U_v[ss](mu));
+	  auto stp = coalescedRead(st_v[ss](mu));
+	  coalescedWrite(dSdU_v[ss](mu),Ta(Umu*stp)*factor);
+	}
+      });
+      Staples->ReleaseGauge();
+      return;
+    }
+
     GaugeLinkField Umu(U.Grid());
     GaugeLinkField dSdU_mu(U.Grid());
     for (int mu = 0; mu < Nd; mu++) {
@@ -84,6 +109,7 @@ public:
   }
 private:
   RealD beta;  
+  std::shared_ptr<GaugeStaples<Gimpl> > Staples;
  };
 
 NAMESPACE_END(Grid);
@@ -65,6 +65,9 @@ NAMESPACE_BEGIN(Grid);
       FermionField Phi; // the pseudofermion field for this trajectory
 
     public:
+      // Guesses for the LH and RH force solves; off by default
+      ChronoSolutionHistory<FermionField> DerivativeHistoryL;
+      ChronoSolutionHistory<FermionField> DerivativeHistoryR;
 
       ExactOneFlavourRatioPseudoFermionAction(AbstractEOFAFermion<Impl>& _Lop, 
 					      AbstractEOFAFermion<Impl>& _Rop,
@@ -110,6 +113,12 @@ NAMESPACE_BEGIN(Grid);
         return sstream.str();
       }
 
+      virtual void reset_history(void)
+      {
+        DerivativeHistoryL.Reset();
+        DerivativeHistoryR.Reset();
+      }
+
       // Spin projection
       void spProj(const FermionField& in, FermionField& out, int sign, int Ls)
       {
@@ -284,6 +293,16 @@ NAMESPACE_BEGIN(Grid);
         return action;
       };
 
+      // Guess for Op x = src; the forecast works on the normal equations
+      void ForecastGuess(ChronoSolutionHistory<FermionField> &History, AbstractEOFAFermion<Impl> &Op,
+                         const FermionField &src, FermionField &guess)
+      {
+        if(History.Solutions.size() == 0){ guess = Zero(); return; }
+        FermionField Forecast_src(Op.FermionGrid());
+        Op.Mdag(src, Forecast_src);
+        History.Guess(Op, Forecast_src, guess);
+      }
+
       // EOFA pseudofermion force: see Eqns. (34)-(36) of arXiv:1706.05843
       virtual void deriv(const GaugeField& U, GaugeField& dSdU)
       {
@@ -308,8 +327,9 @@ NAMESPACE_BEGIN(Grid);
         spProj(Phi, spProj_Phi, -1, Lop.Ls);
         Lop.Omega(spProj_Phi, Omega_spProj_Phi, -1, 0);
         G5R5(CG_src, Omega_spProj_Phi);
-        spProj_Phi = Zero();
+        ForecastGuess(DerivativeHistoryL, Lop, CG_src, spProj_Phi);
         DerivativeSolverL(Lop, CG_src, spProj_Phi);
+        DerivativeHistoryL.Push(spProj_Phi);
         Lop.Dtilde(spProj_Phi, Chi);
         G5R5(g5_R5_Chi, Chi);
         Lop.MDeriv(force, g5_R5_Chi, Chi, DaggerNo);
@@ -320,8 +340,9 @@ NAMESPACE_BEGIN(Grid);
         spProj(Phi, spProj_Phi, 1, Rop.Ls);
         Rop.Omega(spProj_Phi, Omega_spProj_Phi, 1, 0);
         G5R5(CG_src, Omega_spProj_Phi);
-        spProj_Phi = Zero();
+        ForecastGuess(DerivativeHistoryR, Rop, CG_src, spProj_Phi);
         DerivativeSolverR(Rop, CG_src, spProj_Phi);
+        DerivativeHistoryR.Push(spProj_Phi);
         Rop.Dtilde(spProj_Phi, Chi);
         G5R5(g5_R5_Chi, Chi);
         Lop.MDeriv(force, g5_R5_Chi, Chi, DaggerNo);
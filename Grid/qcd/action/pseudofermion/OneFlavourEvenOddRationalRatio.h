@@ -53,13 +53,33 @@ NAMESPACE_BEGIN(Grid);
       MultiShiftFunction PowerQuarter;
       MultiShiftFunction PowerNegQuarter;
 
-    private:
+    protected:
      
       FermionOperator<Impl> & NumOp;// the basic operator
       FermionOperator<Impl> & DenOp;// the basic operator
       FermionField PhiEven; // the pseudo fermion field for this trajectory
       FermionField PhiOdd; // the pseudo fermion field for this trajectory
 
+      ///////////////////////////////////////////////////////////////
+      // Solver hooks; the mixed precision variant overrides these
+      ///////////////////////////////////////////////////////////////
+      virtual void ImportGauge(const GaugeField &U) {
+	NumOp.ImportGauge(U);
+	DenOp.ImportGauge(U);
+      }
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx,
+				     const FermionField &in, FermionField &out) {
+	SchurDifferentiableOperator<Impl> schurOp(numerator ? NumOp : DenOp);
+	ConjugateGradientMultiShift<FermionField> msCG(param.MaxIter,approx);
+	msCG(schurOp,in,out);
+      }
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx,
+				     const FermionField &in, std::vector<FermionField> &out_k, FermionField &out) {
+	SchurDifferentiableOperator<Impl> schurOp(numerator ? NumOp : DenOp);
+	ConjugateGradientMultiShift<FermionField> msCG(param.MaxIter,approx);
+	msCG(schurOp,in,out_k,out);
+      }
+
     public:
 
       OneFlavourEvenOddRatioRationalPseudoFermionAction(FermionOperator<Impl>  &_NumOp, 
@@ -128,19 +148,13 @@ NAMESPACE_BEGIN(Grid);
 	pickCheckerboard(Even,etaEven,eta);
 	pickCheckerboard(Odd,etaOdd,eta);
 
-	NumOp.ImportGauge(U);
-	DenOp.ImportGauge(U);
-
+	ImportGauge(U);
 
 	// MdagM^1/4 eta
-	SchurDifferentiableOperator<Impl> MdagM(DenOp);
-	ConjugateGradientMultiShift<FermionField> msCG_M(param.MaxIter,PowerQuarter);
-	msCG_M(MdagM,etaOdd,tmp);
+	multiShiftInverse(false,PowerQuarter,etaOdd,tmp);
 
 	// VdagV^-1/4 MdagM^1/4 eta
-	SchurDifferentiableOperator<Impl> VdagV(NumOp);
-	ConjugateGradientMultiShift<FermionField> msCG_V(param.MaxIter,PowerNegQuarter);
-	msCG_V(VdagV,tmp,PhiOdd);
+	multiShiftInverse(true,PowerNegQuarter,tmp,PhiOdd);
 
 	assert(NumOp.ConstEE() == 1);
 	assert(DenOp.ConstEE() == 1);
@@ -153,21 +167,17 @@ NAMESPACE_BEGIN(Grid);
       //////////////////////////////////////////////////////
       virtual RealD S(const GaugeField &U) {
 
-	NumOp.ImportGauge(U);
-	DenOp.ImportGauge(U);
+	ImportGauge(U);
 
 	FermionField X(NumOp.FermionRedBlackGrid());
 	FermionField Y(NumOp.FermionRedBlackGrid());
 
 	// VdagV^1/4 Phi
-	SchurDifferentiableOperator<Impl> VdagV(NumOp);
-	ConjugateGradientMultiShift<FermionField> msCG_V(param.MaxIter,PowerQuarter);
-	msCG_V(VdagV,PhiOdd,X);
+	multiShiftInverse(true,PowerQuarter,PhiOdd,X);
 
 	// MdagM^-1/4 VdagV^1/4 Phi
 	SchurDifferentiableOperator<Impl> MdagM(DenOp);
-	ConjugateGradientMultiShift<FermionField> msCG_M(param.MaxIter,PowerNegQuarter);
-	msCG_M(MdagM,X,Y);
+	multiShiftInverse(false,PowerNegQuarter,X,Y);
 
 	// Randomly apply rational bounds checks.
 	auto grid = NumOp.FermionGrid();
@@ -232,18 +242,14 @@ NAMESPACE_BEGIN(Grid);
 
 	GaugeField   tmp(NumOp.GaugeGrid());
 
-	NumOp.ImportGauge(U);
-	DenOp.ImportGauge(U);
+	ImportGauge(U);
 
 	SchurDifferentiableOperator<Impl> VdagV(NumOp);
 	SchurDifferentiableOperator<Impl> MdagM(DenOp);
 
-	ConjugateGradientMultiShift<FermionField> msCG_V(param.MaxIter,PowerQuarter);
-	ConjugateGradientMultiShift<FermionField> msCG_M(param.MaxIter,PowerNegHalf);
-
-	msCG_V(VdagV,PhiOdd,MpvPhi_k,MpvPhi);
-	msCG_M(MdagM,MpvPhi,MfMpvPhi_k,MfMpvPhi);
-	msCG_V(VdagV,MfMpvPhi,MpvMfMpvPhi_k,MpvMfMpvPhi);
+	multiShiftInverse(true ,PowerQuarter,PhiOdd,MpvPhi_k,MpvPhi);
+	multiShiftInverse(false,PowerNegHalf,MpvPhi,MfMpvPhi_k,MfMpvPhi);
+	multiShiftInverse(true ,PowerQuarter,MfMpvPhi,MpvMfMpvPhi_k,MpvMfMpvPhi);
 
 	RealD ak;
 
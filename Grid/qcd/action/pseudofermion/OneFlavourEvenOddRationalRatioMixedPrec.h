@@ -0,0 +1,102 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/action/pseudofermion/OneFlavourEvenOddRationalRatioMixedPrec.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#ifndef QCD_PSEUDOFERMION_ONE_FLAVOUR_EVEN_ODD_RATIONAL_RATIO_MIXED_PREC_H
+#define QCD_PSEUDOFERMION_ONE_FLAVOUR_EVEN_ODD_RATIONAL_RATIO_MIXED_PREC_H
+
+NAMESPACE_BEGIN(Grid);
+
+    ///////////////////////////////////////////////////////////////////////
+    // One flavour rational ratio with the multi-shift inversions done by
+    // ConjugateGradientMultiShiftMixedPrec. NumOpF and DenOpF are the
+    // single (or half comms) precision versions of NumOp and DenOp, on a
+    // grid with the same local volume; they are given the gauge field
+    // whenever the double precision operators are.
+    ///////////////////////////////////////////////////////////////////////
+    template<class Impl,class ImplF>
+    class OneFlavourEvenOddRatioRationalMixedPrecPseudoFermionAction
+      : public OneFlavourEvenOddRatioRationalPseudoFermionAction<Impl> {
+    public:
+
+      INHERIT_IMPL_TYPES(Impl);
+      typedef typename ImplF::FermionField FermionFieldF;
+      typedef typename ImplF::GaugeField   GaugeFieldF;
+
+      typedef OneFlavourEvenOddRatioRationalPseudoFermionAction<Impl> Base;
+      typedef typename Base::Params Params;
+
+      RealD ReliableUpdateDelta; // Passed to the mixed precision solver
+
+    private:
+
+      FermionOperator<ImplF> & NumOpF;
+      FermionOperator<ImplF> & DenOpF;
+
+    protected:
+
+      virtual void ImportGauge(const GaugeField &U) {
+	Base::ImportGauge(U);
+	GaugeFieldF Uf(NumOpF.GaugeGrid());
+	precisionChange(Uf,U);
+	NumOpF.ImportGauge(Uf);
+	DenOpF.ImportGauge(Uf);
+      }
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx,
+				     const FermionField &in, FermionField &out) {
+	SchurDifferentiableOperator<Impl>  schurOp (numerator ? this->NumOp : this->DenOp);
+	SchurDifferentiableOperator<ImplF> schurOpF(numerator ? NumOpF : DenOpF);
+	ConjugateGradientMultiShiftMixedPrec<FermionField,FermionFieldF>
+	  msCG(this->param.MaxIter,approx,NumOpF.FermionRedBlackGrid(),schurOpF,ReliableUpdateDelta);
+	msCG(schurOp,in,out);
+      }
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx,
+				     const FermionField &in, std::vector<FermionField> &out_k, FermionField &out) {
+	SchurDifferentiableOperator<Impl>  schurOp (numerator ? this->NumOp : this->DenOp);
+	SchurDifferentiableOperator<ImplF> schurOpF(numerator ? NumOpF : DenOpF);
+	ConjugateGradientMultiShiftMixedPrec<FermionField,FermionFieldF>
+	  msCG(this->param.MaxIter,approx,NumOpF.FermionRedBlackGrid(),schurOpF,ReliableUpdateDelta);
+	msCG(schurOp,in,out_k,out);
+      }
+
+    public:
+
+      OneFlavourEvenOddRatioRationalMixedPrecPseudoFermionAction(FermionOperator<Impl>  &_NumOp,
+								 FermionOperator<Impl>  &_DenOp,
+								 FermionOperator<ImplF> &_NumOpF,
+								 FermionOperator<ImplF> &_DenOpF,
+								 Params & p,
+								 RealD _delta = 0.1) :
+	Base(_NumOp,_DenOp,p),
+	ReliableUpdateDelta(_delta),
+	NumOpF(_NumOpF),
+	DenOpF(_DenOpF)
+      {};
+
+      virtual std::string action_name(){return "OneFlavourEvenOddRatioRationalMixedPrecPseudoFermionAction";}
+    };
+
+NAMESPACE_END(Grid);
+
+#endif
@@ -52,6 +52,8 @@ private:
   FermionField PhiEven;  // the pseudo fermion field for this trajectory
 
 public:
+  ChronoSolutionHistory<FermionField> DerivativeHistory; // Guesses for the force solve; off by default
+
   /////////////////////////////////////////////////
   // Pass in required objects.
   /////////////////////////////////////////////////
@@ -73,6 +75,8 @@ public:
     return sstream.str();
   }  
 
+  virtual void reset_history(void) { DerivativeHistory.Reset(); }
+
 
   //////////////////////////////////////////////////////////////////////////////////////
   // Push the gauge field in to the dops. Assume any BC's and smearing already applied
@@ -155,8 +159,9 @@ public:
     // Our conventions really make this UdSdU; We do not differentiate wrt Udag here.
     // So must take dSdU - adj(dSdU) and left multiply by mom to get dS/dt.
 
-    X=Zero();
+    DerivativeHistory.Guess(Mpc,PhiOdd,X);
     DerivativeSolver(Mpc,PhiOdd,X);
+    DerivativeHistory.Push(X);
     Mpc.Mpc(X,Y);
     Mpc.MpcDeriv(tmp , Y, X );    dSdU=tmp;
     Mpc.MpcDagDeriv(tmp , X, Y);  dSdU=dSdU+tmp;
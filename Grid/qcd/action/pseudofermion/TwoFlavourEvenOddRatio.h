@@ -51,6 +51,8 @@ NAMESPACE_BEGIN(Grid);
       FermionField PhiEven;  // the pseudo fermion field for this trajectory
 
     public:
+      ChronoSolutionHistory<FermionField> DerivativeHistory; // Guesses for the force solve; off by default
+
       TwoFlavourEvenOddRatioPseudoFermionAction(FermionOperator<Impl>  &_NumOp, 
                                                 FermionOperator<Impl>  &_DenOp, 
                                                 OperatorFunction<FermionField> & DS,
@@ -83,6 +85,8 @@ NAMESPACE_BEGIN(Grid);
 	return sstream.str();
       } 
 
+      virtual void reset_history(void) { DerivativeHistory.Reset(); }
+
       
       virtual void refresh(const GaugeField &U, GridSerialRNG &sRNG, GridParallelRNG& pRNG) {
 
@@ -187,8 +191,9 @@ NAMESPACE_BEGIN(Grid);
         //X = (Mdag M)^-1 V^dag phi
         //Y = (Mdag)^-1 V^dag  phi
         Vpc.MpcDag(PhiOdd,Y);          // Y= Vdag phi
-        X=Zero();
+        DerivativeHistory.Guess(Mpc,Y,X);
         DerivativeSolver(Mpc,Y,X);     // X= (MdagM)^-1 Vdag phi
+        DerivativeHistory.Push(X);
         Mpc.Mpc(X,Y);                  // Y=  Mdag^-1 Vdag phi
 
         // phi^dag V (Mdag M)^-1 dV^dag  phi
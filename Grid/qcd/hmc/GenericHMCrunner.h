@@ -177,6 +177,9 @@ private:
 
     // Run it
     HMC.evolve();
+
+    // Asynchronous checkpoints must land before the job exits
+    Resources.GetCheckPointer()->Fence();
   }
 };
 
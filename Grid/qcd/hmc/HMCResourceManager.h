@@ -266,6 +266,7 @@ public:
   }
 
   RegisterLoadCheckPointerFunction(Binary);
+  RegisterLoadCheckPointerFunction(BinaryAsync);
   RegisterLoadCheckPointerFunction(Nersc);
 #ifdef HAVE_LIME
   RegisterLoadCheckPointerFunction(ILDG);
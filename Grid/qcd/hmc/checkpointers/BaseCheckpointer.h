@@ -84,6 +84,9 @@ public:
   }
   virtual void initialize(const CheckpointerParameters &Params) = 0;
 
+  // Wait for any background writes; collective
+  virtual void Fence(void) {};
+
   virtual void CheckpointRestore(int traj, typename Impl::Field &U,
                                  GridSerialRNG &sRNG,
                                  GridParallelRNG &pRNG) = 0;
@@ -36,10 +36,17 @@ directory
 NAMESPACE_BEGIN(Grid);
 
 // Simple checkpointer, only binary file
+//
+// In asynchronous mode TrajectoryComplete only snapshots the RNG and field
+// into host memory; checksums and writes happen on a background thread and
+// the files appear under their final names at the next Fence (the next
+// save, a restore, or the end of the run).
 template <class Impl>
 class BinaryHmcCheckpointer : public BaseHmcCheckpointer<Impl> {
 private:
   CheckpointerParameters Params;
+  bool asynchronous;
+  BinaryIOAsync Writer;
 
 public:
   INHERIT_FIELD_TYPES(Impl);  // Gets the Field type, a Lattice object
@@ -50,9 +57,13 @@ public:
   typedef typename getPrecision<sobj>::real_scalar_type sobj_stype;
   typedef typename sobj::DoublePrecision sobj_double;
 
-  BinaryHmcCheckpointer(const CheckpointerParameters &Params_) {
+  BinaryHmcCheckpointer(const CheckpointerParameters &Params_, bool asynchronous_ = false)
+    : asynchronous(asynchronous_) {
     initialize(Params_);
   }
+  ~BinaryHmcCheckpointer() { Fence(); }
+
+  void Fence(void) { Writer.Fence(); }
 
   void initialize(const CheckpointerParameters &Params_) { Params = Params_; }
 
@@ -67,6 +78,15 @@ public:
       std::string config, rng;
       this->build_filenames(traj, Params, config, rng);
 
+      if ( asynchronous ) {
+	BinarySimpleUnmunger<sobj_double, sobj> munge;
+	Writer.writeRNG(sRNG, pRNG, rng, 0);
+	Writer.writeLatticeObject<vobj, sobj_double>(U, config, munge, 0, Params.format);
+	Writer.Commit();
+	std::cout << GridLogMessage << "Queued Binary Configuration " << config << std::endl;
+	return;
+      }
+
       uint32_t nersc_csum;
       uint32_t scidac_csuma;
       uint32_t scidac_csumb;
@@ -90,6 +110,7 @@ public:
   };
 
   void CheckpointRestore(int traj, Field &U, GridSerialRNG &sRNG, GridParallelRNG &pRNG) {
+    Fence();
     std::string config, rng;
     this->build_filenames(traj, Params, config, rng);
     this->check_filename(rng);
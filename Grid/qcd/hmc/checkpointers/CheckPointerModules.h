@@ -100,6 +100,19 @@ class BinaryCPModule: public CheckPointerModule< ImplementationPolicy> {
 };
 
 
+template<class ImplementationPolicy>
+class BinaryAsyncCPModule: public CheckPointerModule< ImplementationPolicy> {
+  typedef CheckPointerModule< ImplementationPolicy> CPBase;
+  using CPBase::CPBase; // for constructors
+
+  // acquire resource
+  virtual void initialize(){
+    this->CheckPointPtr.reset(new BinaryHmcCheckpointer<ImplementationPolicy>(this->Par_,true));
+  }
+
+};
+
+
 template<class ImplementationPolicy>
 class NerscCPModule: public CheckPointerModule< ImplementationPolicy> {
   typedef CheckPointerModule< ImplementationPolicy> CPBase;
@@ -230,6 +230,28 @@ public:
   void reverse_momenta()
   {
     P *= -1.0;
+    reset_history();
+  }
+
+  // to be used by the actionlevel class to iterate
+  // over the representations
+  struct _reset_history {
+    template <class FieldType, class Repr>
+    void operator()(std::vector<Action<FieldType>*> repr_set, Repr& Rep) {
+      for (int a = 0; a < repr_set.size(); ++a) repr_set.at(a)->reset_history();
+    }
+  } reset_history_hireps{};
+
+  // Drop the solver guesses the actions carry from one MD step to the
+  // next; they belong to a single trajectory with fixed momenta
+  void reset_history(void)
+  {
+    for (int level = 0; level < as.size(); ++level) {
+      for (int actionID = 0; actionID < as[level].actions.size(); ++actionID) {
+        as[level].actions.at(actionID)->reset_history();
+      }
+      as[level].apply(reset_history_hireps, Representations);
+    }
   }
 
   // to be used by the actionlevel class to iterate
@@ -252,6 +274,7 @@ public:
     std::cout << GridLogIntegrator << "Integrator refresh\n";
 
     FieldImplementation::generate_momenta(P, sRNG, pRNG);
+    reset_history();
 
     // Update the smeared fields, can be implemented as observer
     // necessary to keep the fields updated even after a reject
@@ -327,6 +350,7 @@ public:
     for (int level = 0; level < as.size(); ++level) {
       t_P[level] = 0;
     }
+    reset_history();
 
     for (int stp = 0; stp < Params.MDsteps; ++stp) {  // MD step
       int first_step = (stp == 0);
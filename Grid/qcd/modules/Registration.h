@@ -112,6 +112,7 @@ static Registrar<PlaquetteMod<ImplementationPolicy>, HMC_ObservablesModuleFactor
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 static Registrar<BinaryCPModule<ImplementationPolicy>, HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPBinarymodXMLInit("Binary");
+static Registrar<BinaryAsyncCPModule<ImplementationPolicy>, HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPBinaryAsyncmodXMLInit("BinaryAsync");
 static Registrar<NerscCPModule<ImplementationPolicy> , HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPNerscmodXMLInit("Nersc");
 
 #ifdef HAVE_LIME
@@ -88,25 +88,26 @@ private:
   {
     GridBase* grid = GaugeK.Grid();
     GaugeField C(grid), SigmaK(grid), iLambda(grid);
-    GaugeLinkField iLambda_mu(grid);
-    GaugeLinkField iQ(grid), e_iQ(grid);
-    GaugeLinkField SigmaKPrime_mu(grid);
-    GaugeLinkField GaugeKmu(grid), Cmu(grid);
 
     StoutSmearing->BaseSmear(C, GaugeK);
-    SigmaK = Zero();
-    iLambda = Zero();
 
-    for (int mu = 0; mu < Nd; mu++)
-    {
-      Cmu = peekLorentz(C, mu);
-      GaugeKmu = peekLorentz(GaugeK, mu);
-      SigmaKPrime_mu = peekLorentz(SigmaKPrime, mu);
-      iQ = Ta(Cmu * adj(GaugeKmu));
-      set_iLambda(iLambda_mu, e_iQ, iQ, SigmaKPrime_mu, GaugeKmu);
-      pokeLorentz(SigmaK, SigmaKPrime_mu * e_iQ + adj(Cmu) * iLambda_mu, mu);
-      pokeLorentz(iLambda, iLambda_mu, mu);
-    }
+    // Exponential, Lambda and the Sigma recursion site by site; see
+    // set_iLambda for the definitions
+    autoView(SigmaK_v, SigmaK, AcceleratorWrite);
+    autoView(iLambda_v, iLambda, AcceleratorWrite);
+    autoView(C_v, C, AcceleratorRead);
+    autoView(GaugeK_v, GaugeK, AcceleratorRead);
+    autoView(SigmaKPrime_v, SigmaKPrime, AcceleratorRead);
+    accelerator_for(ss, grid->oSites(), 1, {
+      for (int mu = 0; mu < Nd; mu++) {
+        auto Cmu = C_v[ss](mu)();
+        auto e_iQ = Cmu;
+        auto iLambda_mu = set_iLambda(e_iQ, Ta(Cmu * adj(GaugeK_v[ss](mu)())),
+                                      SigmaKPrime_v[ss](mu)(), GaugeK_v[ss](mu)());
+        SigmaK_v[ss](mu)() = SigmaKPrime_v[ss](mu)() * e_iQ + adj(Cmu) * iLambda_mu;
+        iLambda_v[ss](mu)() = iLambda_mu;
+      }
+    });
     StoutSmearing->derivative(SigmaK, iLambda,
                              GaugeK);  // derivative of SmearBase
     return SigmaK;
@@ -119,96 +120,33 @@ private:
   }
 
   //====================================================================
-  void set_iLambda(GaugeLinkField& iLambda, GaugeLinkField& e_iQ,
-                   const GaugeLinkField& iQ, const GaugeLinkField& Sigmap,
-                   const GaugeLinkField& GaugeK) const 
+  // Site local; returns iLambda and sets e_iQ = exp(iQ)
+  template<class mat>
+  static accelerator_inline mat set_iLambda(mat& e_iQ, const mat& iQ,
+                                            const mat& Sigmap, const mat& GaugeK)
   {
-    GridBase* grid = iQ.Grid();
-    GaugeLinkField iQ2(grid), iQ3(grid), B1(grid), B2(grid), USigmap(grid);
-    GaugeLinkField unity(grid);
-    unity = 1.0;
-
-    LatticeComplex u(grid), w(grid);
-    LatticeComplex f0(grid), f1(grid), f2(grid);
-    LatticeComplex xi0(grid), xi1(grid), tmp(grid);
-    LatticeComplex u2(grid), w2(grid), cosw(grid);
-    LatticeComplex emiu(grid), e2iu(grid), qt(grid), fden(grid);
-    LatticeComplex r01(grid), r11(grid), r21(grid), r02(grid), r12(grid);
-    LatticeComplex r22(grid), tr1(grid), tr2(grid);
-    LatticeComplex b10(grid), b11(grid), b12(grid), b20(grid), b21(grid),
-      b22(grid);
-    LatticeComplex LatticeUnitComplex(grid);
-
-    LatticeUnitComplex = 1.0;
+    iScalar<Simd> f[3], b1[3], b2[3];
 
     // Exponential
-    iQ2 = iQ * iQ;
-    iQ3 = iQ * iQ2;
-    StoutSmearing->set_uw(u, w, iQ2, iQ3);
-    StoutSmearing->set_fj(f0, f1, f2, u, w);
-    e_iQ = f0 * unity + timesMinusI(f1) * iQ - f2 * iQ2;
+    mat iQ2 = iQ * iQ;
+    ExponentiateCoefficients(iQ, iQ2, f, b1, b2);
+    e_iQ = ExponentiateSum(f, iQ, iQ2);
 
     // Getting B1, B2, Gamma and Lambda
-    // simplify this part, reduntant calculations in set_fj
-    xi0 = StoutSmearing->func_xi0(w);
-    xi1 = StoutSmearing->func_xi1(w);
-    u2 = u * u;
-    w2 = w * w;
-    cosw = cos(w);
-
-    emiu = cos(u) - timesI(sin(u));
-    e2iu = cos(2.0 * u) + timesI(sin(2.0 * u));
-
-    r01 = (2.0 * u + timesI(2.0 * (u2 - w2))) * e2iu +
-      emiu * ((16.0 * u * cosw + 2.0 * u * (3.0 * u2 + w2) * xi0) +
-	      timesI(-8.0 * u2 * cosw + 2.0 * (9.0 * u2 + w2) * xi0));
-
-    r11 = (2.0 * LatticeUnitComplex + timesI(4.0 * u)) * e2iu +
-      emiu * ((-2.0 * cosw + (3.0 * u2 - w2) * xi0) +
-	      timesI((2.0 * u * cosw + 6.0 * u * xi0)));
-
-    r21 =
-      2.0 * timesI(e2iu) + emiu * (-3.0 * u * xi0 + timesI(cosw - 3.0 * xi0));
-
-    r02 = -2.0 * e2iu +
-      emiu * (-8.0 * u2 * xi0 +
-	      timesI(2.0 * u * (cosw + xi0 + 3.0 * u2 * xi1)));
-
-    r12 = emiu * (2.0 * u * xi0 + timesI(-cosw - xi0 + 3.0 * u2 * xi1));
-
-    r22 = emiu * (xi0 - timesI(3.0 * u * xi1));
-
-    fden = LatticeUnitComplex / (2.0 * (9.0 * u2 - w2) * (9.0 * u2 - w2));
-
-    b10 = 2.0 * u * r01 + (3.0 * u2 - w2) * r02 - (30.0 * u2 + 2.0 * w2) * f0;
-    b11 = 2.0 * u * r11 + (3.0 * u2 - w2) * r12 - (30.0 * u2 + 2.0 * w2) * f1;
-    b12 = 2.0 * u * r21 + (3.0 * u2 - w2) * r22 - (30.0 * u2 + 2.0 * w2) * f2;
-
-    b20 = r01 - (3.0 * u) * r02 - (24.0 * u) * f0;
-    b21 = r11 - (3.0 * u) * r12 - (24.0 * u) * f1;
-    b22 = r21 - (3.0 * u) * r22 - (24.0 * u) * f2;
-
-    b10 *= fden;
-    b11 *= fden;
-    b12 *= fden;
-    b20 *= fden;
-    b21 *= fden;
-    b22 *= fden;
-
-    B1 = b10 * unity + timesMinusI(b11) * iQ - b12 * iQ2;
-    B2 = b20 * unity + timesMinusI(b21) * iQ - b22 * iQ2;
-    USigmap = GaugeK * Sigmap;
+    mat B1 = ExponentiateSum(b1, iQ, iQ2);
+    mat B2 = ExponentiateSum(b2, iQ, iQ2);
+    mat USigmap = GaugeK * Sigmap;
 
-    tr1 = trace(USigmap * B1);
-    tr2 = trace(USigmap * B2);
+    iScalar<Simd> tr1 = trace(USigmap * B1);
+    iScalar<Simd> tr2 = trace(USigmap * B2);
 
-    GaugeLinkField QUS = iQ * USigmap;
-    GaugeLinkField USQ = USigmap * iQ;
+    mat QUS = iQ * USigmap;
+    mat USQ = USigmap * iQ;
 
-    GaugeLinkField iGamma = tr1 * iQ - timesI(tr2) * iQ2 +
-      timesI(f1) * USigmap + f2 * QUS + f2 * USQ;
+    mat iGamma = tr1 * iQ - timesI(tr2) * iQ2 +
+      timesI(f[1]) * USigmap + f[2] * QUS + f[2] * USQ;
 
-    iLambda = Ta(iGamma);
+    return Ta(iGamma);
   }
 
   //====================================================================
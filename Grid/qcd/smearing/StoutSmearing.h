@@ -81,26 +81,32 @@ public:
 
   void smear(GaugeField& u_smr, const GaugeField& U) const {
     GaugeField C(U.Grid());
-    GaugeLinkField tmp(U.Grid()), iq_mu(U.Grid()), Umu(U.Grid());
 
     std::cout << GridLogDebug << "Stout smearing started\n";
 
     // Smear the configurations
     SmearBase->smear(C, U);
 
-    for (int mu = 0; mu < Nd; mu++) {
-      if( mu == OrthogDim )
-        tmp = 1.0;  // Don't smear in the orthogonal direction
-      else {
-        tmp = peekLorentz(C, mu);
-        Umu = peekLorentz(U, mu);
-        iq_mu = Ta(
-                   tmp *
-                   adj(Umu));  // iq_mu = Ta(Omega_mu) to match the signs with the paper
-        exponentiate_iQ(tmp, iq_mu);
+    // u_smr = exp(iQ_mu)*U_mu with iQ_mu = Ta(C_mu U_mu^dag), to match the
+    // signs with the paper; one pass over the sites
+    int orthog = OrthogDim;
+    autoView(u_smr_v, u_smr, AcceleratorWrite);
+    autoView(C_v, C, AcceleratorRead);
+    autoView(U_v, U, AcceleratorRead);
+    accelerator_for(ss, U.Grid()->oSites(), 1, {
+      for (int mu = 0; mu < Nd; mu++) {
+        if ( mu == orthog ) {
+          u_smr_v[ss](mu) = U_v[ss](mu);  // Don't smear in the orthogonal direction
+        } else {
+          auto Umu = U_v[ss](mu)();
+          auto iQ  = Ta(C_v[ss](mu)() * adj(Umu));
+          auto iQ2 = iQ * iQ;
+          iScalar<Simd> f[3];
+          ExponentiateCoefficients(iQ, iQ2, f);
+          u_smr_v[ss](mu)() = ExponentiateSum(f, iQ, iQ2) * Umu;
+        }
       }
-      pokeLorentz(u_smr, tmp * Umu, mu);  // u_smr = exp(iQ_mu)*U_mu
-    }
+    });
     std::cout << GridLogDebug << "Stout smearing completed\n";
   };
 
@@ -114,100 +120,23 @@ public:
   };
 
 
-  // Repetion of code here (use the Tensor_exp.h function)
   void exponentiate_iQ(GaugeLinkField& e_iQ, const GaugeLinkField& iQ) const {
-    // Put this outside
     // only valid for SU(3) matrices
 
-    // only one Lorentz direction at a time
-
     // notice that it actually computes
     // exp ( input matrix )
     // the i sign is coming from outside
     // input matrix is anti-hermitian NOT hermitian
-
-    GridBase* grid = iQ.Grid();
-    GaugeLinkField unity(grid);
-    unity = 1.0;
-
-    GaugeLinkField iQ2(grid), iQ3(grid);
-    LatticeComplex u(grid), w(grid);
-    LatticeComplex f0(grid), f1(grid), f2(grid);
-
-    iQ2 = iQ * iQ;
-    iQ3 = iQ * iQ2;
-
-    //We should check sgn(c0) here already and then apply eq (34) from 0311018
-    set_uw(u, w, iQ2, iQ3);
-    set_fj(f0, f1, f2, u, w);
-
-    e_iQ = f0 * unity + timesMinusI(f1) * iQ - f2 * iQ2;
+    autoView(e_iQ_v, e_iQ, AcceleratorWrite);
+    autoView(iQ_v, iQ, AcceleratorRead);
+    accelerator_for(ss, iQ.Grid()->oSites(), 1, {
+      auto iQs  = iQ_v[ss]()();
+      auto iQ2s = iQs * iQs;
+      iScalar<Simd> f[3];
+      ExponentiateCoefficients(iQs, iQ2s, f);
+      e_iQ_v[ss]()() = ExponentiateSum(f, iQs, iQ2s);
+    });
   };
-
-  void set_uw(LatticeComplex& u, LatticeComplex& w, GaugeLinkField& iQ2,
-              GaugeLinkField& iQ3) const {
-    Complex one_over_three = 1.0 / 3.0;
-    Complex one_over_two = 1.0 / 2.0;
-
-    GridBase* grid = u.Grid();
-    LatticeComplex c0(grid), c1(grid), tmp(grid), c0max(grid), theta(grid);
-
-    // sign in c0 from the conventions on the Ta
-    c0 = -imag(trace(iQ3)) * one_over_three;  
-    c1 = -real(trace(iQ2)) * one_over_two;
-
-    // Cayley Hamilton checks to machine precision, tested
-    tmp = c1 * one_over_three;
-    c0max = 2.0 * pow(tmp, 1.5);
-
-    theta = acos(c0 / c0max) *
-      one_over_three;  // divide by three here, now leave as it is
-    u = sqrt(tmp) * cos(theta);
-    w = sqrt(c1) * sin(theta);
-  }
-
-  void set_fj(LatticeComplex& f0, LatticeComplex& f1, LatticeComplex& f2,
-              const LatticeComplex& u, const LatticeComplex& w) const {
-    GridBase* grid = u.Grid();
-    LatticeComplex xi0(grid), u2(grid), w2(grid), cosw(grid);
-    LatticeComplex fden(grid);
-    LatticeComplex h0(grid), h1(grid), h2(grid);
-    LatticeComplex e2iu(grid), emiu(grid), ixi0(grid), qt(grid);
-    LatticeComplex unity(grid);
-    unity = 1.0;
-
-    xi0 = func_xi0(w);
-    u2 = u * u;
-    w2 = w * w;
-    cosw = cos(w);
-
-    ixi0 = timesI(xi0);
-    emiu = cos(u) - timesI(sin(u));
-    e2iu = cos(2.0 * u) + timesI(sin(2.0 * u));
-
-    h0 = e2iu * (u2 - w2) +
-      emiu * ((8.0 * u2 * cosw) + (2.0 * u * (3.0 * u2 + w2) * ixi0));
-    h1 = e2iu * (2.0 * u) - emiu * ((2.0 * u * cosw) - (3.0 * u2 - w2) * ixi0);
-    h2 = e2iu - emiu * (cosw + (3.0 * u) * ixi0);
-
-    fden = unity / (9.0 * u2 - w2);  // reals
-    f0 = h0 * fden;
-    f1 = h1 * fden;
-    f2 = h2 * fden;
-  }
-
-  LatticeComplex func_xi0(const LatticeComplex& w) const {
-    // Definition from arxiv 0311018
-    //if (abs(w) < 0.05) {w2 = w*w; return 1.0 - w2/6.0 * (1.0-w2/20.0 * (1.0-w2/42.0));}
-    return sin(w) / w;
-  }
-
-  LatticeComplex func_xi1(const LatticeComplex& w) const {
-    // Define a function to do the check
-    // if( w < 1e-4 ) std::cout << GridLogWarning << "[Smear_stout] w too small:
-    // "<< w <<"\n";
-    return cos(w) / (w * w) - sin(w) / (w * w * w);
-  }
 };
 
 NAMESPACE_END(Grid);
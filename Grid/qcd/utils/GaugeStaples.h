@@ -0,0 +1,293 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/utils/GaugeStaples.h
+
+    Copyright (C) 2015
+
+    Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////////
+// Staples, rectangle staples and clover leaves from a single halo exchange.
+//
+// The gauge field is copied once into a PaddedCell (depth 1 for plaquettes
+// and clover leaves, depth 2 once rectangles are wanted), after which every
+// closed path is a product of links read through a GeneralLocalStencil. All
+// directions of a given quantity are computed in one site loop, replacing the
+// chains of Cshift/CovShiftForward in WilsonLoops.
+//
+// Only valid for periodic gauge fields; the Cshift code in WilsonLoops
+// remains the reference and handles the twisted/charge conjugate boundaries.
+//
+// The padded copy costs (1+2*depth/L)^4 of the gauge field and only pays off
+// on large local volumes, so callers check Usable() and otherwise fall back to
+// Cshift. The threshold is GaugeStaplesStatic::MinLocalVolume, set with
+// --gauge-staples-min-volume. ReleaseGauge() frees the padded field between
+// uses.
+///////////////////////////////////////////////////////////////////////////////
+class GaugeStaplesStatic {
+public:
+  static int64_t MinLocalVolume;
+};
+
+struct GaugePathStep {
+  int point; // stencil point of the link
+  int dir;   // Lorentz index of the link
+  int dag;   // traversed backwards
+};
+
+// A set of path ordered products summed into nout outputs
+struct GaugePathSet {
+  int nout;
+  Vector<int> out_begin;   // paths of output o are [out_begin[o],out_begin[o+1])
+  Vector<int> path_begin;  // steps of path p are [path_begin[p],path_begin[p+1])
+  Vector<int> path_sign;
+  Vector<GaugePathStep> steps;
+};
+
+template <class Gimpl> class GaugeStaples {
+public:
+  INHERIT_GIMPL_TYPES(Gimpl);
+
+  typedef typename Gimpl::GaugeLinkField GaugeMat;
+  typedef typename Gimpl::GaugeField GaugeLorentz;
+
+private:
+  GridBase *grid;
+  int depth;
+  PaddedCell Ghost;
+  std::vector<Coordinate> shifts;
+  std::unique_ptr<GeneralLocalStencil> stencil;
+  std::unique_ptr<GaugeLorentz> Upadded;
+
+  GaugePathSet staples;
+  GaugePathSet rects;
+  std::vector<GaugePathSet> leaves; // one per plane mu<nu
+
+public:
+  GridBase *Grid(void) const { return grid; }
+  int Depth(void) const { return depth; }
+
+  ///////////////////////////////////////////////////////////
+  // Periodic field, local volume above the threshold, and a
+  // SIMD layout the GeneralLocalStencil permutes can handle
+  ///////////////////////////////////////////////////////////
+  static bool Usable(GridBase *_grid,int _depth)
+  {
+    if ( !Gimpl::isPeriodicGaugeField() ) return false;
+    if ( dynamic_cast<GridCartesian *>(_grid)==nullptr ) return false;
+    if ( _grid->lSites() < GaugeStaplesStatic::MinLocalVolume ) return false;
+    for(int d=0;d<_grid->Nd();d++){
+      if ( _grid->_simd_layout[d] > 2 ) return false;
+      if ( _grid->_ldimensions[d] < _depth ) return false;
+    }
+    return true;
+  }
+
+  GaugeStaples(GridCartesian *_grid,int _depth=1)
+    : grid(_grid), depth(_depth), Ghost(_depth,_grid)
+  {
+    assert(Gimpl::isPeriodicGaugeField());
+    assert((depth==1)||(depth==2));
+
+    // Steps are +/-(dir+1); staples start from x+mu and return to x
+    staples.nout=Nd;
+    staples.out_begin.push_back(0);
+    for(int mu=0;mu<Nd;mu++){
+      Coordinate start(Nd,0); start[mu]=1;
+      for(int nu=0;nu<Nd;nu++){
+	if ( nu==mu ) continue;
+	int m=mu+1, n=nu+1;
+	AddPath(staples,start,{ n,-m,-n},1); //  __|
+	AddPath(staples,start,{-n,-m, n},1); // |__
+      }
+      staples.out_begin.push_back(staples.path_sign.size());
+    }
+
+    if ( depth==2 ) {
+      rects.nout=Nd;
+      rects.out_begin.push_back(0);
+      for(int mu=0;mu<Nd;mu++){
+	Coordinate start(Nd,0); start[mu]=1;
+	for(int nu=0;nu<Nd;nu++){
+	  if ( nu==mu ) continue;
+	  int m=mu+1, n=nu+1;
+	  AddPath(rects,start,{ m, n,-m,-m,-n},1);
+	  AddPath(rects,start,{ m,-n,-m,-m, n},1);
+	  AddPath(rects,start,{-n,-m,-m, n, m},1);
+	  AddPath(rects,start,{ n,-m,-m,-n, m},1);
+	  AddPath(rects,start,{ n, n,-m,-n,-n},1);
+	  AddPath(rects,start,{-n,-n,-m, n, n},1);
+	}
+	rects.out_begin.push_back(rects.path_sign.size());
+      }
+    }
+
+    // Four clover leaves in the mu,nu plane, all closed at x
+    for(int mu=0;mu<Nd;mu++){
+      for(int nu=mu+1;nu<Nd;nu++){
+	GaugePathSet leaf;
+	Coordinate start(Nd,0);
+	int m=mu+1, n=nu+1;
+	leaf.nout=1;
+	leaf.out_begin.push_back(0);
+	AddPath(leaf,start,{ m, n,-m,-n}, 1);
+	AddPath(leaf,start,{ m,-n,-m, n},-1);
+	AddPath(leaf,start,{ n,-m,-n, m}, 1);
+	AddPath(leaf,start,{-n,-m, n, m},-1);
+	leaf.out_begin.push_back(leaf.path_sign.size());
+	leaves.push_back(leaf);
+      }
+    }
+
+    stencil.reset(new GeneralLocalStencil(Ghost.PaddedGrid(),shifts));
+  }
+
+  ///////////////////////////////////////////////////////////
+  // One halo exchange serves all subsequent calls
+  ///////////////////////////////////////////////////////////
+  void ImportGauge(const GaugeLorentz &U)
+  {
+    conformable(U.Grid(),grid);
+    if ( !Upadded ) Upadded.reset(new GaugeLorentz(Ghost.PaddedGrid()));
+    *Upadded = Ghost.Exchange(U);
+  }
+  void ReleaseGauge(void) { Upadded.reset(); }
+
+  ///////////////////////////////////////////////////////////
+  // Same conventions as WilsonLoops::Staple and RectStaple,
+  // all mu at once: staple(mu) multiplies U_mu from the right
+  ///////////////////////////////////////////////////////////
+  void Staple(GaugeLorentz &staple)
+  {
+    GaugeLorentz padded(Ghost.PaddedGrid());
+    EvaluatePaths(staples,padded);
+    staple = Ghost.Extract(padded);
+  }
+  void RectStaple(GaugeLorentz &staple)
+  {
+    assert(depth==2);
+    GaugeLorentz padded(Ghost.PaddedGrid());
+    EvaluatePaths(rects,padded);
+    staple = Ghost.Extract(padded);
+  }
+
+  ///////////////////////////////////////////////////////////
+  // Clover leaf field strength, as WilsonLoops::FieldStrength
+  ///////////////////////////////////////////////////////////
+  void FieldStrength(GaugeMat &FS, int mu, int nu)
+  {
+    assert(mu!=nu);
+    int a = std::min(mu,nu);
+    int b = std::max(mu,nu);
+    int plane = 0;
+    for(int m=0;m<a;m++) plane+=Nd-1-m;
+    plane += b-a-1;
+
+    GaugeMat padded(Ghost.PaddedGrid());
+    EvaluatePaths(leaves[plane],padded);
+    FS = Ghost.Extract(padded);
+    RealD coeff = (mu < nu) ? 0.125 : -0.125;
+    FS = coeff*(FS - adj(FS));
+  }
+
+private:
+
+  int ShiftPoint(const Coordinate &shift)
+  {
+    for(int p=0;p<shifts.size();p++){
+      int same=1;
+      for(int d=0;d<Nd;d++) same = same && (shifts[p][d]==shift[d]);
+      if ( same ) return p;
+    }
+    shifts.push_back(shift);
+    return shifts.size()-1;
+  }
+
+  void AddPath(GaugePathSet &set,const Coordinate &start,const std::vector<int> &path,int sign)
+  {
+    Coordinate x = start;
+    if ( set.path_begin.size()==0 ) set.path_begin.push_back(0);
+    for(int s=0;s<path.size();s++){
+      GaugePathStep step;
+      step.dir = abs(path[s])-1;
+      step.dag = path[s] < 0;
+      if ( step.dag ) x[step.dir]--;
+      for(int d=0;d<Nd;d++) assert(abs(x[d])<=depth);
+      step.point = ShiftPoint(x);
+      if ( !step.dag ) x[step.dir]++;
+      set.steps.push_back(step);
+    }
+    for(int d=0;d<Nd;d++) assert(x[d]==0);
+    set.path_sign.push_back(sign);
+    set.path_begin.push_back(set.steps.size());
+  }
+
+  template<class vobj,int N> static accelerator_inline
+  vobj & PathOutput(iVector<vobj,N> &site,int o) { return site(o); }
+  template<class vobj> static accelerator_inline
+  vobj & PathOutput(iScalar<vobj> &site,int o) { return site(); }
+
+  template<class vobj>
+  void EvaluatePaths(const GaugePathSet &set,Lattice<vobj> &out)
+  {
+    GridBase *pgrid = Ghost.PaddedGrid();
+    conformable(out.Grid(),pgrid);
+    assert(Upadded);
+
+    autoView( U_v   , (*Upadded), AcceleratorRead);
+    autoView( out_v , out    , AcceleratorWrite);
+    auto st_v = stencil->View();
+
+    const int *out_begin  = &set.out_begin[0];
+    const int *path_begin = &set.path_begin[0];
+    const int *path_sign  = &set.path_sign[0];
+    const GaugePathStep *steps = &set.steps[0];
+    int nout = set.nout;
+
+    accelerator_for(ss,pgrid->oSites(),vobj::Nsimd(),{
+      typedef decltype(coalescedRead(U_v[0](0))) calcLink;
+      for(int o=0;o<nout;o++){
+	calcLink acc = Zero();
+	for(int p=out_begin[o];p<out_begin[o+1];p++){
+	  calcLink prod;
+	  for(int s=path_begin[p];s<path_begin[p+1];s++){
+	    auto SE = st_v.GetEntry(steps[s].point,ss);
+	    calcLink link = coalescedReadGeneralPermute(U_v[SE->_offset](steps[s].dir),SE->_permute,Nd);
+	    if ( steps[s].dag ) link = adj(link);
+	    if ( s==path_begin[p] ) prod = link;
+	    else                    prod = prod*link;
+	  }
+	  if ( path_sign[p] > 0 ) acc = acc + prod;
+	  else                    acc = acc - prod;
+	}
+	coalescedWrite(PathOutput(out_v[ss],o),acc);
+      }
+    });
+  }
+};
+
+NAMESPACE_END(Grid);
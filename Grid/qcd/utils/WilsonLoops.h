@@ -370,17 +370,30 @@ public:
   static Real TopologicalCharge(GaugeLorentz &U){
     // 4d topological charge
     assert(Nd==4);
-    // Bx = -iF(y,z), By = -iF(z,y), Bz = -iF(x,y)
     GaugeMat Bx(U.Grid()), By(U.Grid()), Bz(U.Grid());
-    FieldStrength(Bx, U, Ydir, Zdir);
-    FieldStrength(By, U, Zdir, Xdir);
-    FieldStrength(Bz, U, Xdir, Ydir);
-
-    // Ex = -iF(t,x), Ey = -iF(t,y), Ez = -iF(t,z)
     GaugeMat Ex(U.Grid()), Ey(U.Grid()), Ez(U.Grid());
-    FieldStrength(Ex, U, Tdir, Xdir);
-    FieldStrength(Ey, U, Tdir, Ydir);
-    FieldStrength(Ez, U, Tdir, Zdir);
+
+    if ( GaugeStaples<Gimpl>::Usable(U.Grid(),1) ) {
+      // All six planes of clover leaves from one halo exchange
+      GaugeStaples<Gimpl> Leaves(dynamic_cast<GridCartesian *>(U.Grid()),1);
+      Leaves.ImportGauge(U);
+      Leaves.FieldStrength(Bx, Ydir, Zdir);
+      Leaves.FieldStrength(By, Zdir, Xdir);
+      Leaves.FieldStrength(Bz, Xdir, Ydir);
+      Leaves.FieldStrength(Ex, Tdir, Xdir);
+      Leaves.FieldStrength(Ey, Tdir, Ydir);
+      Leaves.FieldStrength(Ez, Tdir, Zdir);
+    } else {
+      // Bx = -iF(y,z), By = -iF(z,y), Bz = -iF(x,y)
+      FieldStrength(Bx, U, Ydir, Zdir);
+      FieldStrength(By, U, Zdir, Xdir);
+      FieldStrength(Bz, U, Xdir, Ydir);
+
+      // Ex = -iF(t,x), Ey = -iF(t,y), Ez = -iF(t,z)
+      FieldStrength(Ex, U, Tdir, Xdir);
+      FieldStrength(Ey, U, Tdir, Ydir);
+      FieldStrength(Ez, U, Tdir, Zdir);
+    }
 
     double coeff = 8.0/(32.0*M_PI*M_PI);
 
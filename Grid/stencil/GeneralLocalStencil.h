@@ -43,7 +43,7 @@ class GeneralLocalStencilView {
   int                               _npoints; // Move to template param?
   GeneralStencilEntry*  _entries_p;
 
-  accelerator_inline GeneralStencilEntry * GetEntry(int point,int osite) { 
+  accelerator_inline GeneralStencilEntry * GetEntry(int point,int osite) const { 
     return & this->_entries_p[point+this->_npoints*osite]; 
   }
 
@@ -103,13 +103,13 @@ public:
 	SE._permute =0;
 	for(int d=0;d<Coor.size();d++){
 
-	  int fd = grid->_fdimensions[d];
+	  int ld = grid->_ldimensions[d];
 	  int rd = grid->_rdimensions[d];
 	  int ly = grid->_simd_layout[d];
 
 	  assert((ly==1)||(ly==2));
 
-	  int shift = (shifts[ii][d]+fd)%fd;  // make it strictly positive 0.. L-1
+	  int shift = (shifts[ii][d]+ld)%ld;  // make it strictly positive 0.. L-1 in the local volume
 	  int x = Coor[d];                // x in [0... rd-1] as an oSite 
 
 	  int permute_dim  = grid->PermuteDim(d);
@@ -232,6 +232,7 @@ public:
     Integer to_rank;
     Integer from_rank;
     Integer bytes;
+    Integer point;
   };
   struct Merge {
     cobj * mpointer;
@@ -239,11 +240,38 @@ public:
     Vector<cobj *> vpointers;
     Integer buffer_size;
     Integer type;
+    Integer point;
   };
   struct Decompress {
     cobj * kernel_p;
     cobj * mpi_p;
     Integer buffer_size;
+    Integer point;
+  };
+  ////////////////////////////////////////////////////////////////////////
+  // Exchange plan. The packet, merge and decompress lists depend only on
+  // the stencil geometry and on how the compressor lays out the comms
+  // buffers, so they are recorded on the first exchange and replayed.
+  // Off node packets carry persistent requests. Each entry remembers the
+  // stencil point it serves; the off node merges are also kept by point.
+  ////////////////////////////////////////////////////////////////////////
+  struct ExchangePlan {
+    int decompression;
+    int datum_bytes;
+    std::vector<Packet> Packets;
+    std::vector<Merge> Mergers;
+    std::vector<Merge> MergersSHM;
+    std::vector<Decompress> Decompressions;
+    std::vector<Decompress> DecompressionsSHM;
+    std::vector<std::vector<CommsRequest_t> > Requests;
+    std::vector<double> OffNodeBytes;
+    std::vector<std::vector<Merge> > PointMergers;
+    std::vector<std::vector<Decompress> > PointDecompressions;
+    ~ExchangePlan() {
+      for(int i=0;i<Requests.size();i++){
+	CartesianCommunicator::StencilSendToRecvFromFree(Requests[i]);
+      }
+    }
   };
 
 
@@ -268,13 +296,18 @@ public:
   int face_table_computed;
   std::vector<Vector<std::pair<int,int> > > face_table ;
   Vector<int> surface_list;
+  std::vector<Vector<int> > surface_list_point; // surface sites needing off node data for each point
 
   stencilVector<StencilEntry>  _entries; // Resident in managed memory
-  std::vector<Packet> Packets;
-  std::vector<Merge> Mergers;
-  std::vector<Merge> MergersSHM;
-  std::vector<Decompress> Decompressions;
-  std::vector<Decompress> DecompressionsSHM;
+  std::vector<std::shared_ptr<ExchangePlan> > Plans;
+  std::shared_ptr<ExchangePlan> Plan; // in use by the current exchange
+  int PlanRecording;
+  int PlanPoint;                      // point being gathered while recording
+
+  // Completion state for CommunicateCompletePoint
+  std::vector<int> packet_pending;
+  std::vector<int> point_pending;
+  std::vector<int> point_done;
 
   ///////////////////////////////////////////////////////////
   // Unified Comms buffers for all directions
@@ -292,6 +325,7 @@ public:
   // Timing info; ugly; possibly temporary
   /////////////////////////////////////////
   double commtime;
+  double progresswaittime;
   double mpi3synctime;
   double mpi3synctime_g;
   double shmmergetime;
@@ -364,6 +398,7 @@ public:
     if (nthreads == -1) nthreads = 1;
     if (mythread < nthreads) {
       comm_enter_thr[mythread] = usecond();
+      auto &Packets = Plan->Packets;
       for (int i = mythread; i < Packets.size(); i += nthreads) {
 	uint64_t bytes = _grid->StencilSendToRecvFrom(Packets[i].send_buf,
 						      Packets[i].to_rank,
@@ -408,31 +443,93 @@ public:
   }
   ////////////////////////////////////////////////////////////////////////
   // Non blocking send and receive. Necessarily parallel.
+  // Restarts the persistent requests held by the exchange plan.
   ////////////////////////////////////////////////////////////////////////
-  void CommunicateBegin(std::vector<std::vector<CommsRequest_t> > &reqs)
+  void CommunicateBegin(void)
   {
-    reqs.resize(Packets.size());
+    auto &Packets = Plan->Packets;
     commtime-=usecond();
+    packet_pending.assign(Packets.size(),1);
+    point_pending.assign(this->_npoints,0);
+    point_done.assign(this->_npoints,0);
     for(int i=0;i<Packets.size();i++){
-      uint64_t bytes=_grid->StencilSendToRecvFromBegin(reqs[i],
-						     Packets[i].send_buf,
-						     Packets[i].to_rank,
-						     Packets[i].recv_buf,
-						     Packets[i].from_rank,
-						     Packets[i].bytes,i);
+      point_pending[Packets[i].point]++;
+      _grid->StencilSendToRecvFromStart(Plan->Requests[i],i);
+      double bytes = Plan->OffNodeBytes[i];
       comms_bytes+=bytes;
       shm_bytes  +=2*Packets[i].bytes-bytes;
     }
   }
 
-  void CommunicateComplete(std::vector<std::vector<CommsRequest_t> > &reqs)
+  void CommunicateComplete(void)
   {
-    for(int i=0;i<Packets.size();i++){
-      _grid->StencilSendToRecvFromComplete(reqs[i],i);
+    for(int i=0;i<Plan->Packets.size();i++){
+      _grid->StencilSendToRecvFromWait(Plan->Requests[i],i);
     }
     commtime+=usecond();
   }
   ////////////////////////////////////////////////////////////////////////
+  // Alternative to CommunicateComplete that completes one point at a time.
+  // After CommunicateBegin, each call returns a point whose packets have
+  // all arrived, polling the outstanding ones in turn, so the slowest link
+  // only delays its own points. Returns -1 when every point has been
+  // returned. Points without packets come back first.
+  ////////////////////////////////////////////////////////////////////////
+  int CommunicateCompletePoint(void)
+  {
+    auto &Packets = Plan->Packets;
+    while(1) {
+      int remaining=0;
+      for(int p=0;p<this->_npoints;p++){
+	if ( point_done[p] ) continue;
+	if ( point_pending[p]==0 ) {
+	  point_done[p]=1;
+	  return p;
+	}
+	remaining++;
+      }
+      if ( remaining==0 ) {
+	commtime+=usecond();
+	return -1;
+      }
+      for(int i=0;i<Packets.size();i++){
+	if ( packet_pending[i] && _grid->StencilSendToRecvFromTest(Plan->Requests[i],i) ) {
+	  packet_pending[i]=0;
+	  point_pending[Packets[i].point]--;
+	}
+      }
+    }
+  }
+  ////////////////////////////////////////////////////////////////////////
+  // With a comms progress thread, hand the requests started by
+  // CommunicateBegin over to it. It tests them while the compute threads
+  // run the interior and does the off node merge of each point as its
+  // packets land. CommunicateProgressComplete waits for it to finish;
+  // without a progress thread it is CommunicateComplete then CommsMerge.
+  // The SHM merge is left to the caller, since the interior reads it.
+  ////////////////////////////////////////////////////////////////////////
+  template<class decompressor> void CommunicateProgressBegin(decompressor decompress)
+  {
+    if ( !GridThread::ProgressThreadRunning() ) return;
+    GridThread::ProgressPost([this,decompress](){
+      int point;
+      while ( (point=this->CommunicateCompletePoint()) >= 0 ) {
+	this->CommsMergePoint(decompress,point);
+      }
+    });
+  }
+  template<class decompressor> void CommunicateProgressComplete(decompressor decompress)
+  {
+    if ( GridThread::ProgressThreadRunning() ) {
+      progresswaittime-=usecond();
+      GridThread::ProgressWait();
+      progresswaittime+=usecond();
+    } else {
+      CommunicateComplete();
+      CommsMerge(decompress);
+    }
+  }
+  ////////////////////////////////////////////////////////////////////////
   // Blocking send and receive. Either sequential or parallel.
   ////////////////////////////////////////////////////////////////////////
   void Communicate(void)
@@ -446,6 +543,7 @@ public:
 	assert(nthreads <= maxthreads);
 	if (nthreads == -1) nthreads = 1;
 	if (mythread < nthreads) {
+	  auto &Packets = Plan->Packets;
 	  for (int i = mythread; i < Packets.size(); i += nthreads) {
 	    double start = usecond();
 	    uint64_t bytes= _grid->StencilSendToRecvFrom(Packets[i].send_buf,
@@ -460,9 +558,8 @@ public:
 	}
       }
     } else { // Concurrent and non-threaded asynch calls to MPI
-      std::vector<std::vector<CommsRequest_t> > reqs;
-      this->CommunicateBegin(reqs);
-      this->CommunicateComplete(reqs);
+      this->CommunicateBegin();
+      this->CommunicateComplete();
     }
   }
 
@@ -477,6 +574,7 @@ public:
 
   template<class compressor> int HaloGatherDir(const Lattice<vobj> &source,compressor &compress,int point,int & face_idx)
   {
+    PlanPoint = point;
     int dimension    = this->_directions[point];
     int displacement = this->_distances[point];
 
@@ -545,6 +643,8 @@ public:
 
     u_comm_offset=0;
 
+    PlanBegin(compress);
+
     // Gather all comms buffers
     int face_idx=0;
     for(int point = 0 ; point < this->_npoints; point++) {
@@ -554,6 +654,8 @@ public:
     face_table_computed=1;
     assert(u_comm_offset==_unified_buffer_size);
 
+    PlanEnd();
+
     accelerator_barrier();
     halogtime+=usecond();
   }
@@ -563,46 +665,96 @@ public:
   /////////////////////////
   void Prepare(void)
   {
-    Decompressions.resize(0);
-    DecompressionsSHM.resize(0);
-    Mergers.resize(0);
-    MergersSHM.resize(0);
-    Packets.resize(0);
     calls++;
   }
+  //////////////////////////////////////////////////////////////////////
+  // Select the plan for this compressor's buffer layout, or start
+  // recording one. The Add* calls below only record.
+  //////////////////////////////////////////////////////////////////////
+  template<class compressor> void PlanBegin(compressor &compress)
+  {
+    int decompression = compress.DecompressionStep();
+    int datum_bytes   = compress.CommDatumSize();
+    for(int p=0;p<Plans.size();p++){
+      if ( (Plans[p]->decompression==decompression) && (Plans[p]->datum_bytes==datum_bytes) ) {
+	Plan = Plans[p];
+	PlanRecording = 0;
+	return;
+      }
+    }
+    Plan = std::make_shared<ExchangePlan>();
+    Plan->decompression = decompression;
+    Plan->datum_bytes   = datum_bytes;
+    Plans.push_back(Plan);
+    PlanRecording = 1;
+  }
+  void PlanEnd(void)
+  {
+    if ( !PlanRecording ) return;
+    auto &Packets = Plan->Packets;
+    Plan->PointMergers.resize(this->_npoints);
+    Plan->PointDecompressions.resize(this->_npoints);
+    for(int i=0;i<Plan->Mergers.size();i++){
+      Plan->PointMergers[Plan->Mergers[i].point].push_back(Plan->Mergers[i]);
+    }
+    for(int i=0;i<Plan->Decompressions.size();i++){
+      Plan->PointDecompressions[Plan->Decompressions[i].point].push_back(Plan->Decompressions[i]);
+    }
+    Plan->Requests.resize(Packets.size());
+    Plan->OffNodeBytes.resize(Packets.size());
+    for(int i=0;i<Packets.size();i++){
+      Plan->OffNodeBytes[i]=_grid->StencilSendToRecvFromInit(Plan->Requests[i],
+							     Packets[i].send_buf,
+							     Packets[i].to_rank,
+							     Packets[i].recv_buf,
+							     Packets[i].from_rank,
+							     Packets[i].bytes,i);
+    }
+    PlanRecording = 0;
+  }
   void AddPacket(void *xmit,void * rcv, Integer to,Integer from,Integer bytes){
+    if ( !PlanRecording ) return;
     Packet p;
     p.send_buf = xmit;
     p.recv_buf = rcv;
     p.to_rank  = to;
     p.from_rank= from;
     p.bytes    = bytes;
-    Packets.push_back(p);
+    p.point    = PlanPoint;
+    Plan->Packets.push_back(p);
   }
   void AddDecompress(cobj *k_p,cobj *m_p,Integer buffer_size,std::vector<Decompress> &dv) {
+    if ( !PlanRecording ) return;
     Decompress d;
     d.kernel_p = k_p;
     d.mpi_p    = m_p;
     d.buffer_size = buffer_size;
+    d.point    = PlanPoint;
     dv.push_back(d);
   }
   void AddMerge(cobj *merge_p,Vector<cobj *> &rpointers,Integer buffer_size,Integer type,std::vector<Merge> &mv) {
+    if ( !PlanRecording ) return;
     Merge m;
     m.type     = type;
     m.mpointer = merge_p;
     m.vpointers= rpointers;
     m.buffer_size = buffer_size;
+    m.point    = PlanPoint;
     mv.push_back(m);
   }
   template<class decompressor>  void CommsMerge(decompressor decompress)    {
-    CommsMerge(decompress,Mergers,Decompressions);
+    CommsMerge(decompress,Plan->Mergers,Plan->Decompressions);
+  }
+  // Off node merge for a single point, after CommunicateCompletePoint returned it
+  template<class decompressor>  void CommsMergePoint(decompressor decompress,int point) {
+    CommsMerge(decompress,Plan->PointMergers[point],Plan->PointDecompressions[point]);
   }
   template<class decompressor>  void CommsMergeSHM(decompressor decompress) {
     mpi3synctime-=usecond();
     _grid->StencilBarrier();// Synch shared memory on a single nodes
     mpi3synctime+=usecond();
     shmmergetime-=usecond();
-    CommsMerge(decompress,MergersSHM,DecompressionsSHM);
+    CommsMerge(decompress,Plan->MergersSHM,Plan->DecompressionsSHM);
     shmmergetime+=usecond();
   }
 
@@ -665,6 +817,17 @@ public:
 	surface_list.push_back(site);
       }
     }
+    BuildSurfaceListPoint(Ls,vol4);
+  }
+  void BuildSurfaceListPoint(int Ls,int vol4){
+    surface_list_point.resize(this->_npoints);
+    for(int point=0;point<this->_npoints;point++){
+      surface_list_point[point].resize(0);
+      if ( this->same_node[point] ) continue;
+      for(int site = 0 ;site< vol4;site++){
+	if( !this->GetNodeLocal(site*Ls,point) ) surface_list_point[point].push_back(site);
+      }
+    }
   }
 
   CartesianStencil(GridBase *grid,
@@ -680,6 +843,8 @@ public:
       comm_time_thr(npoints)
   {
     face_table_computed=0;
+    PlanRecording=0;
+    PlanPoint=0;
     _grid    = grid;
     this->parameters=p;
     /////////////////////////////////////
@@ -1083,11 +1248,11 @@ public:
 	  if ( shm_receive_only ) { // Early decompress before MPI is finished is possible
 	    AddDecompress(&this->u_recv_buf_p[u_comm_offset],
 			  &recv_buf[u_comm_offset],
-			  words,DecompressionsSHM);
+			  words,Plan->DecompressionsSHM);
 	  } else { // Decompress after MPI is finished
 	    AddDecompress(&this->u_recv_buf_p[u_comm_offset],
 			  &recv_buf[u_comm_offset],
-			  words,Decompressions);
+			  words,Plan->Decompressions);
 	  }
 
 	  AddPacket((void *)&send_buf[u_comm_offset],
@@ -1231,9 +1396,9 @@ public:
 	}
 
 	if ( shm_receive_only ) {
-	  AddMerge(&this->u_recv_buf_p[u_comm_offset],rpointers,reduced_buffer_size,permute_type,MergersSHM);
+	  AddMerge(&this->u_recv_buf_p[u_comm_offset],rpointers,reduced_buffer_size,permute_type,Plan->MergersSHM);
 	} else {
-	  AddMerge(&this->u_recv_buf_p[u_comm_offset],rpointers,reduced_buffer_size,permute_type,Mergers);
+	  AddMerge(&this->u_recv_buf_p[u_comm_offset],rpointers,reduced_buffer_size,permute_type,Plan->Mergers);
 	}
 
 	u_comm_offset     +=buffer_size;
@@ -1245,6 +1410,7 @@ public:
   void ZeroCounters(void) {
     gathertime = 0.;
     commtime = 0.;
+    progresswaittime = 0.;
     mpi3synctime=0.;
     mpi3synctime_g=0.;
     shmmergetime=0.;
@@ -1286,6 +1452,7 @@ public:
     if (threaded) commtime += t;
 
     _grid->GlobalSum(commtime);    commtime/=NP;
+    _grid->GlobalSum(progresswaittime); progresswaittime/=NP;
     if ( calls > 0. ) {
       std::cout << GridLogMessage << " Stencil calls "<<calls<<std::endl;
       PRINTIT(halogtime);
@@ -1298,6 +1465,12 @@ public:
 	PRINTIT(commtime);
 	std::cout << GridLogMessage << " Stencil " << comms_bytes/commtime/1000. << " GB/s per rank"<<std::endl;
 	std::cout << GridLogMessage << " Stencil " << comms_bytes/commtime/1000.*NP/NN << " GB/s per node"<<std::endl;
+	if ( progresswaittime > 0.0 ) {
+	  // Comms time not hidden behind compute by the progress thread
+	  PRINTIT(progresswaittime);
+	  std::cout << GridLogMessage << " Stencil progress thread overlap "
+		    << 100.0*(1.0-progresswaittime/commtime) << " % of commtime"<<std::endl;
+	}
       }
       if(shm_bytes>1.0){
 	PRINTIT(shm_bytes); // X bytes + R bytes
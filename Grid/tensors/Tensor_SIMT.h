@@ -53,6 +53,21 @@ vobj coalescedReadPermute(const vobj & __restrict__ vec,int ptype,int doperm,int
   }
 }
 template<class vobj> accelerator_inline
+vobj coalescedReadGeneralPermute(const vobj & __restrict__ vec,int perm,int nd,int lane=0)
+{
+  // perm is an OR of the lane masks of each permuted dimension (GeneralLocalStencil)
+  int NN = vobj::Nsimd();
+  vobj ret = vec;
+  for(int ptype=0;ptype<nd;ptype++){
+    int mask = NN >> (ptype + 1);
+    if ( perm & mask ) {
+      vobj tmp = ret;
+      permute(ret,tmp,ptype);
+    }
+  }
+  return ret;
+}
+template<class vobj> accelerator_inline
 void coalescedWrite(vobj & __restrict__ vec,const vobj & __restrict__ extracted,int lane=0)
 {
   vec = extracted;
@@ -144,6 +159,12 @@ typename vobj::scalar_object coalescedReadPermute(const vobj & __restrict__ vec,
   return extractLane(plane,vec);
 }
 template<class vobj> accelerator_inline
+typename vobj::scalar_object coalescedReadGeneralPermute(const vobj & __restrict__ vec,int perm,int nd,int lane=acceleratorSIMTlane(vobj::Nsimd()))
+{
+  int plane = lane ^ perm;
+  return extractLane(plane,vec);
+}
+template<class vobj> accelerator_inline
 void coalescedWrite(vobj & __restrict__ vec,const typename vobj::scalar_object & __restrict__ extracted,int lane=acceleratorSIMTlane(vobj::Nsimd()))
 {
   insertLane(lane,vec,extracted);
@@ -54,19 +54,19 @@ template<class vtype, int N> accelerator_inline iVector<vtype, N> Exponentiate(c
 
 
 
-// Specialisation: Cayley-Hamilton exponential for SU(3)
-#ifndef GRID_CUDA
-template<class vtype, typename std::enable_if< GridTypeMapper<vtype>::TensorLevel == 0>::type * =nullptr> 
-accelerator_inline iMatrix<vtype,3> Exponentiate(const iMatrix<vtype,3> &arg, RealD alpha  , Integer Nexp = DEFAULT_MAT_EXP )
+// Cayley-Hamilton form of the SU(3) exponential, hep-lat/0311018
+//
+//   exp(iQ) = f0 + f1 Q + f2 Q^2
+//
+// for iQ anti-hermitian and traceless, given iQ2 = iQ*iQ. If b1 and b2 are
+// given, also returns the coefficients of B1 and B2 (eq. 69) needed by the
+// stout force. Everything is site local; only meaningful for N=3.
+template<class vtype,int N, typename std::enable_if< GridTypeMapper<vtype>::TensorLevel == 0>::type * =nullptr> 
+accelerator_inline void ExponentiateCoefficients(const iMatrix<vtype,N> &iQ, const iMatrix<vtype,N> &iQ2,
+						 iScalar<vtype> *f,
+						 iScalar<vtype> *b1 = nullptr, iScalar<vtype> *b2 = nullptr)
 {
-  // for SU(3) 2x faster than the std implementation using Nexp=12
-  // notice that it actually computes
-  // exp ( input matrix )
-  // the i sign is coming from outside
-  // input matrix is anti-hermitian NOT hermitian
-  typedef iMatrix<vtype,3> mat;
   typedef iScalar<vtype> scalar;
-  mat unit(1.0);
   const Complex one_over_three = 1.0 / 3.0;
   const Complex one_over_two = 1.0 / 2.0;
 
@@ -74,14 +74,11 @@ accelerator_inline iMatrix<vtype,3> Exponentiate(const iMatrix<vtype,3> &arg, Re
   scalar xi0, u2, w2, cosw;
   scalar fden, h0, h1, h2;
   scalar e2iu, emiu, ixi0;
-  scalar f0, f1, f2;
   scalar unity(1.0);
-      
-  mat iQ2 = arg*arg*alpha*alpha;
-  mat iQ3 = arg*iQ2*alpha;   
+
   // sign in c0 from the conventions on the Ta
   scalar imQ3, reQ2;
-  imQ3 = imag( trace(iQ3) );
+  imQ3 = imag( trace(iQ*iQ2) );
   reQ2 = real( trace(iQ2) );
   c0 = -imQ3 * one_over_three;  
   c1 = -reQ2 * one_over_two;
@@ -109,11 +106,70 @@ accelerator_inline iMatrix<vtype,3> Exponentiate(const iMatrix<vtype,3> &arg, Re
   h2 = e2iu - emiu * (cosw + (3.0 * u) * ixi0);
 
   fden = unity / (9.0 * u2 - w2);  // reals
-  f0 = h0 * fden;
-  f1 = h1 * fden;
-  f2 = h2 * fden;
+  f[0] = h0 * fden;
+  f[1] = h1 * fden;
+  f[2] = h2 * fden;
+
+  if ( b1 == nullptr ) return;
+
+  scalar xi1, r01, r11, r21, r02, r12, r22;
+
+  xi1 = cosw / w2 - sin(w) / (w2 * w);
+
+  r01 = (2.0 * u + timesI(2.0 * (u2 - w2))) * e2iu +
+    emiu * ((16.0 * u * cosw + 2.0 * u * (3.0 * u2 + w2) * xi0) +
+	    timesI(-8.0 * u2 * cosw + 2.0 * (9.0 * u2 + w2) * xi0));
+
+  r11 = (2.0 * unity + timesI(4.0 * u)) * e2iu +
+    emiu * ((-2.0 * cosw + (3.0 * u2 - w2) * xi0) +
+	    timesI((2.0 * u * cosw + 6.0 * u * xi0)));
+
+  r21 = 2.0 * timesI(e2iu) + emiu * (-3.0 * u * xi0 + timesI(cosw - 3.0 * xi0));
+
+  r02 = -2.0 * e2iu +
+    emiu * (-8.0 * u2 * xi0 +
+	    timesI(2.0 * u * (cosw + xi0 + 3.0 * u2 * xi1)));
+
+  r12 = emiu * (2.0 * u * xi0 + timesI(-cosw - xi0 + 3.0 * u2 * xi1));
+
+  r22 = emiu * (xi0 - timesI(3.0 * u * xi1));
+
+  fden = unity / (2.0 * (9.0 * u2 - w2) * (9.0 * u2 - w2));
+
+  b1[0] = (2.0 * u * r01 + (3.0 * u2 - w2) * r02 - (30.0 * u2 + 2.0 * w2) * f[0]) * fden;
+  b1[1] = (2.0 * u * r11 + (3.0 * u2 - w2) * r12 - (30.0 * u2 + 2.0 * w2) * f[1]) * fden;
+  b1[2] = (2.0 * u * r21 + (3.0 * u2 - w2) * r22 - (30.0 * u2 + 2.0 * w2) * f[2]) * fden;
+
+  b2[0] = (r01 - (3.0 * u) * r02 - (24.0 * u) * f[0]) * fden;
+  b2[1] = (r11 - (3.0 * u) * r12 - (24.0 * u) * f[1]) * fden;
+  b2[2] = (r21 - (3.0 * u) * r22 - (24.0 * u) * f[2]) * fden;
+}
+
+// f0 + f1 Q + f2 Q^2 from the coefficients above
+template<class vtype,int N> 
+accelerator_inline iMatrix<vtype,N> ExponentiateSum(const iScalar<vtype> *f,const iMatrix<vtype,N> &iQ, const iMatrix<vtype,N> &iQ2)
+{
+  iMatrix<vtype,N> unit(1.0);
+  return (f[0] * unit + timesMinusI(f[1]) * iQ - f[2] * iQ2);
+}
+
+// Specialisation: Cayley-Hamilton exponential for SU(3)
+#ifndef GRID_CUDA
+template<class vtype, typename std::enable_if< GridTypeMapper<vtype>::TensorLevel == 0>::type * =nullptr> 
+accelerator_inline iMatrix<vtype,3> Exponentiate(const iMatrix<vtype,3> &arg, RealD alpha  , Integer Nexp = DEFAULT_MAT_EXP )
+{
+  // for SU(3) 2x faster than the std implementation using Nexp=12
+  // notice that it actually computes
+  // exp ( input matrix )
+  // the i sign is coming from outside
+  // input matrix is anti-hermitian NOT hermitian
+  typedef iMatrix<vtype,3> mat;
+  iScalar<vtype> f[3];
 
-  return (f0 * unit + timesMinusI(f1) * arg*alpha - f2 * iQ2);
+  mat iQ  = arg*alpha;
+  mat iQ2 = iQ*iQ;
+  ExponentiateCoefficients(iQ,iQ2,f);
+  return ExponentiateSum(f,iQ,iQ2);
 }
 #endif
 
@@ -0,0 +1,137 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./Grid/threads/ProgressThread.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/GridCore.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+NAMESPACE_BEGIN(Grid);
+
+int GridThread::_progress_core=-1;
+
+///////////////////////////////////////////////////////////////////
+// Comms progress thread. A single std::thread outside the OpenMP
+// team, draining a queue of posted work items.
+///////////////////////////////////////////////////////////////////
+static std::thread                *progress_thread;
+static std::mutex                  progress_mutex;
+static std::condition_variable     progress_cv;
+static std::deque<std::function<void(void)> > progress_queue;
+static int                         progress_pending;
+static int                         progress_stop;
+
+static void ProgressThreadLoop(int core)
+{
+#ifdef __linux__
+  if ( core >= 0 ) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(core,&cpus);
+    pthread_setaffinity_np(pthread_self(),sizeof(cpus),&cpus);
+  }
+#endif
+#ifdef GRID_OMP
+  // Any thread_for in posted work runs on this core alone
+  omp_set_num_threads(1);
+#endif
+  std::unique_lock<std::mutex> lock(progress_mutex);
+  while(1) {
+    progress_cv.wait(lock,[]{ return progress_stop || !progress_queue.empty(); });
+    if ( progress_queue.empty() ) return;
+    std::function<void(void)> work = progress_queue.front();
+    progress_queue.pop_front();
+    lock.unlock();
+    work();
+    lock.lock();
+    progress_pending--;
+    progress_cv.notify_all();
+  }
+}
+
+void GridThread::StartProgressThread(int core)
+{
+  if ( progress_thread ) return;
+#ifdef __linux__
+  // Default to the last core this process may run on, and keep the
+  // compute threads off it if they would otherwise fill the mask
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  if ( sched_getaffinity(0,sizeof(cpus),&cpus)==0 ) {
+    if ( core < 0 ) {
+      for(int c=0;c<CPU_SETSIZE;c++) if ( CPU_ISSET(c,&cpus) ) core = c;
+    }
+    if ( (_threads > 1) && (_threads >= CPU_COUNT(&cpus)) ) SetThreads(_threads-1);
+  }
+#endif
+  _progress_core = core;
+  progress_stop = 0;
+  progress_pending = 0;
+  progress_thread = new std::thread(ProgressThreadLoop,core);
+}
+
+void GridThread::StopProgressThread(void)
+{
+  if ( !progress_thread ) return;
+  {
+    std::lock_guard<std::mutex> lock(progress_mutex);
+    progress_stop = 1;
+  }
+  progress_cv.notify_all();
+  progress_thread->join();
+  delete progress_thread;
+  progress_thread = nullptr;
+  _progress_core = -1;
+}
+
+int GridThread::ProgressThreadRunning(void)
+{
+  return progress_thread != nullptr;
+}
+
+void GridThread::ProgressPost(std::function<void(void)> work)
+{
+  assert(progress_thread);
+  {
+    std::lock_guard<std::mutex> lock(progress_mutex);
+    progress_queue.push_back(work);
+    progress_pending++;
+  }
+  progress_cv.notify_all();
+}
+
+void GridThread::ProgressWait(void)
+{
+  std::unique_lock<std::mutex> lock(progress_mutex);
+  progress_cv.wait(lock,[]{ return progress_pending==0; });
+}
+
+NAMESPACE_END(Grid);
@@ -61,6 +61,18 @@ public:
     _threads = 1;
 #endif
   };
+  //////////////////////////////////////////////////////////////////////
+  // Optional comms progress thread, pinned to a reserved core; see
+  // ProgressThread.cc. Work posted runs concurrently with the OpenMP
+  // compute threads; ProgressWait blocks until all of it has finished.
+  //////////////////////////////////////////////////////////////////////
+  static int  _progress_core;
+  static void StartProgressThread(int core);
+  static void StopProgressThread(void);
+  static int  ProgressThreadRunning(void);
+  static void ProgressPost(std::function<void(void)> work);
+  static void ProgressWait(void);
+
   static int GetHyperThreads(void) { assert(_threads%_cores ==0); return _threads/_cores; };
   static int GetCores(void)   { return _cores; };
   static int GetThreads(void) { return _threads; };
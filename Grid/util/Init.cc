@@ -86,6 +86,9 @@ int GridThread::_threads =1;
 int GridThread::_hyperthreads=1;
 int GridThread::_cores=1;
 
+int GridReproducibleReduction::Enabled=0;
+int64_t GaugeStaplesStatic::MinLocalVolume=16*16*16*16;
+
 
 const Coordinate &GridDefaultLatt(void)     {return Grid_default_latt;};
 const Coordinate &GridDefaultMpi(void)      {return Grid_default_mpi;};
@@ -428,14 +431,21 @@ void Grid_init(int *argc,char ***argv)
     std::cout<<GridLogMessage<<"  --comms-concurrent : Asynchronous MPI calls; several dirs at a time "<<std::endl;    
     std::cout<<GridLogMessage<<"  --comms-sequential : Synchronous MPI calls; one dirs at a time "<<std::endl;    
     std::cout<<GridLogMessage<<"  --comms-overlap    : Overlap comms with compute "<<std::endl;    
+    std::cout<<GridLogMessage<<"  --comms-overlap-by-point : Overlap comms with compute; Wilson exterior as each direction completes "<<std::endl;
+    std::cout<<GridLogMessage<<"  --comms-progress-thread  : Dedicated thread progresses MPI and merges halos while the interior is computed "<<std::endl;
+    std::cout<<GridLogMessage<<"  --comms-progress-core n  : Pin the progress thread to core n; default is the last core available "<<std::endl;
     std::cout<<GridLogMessage<<std::endl;
     std::cout<<GridLogMessage<<"  --dslash-generic: Wilson kernel for generic Nc"<<std::endl;    
     std::cout<<GridLogMessage<<"  --dslash-unroll : Wilson kernel for Nc=3"<<std::endl;    
     std::cout<<GridLogMessage<<"  --dslash-asm    : Wilson kernel for AVX512"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --dslash-fused-schur : Mobius/DWF Schur complement in two fused sweeps; Wilson comms then compute, overrides --comms-overlap"<<std::endl;
     std::cout<<GridLogMessage<<std::endl;
     std::cout<<GridLogMessage<<"  --lebesgue      : Cache oblivious Lebesgue curve/Morton order/Z-graph stencil looping"<<std::endl;    
     std::cout<<GridLogMessage<<"  --cacheblocking n.m.o.p : Hypercuboidal cache blocking"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
+    std::cout<<GridLogMessage<<"  --reproducible-reductions : bitwise reproducible norm2, innerProduct and sliceSum for any thread and MPI layout"<<std::endl;
+    std::cout<<GridLogMessage<<"  --gauge-staples-min-volume n : padded cell staples in the gauge forces from n local sites up; default 16^4"<<std::endl;
+    std::cout<<GridLogMessage<<std::endl;
     exit(EXIT_SUCCESS);
   }
 
@@ -458,10 +468,23 @@ void Grid_init(int *argc,char ***argv)
   if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-overlap") ){
     WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
     StaggeredKernelsStatic::Comms = StaggeredKernelsStatic::CommsAndCompute;
+  } else if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-overlap-by-point") ){
+    WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
+    WilsonKernelsStatic::Exterior = WilsonKernelsStatic::ExteriorByPoint;
+    StaggeredKernelsStatic::Comms = StaggeredKernelsStatic::CommsAndCompute;
   } else {
     WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsThenCompute;
     StaggeredKernelsStatic::Comms = StaggeredKernelsStatic::CommsThenCompute;
   }
+  // The fused sweeps complete the halo exchange before computing
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-fused-schur") ){
+    if ( WilsonKernelsStatic::Comms != WilsonKernelsStatic::CommsThenCompute ) {
+      std::cout << GridLogWarning << "--dslash-fused-schur: Wilson kernel comms are no longer overlapped with compute" << std::endl;
+    }
+    WilsonKernelsStatic::FusedSchur = 1;
+    WilsonKernelsStatic::Comms      = WilsonKernelsStatic::CommsThenCompute;
+    WilsonKernelsStatic::Exterior   = WilsonKernelsStatic::ExteriorAfterComms;
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-concurrent") ){
     CartesianCommunicator::SetCommunicatorPolicy(CartesianCommunicator::CommunicatorPolicyConcurrent);
   }
@@ -484,6 +507,15 @@ void Grid_init(int *argc,char ***argv)
     arg= GridCmdOptionPayload(*argv,*argv+*argc,"--cacheblocking");
     GridCmdOptionIntVector(arg,LebesgueOrder::Block);
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--reproducible-reductions") ){
+    GridReproducibleReduction::Enabled=1;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--gauge-staples-min-volume") ){
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--gauge-staples-min-volume");
+    int vol;
+    GridCmdOptionInt(arg,vol);
+    GaugeStaplesStatic::MinLocalVolume=vol;
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--notimestamp") ){
     GridLogTimestamp(0);
   } else {
@@ -494,6 +526,39 @@ void Grid_init(int *argc,char ***argv)
 		  Grid_default_latt,
 		  Grid_default_mpi);
 
+  //////////////////////////////////////////////////////////
+  // Comms progress thread; the one comms thread, so MPI
+  // calls stay serialised between it and the compute threads
+  //////////////////////////////////////////////////////////
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-progress-thread") ){
+    if ( CartesianCommunicator::nCommThreads > 1 ) {
+      std::cout << "Option --comms-progress-thread requires a single comms thread. Exiting." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    if ( WilsonKernelsStatic::Exterior == WilsonKernelsStatic::ExteriorByPoint ) {
+      std::cout << "Option --comms-progress-thread cannot be combined with --comms-overlap-by-point. Exiting." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+#if defined (GRID_COMMS_MPI) || defined (GRID_COMMS_MPI3) || defined (GRID_COMMS_MPIT)
+    // MPI may have been initialised by the caller with a weaker level;
+    // FUNNELED is not enough since the progress thread is not the main thread
+    int provided;
+    MPI_Query_thread(&provided);
+    if ( provided < MPI_THREAD_SERIALIZED ) {
+      std::cout << "Option --comms-progress-thread requires MPI_THREAD_SERIALIZED or better. Exiting." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+#endif
+    int core=-1;
+    if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-progress-core") ){
+      arg= GridCmdOptionPayload(*argv,*argv+*argc,"--comms-progress-core");
+      GridCmdOptionInt(arg,core);
+    }
+    GridThread::StartProgressThread(core);
+    std::cout << GridLogMessage << "Comms progress thread on core "<<GridThread::_progress_core
+	      << "; "<<GridThread::GetThreads()<<" compute threads"<<std::endl;
+  }
+
 
   if( GridCmdOptionExists(*argv,*argv+*argc,"--decomposition") ){
     std::cout<<GridLogMessage<<"Grid Default Decomposition patterns\n";
@@ -510,6 +575,8 @@ void Grid_init(int *argc,char ***argv)
 
 void Grid_finalize(void)
 {
+  if ( MemoryProfiler::debug ) MemoryManager::PrintCacheStatistics();
+  GridThread::StopProgressThread();
 #if defined (GRID_COMMS_MPI) || defined (GRID_COMMS_MPI3) || defined (GRID_COMMS_MPIT)
   MPI_Finalize();
   Grid_unquiesce_nodes();
@@ -388,6 +388,46 @@ int main (int argc, char ** argv)
 
   assert(norm2(src_e)<1.0e-4);
   assert(norm2(src_o)<1.0e-4);
+
+  std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+  std::cout << GridLogMessage<< "* Benchmarking compressed link DomainWallFermion::DhopEO " <<std::endl;
+  std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+  {
+    DomainWallFermion12R Dw12(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+    DomainWallFermion8R  Dw8 (Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+
+    LatticeFermion r_c (FrbGrid);
+    double volume=Ls;  for(int mu=0;mu<Nd;mu++) volume=volume*latt4[mu];
+    double flops=(single_site_flops*volume*ncall)/2.0;
+
+    // Reals stored per link: 18 full, 12 and 8 compressed
+    std::vector<int> link_reals({18,12,8});
+    for(int c=0;c<link_reals.size();c++){
+      auto DhopEO = [&](void) {
+	if (c==0) Dw  .DhopEO(src_o,r_c,DaggerNo);
+	if (c==1) Dw12.DhopEO(src_o,r_c,DaggerNo);
+	if (c==2) Dw8 .DhopEO(src_o,r_c,DaggerNo);
+      };
+      DhopEO();
+      FGrid->Barrier();
+      double t0=usecond();
+      for(int i=0;i<ncall;i++) DhopEO();
+      double t1=usecond();
+      FGrid->Barrier();
+
+      // mem: Nd Wilson * Ls, Nd gauge, one checkerboard
+      double link_bytes = (volume/Ls/2.0) * 2*Nd*link_reals[c]*sizeof(Real);
+      double data_mem   = ((volume/2.0) * (2*Nd+1)*Nd*Nc*sizeof(Complex) + link_bytes) * ncall / (1024.*1024.*1024.);
+
+      Dw.DhopEO(src_o,r_e,DaggerNo);
+      r_c = r_c - r_e;
+      std::cout<<GridLogMessage << link_reals[c] << " real links: Deo mflop/s = "<< flops/(t1-t0)
+	       << " mem GiB/s (base 2) = " << 1000000. * data_mem/(t1-t0)
+	       << " link MiB per call = "  << link_bytes/(1024.*1024.)
+	       << " norm diff " << norm2(r_c) <<std::endl;
+      assert(norm2(r_c)<1.0e-4);
+    }
+  }
   Grid_finalize();
   exit(0);
 }
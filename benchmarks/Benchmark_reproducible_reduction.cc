@@ -0,0 +1,95 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./benchmarks/Benchmark_reproducible_reduction.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+#define LMAX (24)
+#define LMIN (8)
+#define LADD (8)
+
+  int64_t Nloop=20;
+
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  int64_t threads = GridThread::GetThreads();
+  std::cout<<GridLogMessage << "Grid is setup to use "<<threads<<" threads"<<std::endl;
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking reproducible reductions against the fast path, LatticeFermion"<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "  L  "<<"\t\t"<<"op"<<"\t\t"<<"fast (us)"<<"\t"<<"reproducible (us)"<<"\t"<<"overhead"<<std::endl;
+  std::cout<<GridLogMessage << "----------------------------------------------------------"<<std::endl;
+
+  for(int lat=LMIN;lat<=LMAX;lat+=LADD){
+
+    Coordinate latt_size  ({lat*mpi_layout[0],lat*mpi_layout[1],lat*mpi_layout[2],lat*mpi_layout[3]});
+    GridCartesian     Grid(latt_size,simd_layout,mpi_layout);
+    GridParallelRNG          pRNG(&Grid);      pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+    LatticeFermion x(&Grid); gaussian(pRNG,x);
+    LatticeFermion y(&Grid); gaussian(pRNG,y);
+    std::vector<LatticeFermion::scalar_object> slice;
+
+    double t_fast[3], t_repro[3];
+    RealD    nrm[2];
+    ComplexD ip[2];
+
+    for(int mode=0;mode<2;mode++){
+      GridReproducibleReduction::Enabled = mode;
+      double *t = mode ? t_repro : t_fast;
+
+      double start=usecond();
+      for(int64_t i=0;i<Nloop;i++) nrm[mode] = norm2(x);
+      t[0] = (usecond()-start)/Nloop;
+
+      start=usecond();
+      for(int64_t i=0;i<Nloop;i++) ip[mode] = innerProduct(x,y);
+      t[1] = (usecond()-start)/Nloop;
+
+      start=usecond();
+      for(int64_t i=0;i<Nloop;i++) sliceSum(x,slice,Nd-1);
+      t[2] = (usecond()-start)/Nloop;
+    }
+    GridReproducibleReduction::Enabled = 0;
+
+    const char *name[3] = {"norm2","innerProduct","sliceSum"};
+    for(int op=0;op<3;op++){
+      std::cout<<GridLogMessage<<std::setprecision(3) << lat<<"\t\t"<<name[op]<<"\t"<<t_fast[op]<<"\t\t"<<t_repro[op]
+	       <<"\t\t"<<t_repro[op]/t_fast[op]<<std::endl;
+    }
+    std::cout<<GridLogMessage<<std::setprecision(17)<<"\tnorm2 fast "<<nrm[0]<<" reproducible "<<nrm[1]<<std::endl;
+    std::cout<<GridLogMessage<<std::setprecision(17)<<"\tinnerProduct fast "<<ip[0]<<" reproducible "<<ip[1]<<std::endl;
+  }
+
+  Grid_finalize();
+}
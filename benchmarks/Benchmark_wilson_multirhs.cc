@@ -0,0 +1,107 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./benchmarks/Benchmark_wilson_multirhs.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  int nrhs=12;
+  for(int i=0;i<argc;i++)
+    if(std::string(argv[i]) == "-nrhs"){
+      std::stringstream ss(argv[i+1]); ss >> nrhs;
+    }
+
+  int64_t Nloop=100;
+  long unsigned int single_site_flops = 8*Nc*(7+16*Nc);
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * BGrid   = SpaceTimeGrid::makeFiveDimGrid(nrhs,UGrid);
+  GridRedBlackCartesian * BrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(nrhs,UGrid);
+
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeGaugeField Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  std::vector<LatticeFermion> src(nrhs,UGrid), res(nrhs,UGrid);
+  for(int r=0;r<nrhs;r++) gaussian(RNG4,src[r]);
+
+  RealD mass=0.1;
+  WilsonFermionR Dw(Umu,*UGrid,*UrbGrid,mass);
+  WilsonFermionMultiRHS<WilsonImplR> Dm(Umu,*BGrid,*BrbGrid,*UGrid,*UrbGrid,mass);
+
+  LatticeFermion bsrc(BGrid), bres(BGrid);
+  InsertRHS(src,bsrc);
+
+  double volume=1; for(int mu=0;mu<Nd;mu++) volume=volume*UGrid->_fdimensions[mu];
+  double flops = single_site_flops*volume*nrhs*Nloop;
+  // Fermion in and out per rhs, links once per call
+  double fermion_bytes = volume * (2*Nd+1)*Nd*Nc*sizeof(Complex);
+  double link_bytes    = volume * 2*Nd*Nc*Nc*sizeof(Complex);
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking Wilson Dhop on "<<nrhs<<" right hand sides, one at a time and batched"<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+
+  for(int r=0;r<nrhs;r++) Dw.Dhop(src[r],res[r],DaggerNo);
+  UGrid->Barrier();
+  double t0=usecond();
+  for(int64_t i=0;i<Nloop;i++){
+    for(int r=0;r<nrhs;r++) Dw.Dhop(src[r],res[r],DaggerNo);
+  }
+  UGrid->Barrier();
+  double t1=usecond();
+  double data = (fermion_bytes+link_bytes)*nrhs*Nloop/(1024.*1024.*1024.);
+  std::cout<<GridLogMessage << "single  : "<<(t1-t0)/Nloop<<" us per "<<nrhs<<" rhs; mflop/s = "<<flops/(t1-t0)
+	   <<" ; mem GiB/s (base 2) = "<<1000000.*data/(t1-t0)<<std::endl;
+
+  Dm.Dhop(bsrc,bres,DaggerNo);
+  UGrid->Barrier();
+  t0=usecond();
+  for(int64_t i=0;i<Nloop;i++){
+    Dm.Dhop(bsrc,bres,DaggerNo);
+  }
+  UGrid->Barrier();
+  t1=usecond();
+  data = (fermion_bytes*nrhs+link_bytes)*Nloop/(1024.*1024.*1024.);
+  std::cout<<GridLogMessage << "batched : "<<(t1-t0)/Nloop<<" us per "<<nrhs<<" rhs; mflop/s = "<<flops/(t1-t0)
+	   <<" ; mem GiB/s (base 2) = "<<1000000.*data/(t1-t0)<<std::endl;
+
+  t0=usecond();
+  for(int64_t i=0;i<Nloop;i++){
+    Dm.DhopMultiRHS(src,res,DaggerNo);
+  }
+  t1=usecond();
+  std::cout<<GridLogMessage << "batched with insert/extract : "<<(t1-t0)/Nloop<<" us per "<<nrhs<<" rhs"<<std::endl;
+
+  Dm.Report();
+  Grid_finalize();
+}
@@ -0,0 +1,97 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_binary_async_io.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Byte compare two files
+bool SameFile(const std::string &a,const std::string &b)
+{
+  std::ifstream fa(a,std::ios::binary);
+  std::ifstream fb(b,std::ios::binary);
+  std::vector<char> da((std::istreambuf_iterator<char>(fa)),std::istreambuf_iterator<char>());
+  std::vector<char> db((std::istreambuf_iterator<char>(fb)),std::istreambuf_iterator<char>());
+  return (da.size()>0) && (da==db);
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian Grid(latt_size,simd_layout,mpi_layout);
+
+  GridParallelRNG pRNG(&Grid);
+  GridSerialRNG   sRNG;
+  pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  sRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeGaugeField U(&Grid);
+  SU<Nc>::HotConfiguration(pRNG,U);
+
+  int traj = 10;
+  CheckpointerParameters SyncPar ("ckpoint_sync_lat","ckpoint_sync_rng",1);
+  CheckpointerParameters AsyncPar("ckpoint_async_lat","ckpoint_async_rng",1);
+
+  BinaryHmcCheckpointer<PeriodicGimplR> Sync(SyncPar);
+  BinaryHmcCheckpointer<PeriodicGimplR> Async(AsyncPar,true);
+
+  Sync.TrajectoryComplete(traj,U,sRNG,pRNG);
+  Async.TrajectoryComplete(traj,U,sRNG,pRNG);
+
+  // The snapshot is taken before returning: clobber the field and RNG
+  LatticeGaugeField Usave = U;
+  SU<Nc>::HotConfiguration(pRNG,U);
+
+  Async.Fence();
+
+  int ok = 1;
+  if ( Grid.IsBoss() ) {
+    ok = SameFile("ckpoint_sync_lat.10","ckpoint_async_lat.10")
+      && SameFile("ckpoint_sync_rng.10","ckpoint_async_rng.10");
+    std::ifstream partial("ckpoint_async_lat.10.partial");
+    ok = ok && !partial.good();
+  }
+  Grid.Broadcast(0,(void *)&ok,sizeof(ok));
+  std::cout << GridLogMessage << "Asynchronous checkpoint identical to synchronous: " << ok << std::endl;
+  assert(ok);
+
+  // Restore and compare
+  GridParallelRNG pRNGb(&Grid);
+  GridSerialRNG   sRNGb;
+  LatticeGaugeField Ub(&Grid);
+  Async.CheckpointRestore(traj,Ub,sRNGb,pRNGb);
+  Ub = Ub - Usave;
+  std::cout << GridLogMessage << "Restored field difference " << norm2(Ub) << std::endl;
+  assert(norm2(Ub)==0.0);
+
+  Grid_finalize();
+}
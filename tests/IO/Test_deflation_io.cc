@@ -0,0 +1,132 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_deflation_io.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+const int nbasis = 8;
+const int neig   = 12;
+
+typedef DeflationSpaceIO<vSpinColourVector,vTComplex,nbasis> DefIO;
+typedef DefIO::FineField   FineField;
+typedef DefIO::CoarseField CoarseField;
+
+template<class Field>
+RealD maxRelDiff(const std::vector<Field> &a,const std::vector<Field> &b)
+{
+  assert(a.size()==b.size());
+  RealD worst = 0.0;
+  for(int i=0;i<a.size();i++){
+    Field diff = a[i] - b[i];
+    worst = std::max(worst,std::sqrt(norm2(diff)/norm2(a[i])));
+  }
+  return worst;
+}
+
+void checkRoundTrip(const std::string &stem,int precision,RealD tol,
+		    GridBase *FrbGrid,GridBase *CoarseGrid,
+		    std::vector<FineField> &subspace,std::vector<RealD> &eval_fine,
+		    std::vector<CoarseField> &evec_coarse,std::vector<RealD> &eval_coarse)
+{
+  DefIO::write(stem,subspace,eval_fine,evec_coarse,eval_coarse,precision);
+
+  std::vector<FineField>   subspace_r;
+  std::vector<CoarseField> evec_coarse_r;
+  std::vector<RealD>       eval_fine_r, eval_coarse_r;
+  DefIO::read(stem,FrbGrid,CoarseGrid,subspace_r,eval_fine_r,evec_coarse_r,eval_coarse_r);
+
+  RealD dfine   = maxRelDiff(subspace,subspace_r);
+  RealD dcoarse = maxRelDiff(evec_coarse,evec_coarse_r);
+  std::cout << GridLogMessage << precision << " bit: fine basis rel. error "<< dfine
+	    << " coarse evec rel. error "<< dcoarse << std::endl;
+  assert(dfine   < tol);
+  assert(dcoarse < tol);
+  assert(subspace_r[0].Checkerboard()==subspace[0].Checkerboard());
+  for(int i=0;i<neig;i++) assert(eval_coarse_r[i]==eval_coarse[i]);
+
+  ////////////////////////////////////////////////////////////
+  // Streaming guesser must match the resident one on the data
+  // as read back
+  ////////////////////////////////////////////////////////////
+  LocalCoherenceDeflatedGuesser<FineField,CoarseField> Resident(subspace_r,evec_coarse_r,eval_coarse_r);
+  StreamingLocalCoherenceDeflatedGuesser<vSpinColourVector,vTComplex,nbasis> Stream(stem,FrbGrid,CoarseGrid);
+  StreamingLocalCoherenceDeflatedGuesser<vSpinColourVector,vTComplex,nbasis> StreamAll(stem,FrbGrid,CoarseGrid,true);
+
+  FineField src(FrbGrid), g0(FrbGrid), g1(FrbGrid), g2(FrbGrid);
+  src = subspace[0] + 0.5*subspace[3];
+  Resident (src,g0);
+  Stream   (src,g1);
+  StreamAll(src,g2);
+  RealD n0 = norm2(g0);
+  g1 = g1 - g0;
+  g2 = g2 - g0;
+  std::cout << GridLogMessage << precision << " bit: streamed guess rel. diff "
+	    << std::sqrt(norm2(g1)/n0) << " " << std::sqrt(norm2(g2)/n0) << std::endl;
+  assert(std::sqrt(norm2(g1)/n0) < 1.0e-12);
+  assert(std::sqrt(norm2(g2)/n0) < 1.0e-12);
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt = GridDefaultLatt();
+  Coordinate clatt(Nd);
+  for(int d=0;d<Nd;d++) clatt[d] = latt[d]/4;
+
+  GridCartesian         *UGrid   = SpaceTimeGrid::makeFourDimGrid(latt, GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian *FrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian     *CoarseGrid  = SpaceTimeGrid::makeFourDimGrid(clatt, GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+
+  GridParallelRNG RNG(UGrid);      RNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  GridParallelRNG CRNG(CoarseGrid); CRNG.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+
+  FineField full(UGrid);
+  std::vector<FineField> subspace(nbasis,FrbGrid);
+  std::vector<RealD>     eval_fine(nbasis);
+  for(int v=0;v<nbasis;v++){
+    gaussian(RNG,full);
+    pickCheckerboard(Odd,subspace[v],full);
+    eval_fine[v] = 0.1*(v+1);
+  }
+  Lattice<vTComplex> ip(CoarseGrid);
+  blockOrthogonalise(ip,subspace);
+  blockOrthogonalise(ip,subspace);
+
+  std::vector<CoarseField> evec_coarse(neig,CoarseGrid);
+  std::vector<RealD>       eval_coarse(neig);
+  for(int i=0;i<neig;i++){
+    gaussian(CRNG,evec_coarse[i]);
+    evec_coarse[i] = evec_coarse[i]*(1.0/std::sqrt(norm2(evec_coarse[i])));
+    eval_coarse[i] = 1.0+i;
+  }
+
+  checkRoundTrip("deflation_fp16",16,1.0e-3,FrbGrid,CoarseGrid,subspace,eval_fine,evec_coarse,eval_coarse);
+  checkRoundTrip("deflation_fp32",32,1.0e-6,FrbGrid,CoarseGrid,subspace,eval_fine,evec_coarse,eval_coarse);
+
+  Grid_finalize();
+}
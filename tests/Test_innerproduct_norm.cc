@@ -122,5 +122,35 @@ int main(int argc, char** argv) {
     std::cout << GridLogMessage << "Single: all checks passed" << std::endl;
   }
 
+  { // fused multi-dot against a set of fields
+    const int Nvec = 6;
+    std::vector<LatticeFermionD> v_d(Nvec, Grid_d);
+    for(int k = 0; k < Nvec; ++k) random(pRNG_d, v_d[k]);
+
+    std::vector<ComplexD> ip_ref(Nvec), ip_res;
+
+    sw_ref.Reset();
+    sw_ref.Start();
+    for(int i = 0; i < nIter; ++i) {
+      for(int k = 0; k < Nvec; ++k) ip_ref[k] = innerProduct(v_d[k], x_d);
+    }
+    sw_ref.Stop();
+
+    sw_res.Reset();
+    sw_res.Start();
+    for(int i = 0; i < nIter; ++i) { innerProductMulti(ip_res, v_d, x_d); }
+    sw_res.Stop();
+
+    // clang-format off
+    for(int k = 0; k < Nvec; ++k) {
+      std::cout << GridLogMessage << "Multi: ip_ref["<<k<<"] = " << ip_ref[k] << " ip_res = " << ip_res[k] << " diff = " << ip_ref[k]-ip_res[k] << std::endl;
+      assert(ip_ref[k] == ip_res[k]);
+    }
+    std::cout << GridLogMessage << "Multi: time_ref = " << sw_ref.Elapsed() << " time_res = " << sw_res.Elapsed() << std::endl;
+    // clang-format on
+
+    std::cout << GridLogMessage << "Multi: all checks passed" << std::endl;
+  }
+
   Grid_finalize();
 }
@@ -98,7 +98,8 @@ int main(int argc, char ** argv) {
 	}
 
 	SimpleCompressor<vobj> compress;
-	myStencil.HaloExchange(Foo,compress);
+	myStencil.HaloExchange(Bar,compress); // records the exchange plan
+	myStencil.HaloExchange(Foo,compress); // replays it
 
 	Bar = Cshift(Foo,dir,disp);
 
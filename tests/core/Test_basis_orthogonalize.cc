@@ -0,0 +1,94 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_basis_orthogonalize.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Build an orthonormal basis with the block CGS2 basisOrthogonalize, spanning
+// more than one multi-dot block. The basis must stay orthonormal and each
+// input vector must be reproduced by its projection onto the basis so far.
+template<class Field>
+void checkOrthogonalize(GridBase *grid,GridParallelRNG &RNG,int Nvec)
+{
+  std::vector<Field> basis(Nvec,grid);
+  std::vector<Field> input(Nvec,grid);
+
+  Field g(grid);
+  Field gprev(grid);
+  for(int k=0;k<Nvec;k++){
+    gaussian(RNG,g);
+    // Nearly dependent directions stress the reorthogonalisation
+    if ( k>0 ) input[k] = g + 1.0e2*gprev;
+    else       input[k] = g;
+    gprev = g;
+
+    Field w(grid);
+    w = input[k];
+    basisOrthogonalize(basis,w,k);
+    basis[k] = w*(1.0/std::sqrt(norm2(w)));
+  }
+
+  RealD maxoff = 0.0;
+  RealD maxdiag= 0.0;
+  for(int i=0;i<Nvec;i++){
+    for(int j=0;j<=i;j++){
+      ComplexD ip = innerProduct(basis[i],basis[j]);
+      if ( i==j ) maxdiag = std::max(maxdiag,std::abs(ip-1.0));
+      else        maxoff  = std::max(maxoff ,std::abs(ip));
+    }
+  }
+  RealD maxres = 0.0;
+  for(int k=0;k<Nvec;k++){
+    Field r(grid);
+    r = input[k];
+    for(int j=0;j<=k;j++) r = r - innerProduct(basis[j],input[k])*basis[j];
+    maxres = std::max(maxres,std::sqrt(norm2(r)/norm2(input[k])));
+  }
+  RealD eps = (getPrecision<Field>::value == 2) ? 1.0e-12 : 1.0e-5;
+  std::cout << GridLogMessage << " Nvec "<<Nvec<<" precision "<<getPrecision<Field>::value
+	    << " max |<vi,vj>| "<<maxoff<<" max |<vi,vi>-1| "<<maxdiag
+	    << " max relative projection residual "<<maxres<<std::endl;
+  assert(maxoff  < eps);
+  assert(maxdiag < eps);
+  assert(maxres  < eps);
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *GridD = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()), GridDefaultMpi());
+  GridCartesian *GridF = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexF::Nsimd()), GridDefaultMpi());
+
+  GridParallelRNG RNGD(GridD); RNGD.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  GridParallelRNG RNGF(GridF); RNGF.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  checkOrthogonalize<LatticeFermionD>(GridD,RNGD,80);
+  checkOrthogonalize<LatticeFermionF>(GridF,RNGF,80);
+
+  Grid_finalize();
+}
@@ -0,0 +1,121 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_comms_progress_thread.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Overlapped Dhop and DhopEO, with and without the progress thread,
+// must agree with comms then compute
+template<class Action,class Field>
+void checkProgress(const std::string &name,Action &Dw,const Field &src,const Field &src_o)
+{
+  int comms = WilsonKernelsStatic::Comms;
+  int running = GridThread::ProgressThreadRunning();
+
+  GridBase *grid   = src.Grid();
+  GridBase *rbgrid = src_o.Grid();
+  Field ref(grid), res(grid), diff(grid);
+  Field ref_e(rbgrid), res_e(rbgrid), diff_e(rbgrid);
+
+  const int Nrep = 10;
+  for(int dag=0;dag<2;dag++){
+
+    WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsThenCompute;
+    Dw.Dhop  (src  ,ref  ,dag);
+    Dw.DhopEO(src_o,ref_e,dag);
+
+    WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
+    for(int progress=0;progress<2;progress++){
+      if ( progress ) GridThread::StartProgressThread(GridThread::_progress_core);
+      else            GridThread::StopProgressThread();
+
+      Dw.ZeroCounters();
+      for(int rep=0;rep<Nrep;rep++){
+	Dw.Dhop  (src  ,res  ,dag);
+	Dw.DhopEO(src_o,res_e,dag);
+	diff   = res - ref;
+	diff_e = res_e - ref_e;
+	RealD d  = norm2(diff)/norm2(ref);
+	RealD de = norm2(diff_e)/norm2(ref_e);
+	if ( rep==0 ) {
+	  std::cout << GridLogMessage << name << " dag " << dag << " progress thread " << progress
+		    << " Dhop rel diff " << d << " DhopEO rel diff " << de << std::endl;
+	}
+	assert(d  < 1.0e-24);
+	assert(de < 1.0e-24);
+      }
+      Dw.Report();
+    }
+  }
+  if ( !running ) GridThread::StopProgressThread();
+  WilsonKernelsStatic::Comms = comms;
+}
+
+int main(int argc, char **argv) {
+  Grid_init(&argc, &argv);
+
+  const int Ls = 8;
+
+  GridCartesian         *UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian *UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         *FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian *FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG RNG5(FGrid); RNG5.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  LatticeGaugeField Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  ////////////////////////////////////////////////////////////////
+  // Four dimensional Wilson
+  ////////////////////////////////////////////////////////////////
+  {
+    LatticeFermion src(UGrid);    random(RNG4,src);
+    LatticeFermion src_o(UrbGrid);
+    pickCheckerboard(Odd,src_o,src);
+    RealD mass=0.1;
+    WilsonFermionR Dw(Umu,*UGrid,*UrbGrid,mass);
+    checkProgress("Wilson",Dw,src,src_o);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Five dimensional domain wall
+  ////////////////////////////////////////////////////////////////
+  {
+    LatticeFermion src(FGrid);    random(RNG5,src);
+    LatticeFermion src_o(FrbGrid);
+    pickCheckerboard(Odd,src_o,src);
+    RealD mass=0.1;
+    RealD M5  =1.8;
+    DomainWallFermionR Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+    checkProgress("DomainWall",Ddwf,src,src_o);
+  }
+
+  std::cout << GridLogMessage << "all checks passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,122 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_compressed_links.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Compressed operator must agree with the full-link one to rounding,
+// for every kernel option, both daggers and both checkerboards. The
+// reference uses the generic kernel; Asm only exists on some targets.
+template<class Action,class RefAction,class Field>
+void CompareOperators(std::string name,Action &D,RefAction &Dref,
+		      Field &src,GridBase *FGrid,GridBase *FrbGrid)
+{
+  std::vector<int> opts({WilsonKernelsStatic::OptGeneric,
+                         WilsonKernelsStatic::OptHandUnroll,
+                         WilsonKernelsStatic::OptInlineAsm});
+  std::vector<std::string> optnames({"Generic","HandUnroll","InlineAsm"});
+
+  Field res(FGrid), ref(FGrid), err(FGrid);
+  Field src_o(FrbGrid), res_e(FrbGrid), ref_e(FrbGrid), err_e(FrbGrid);
+  pickCheckerboard(Odd,src_o,src);
+
+  for(int o=0;o<opts.size();o++){
+    for(int dag=0;dag<2;dag++){
+      WilsonKernelsStatic::Opt = WilsonKernelsStatic::OptGeneric;
+      Dref.Dhop  (src,ref,dag);
+      Dref.DhopEO(src_o,ref_e,dag);
+
+      WilsonKernelsStatic::Opt = opts[o];
+      D.Dhop  (src,res,dag);
+      D.DhopEO(src_o,res_e,dag);
+      err = res-ref;
+      RealD n = norm2(err)/norm2(ref);
+      std::cout << GridLogMessage << name << " " << optnames[o] << " dag " << dag
+		<< " Dhop  rel err " << n << std::endl;
+      assert(n < 1.0e-24);
+
+      err_e = res_e-ref_e;
+      n = norm2(err_e)/norm2(ref_e);
+      std::cout << GridLogMessage << name << " " << optnames[o] << " dag " << dag
+		<< " DhopEO rel err " << n << std::endl;
+      assert(n < 1.0e-24);
+    }
+  }
+  WilsonKernelsStatic::Opt = WilsonKernelsStatic::OptGeneric;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=4;
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+								     GridDefaultSimd(Nd,vComplexD::Nsimd()),
+								     GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG RNG5(FGrid); RNG5.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  LatticeGaugeFieldD Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  LatticeFermionD src4(UGrid); gaussian(RNG4,src4);
+  LatticeFermionD src5(FGrid); gaussian(RNG5,src5);
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+
+  // Antiperiodic in time exercises the in-kernel boundary phase
+  std::vector<Complex> boundary_phases(Nd,1.0);
+  boundary_phases[Nd-1] = -1.0;
+  WilsonImplParams params(boundary_phases);
+
+  std::cout << GridLogMessage << "Link bytes per site: full " << sizeof(WilsonImplD::SiteDoubledGaugeField)
+	    << " 12 real " << sizeof(WilsonImpl12D::SiteDoubledGaugeField)
+	    << " 8 real "  << sizeof(WilsonImpl8D::SiteDoubledGaugeField) << std::endl;
+
+  WilsonFermionD   Dw  (Umu,*UGrid,*UrbGrid,mass,params);
+  WilsonFermion12D Dw12(Umu,*UGrid,*UrbGrid,mass,params);
+  WilsonFermion8D  Dw8 (Umu,*UGrid,*UrbGrid,mass,params);
+
+  CompareOperators("WilsonFermion12D",Dw12,Dw,src4,UGrid,UrbGrid);
+  CompareOperators("WilsonFermion8D" ,Dw8 ,Dw,src4,UGrid,UrbGrid);
+
+  DomainWallFermionD   Ddwf  (Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,params);
+  DomainWallFermion12D Ddwf12(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,params);
+  DomainWallFermion8D  Ddwf8 (Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,params);
+
+  CompareOperators("DomainWallFermion12D",Ddwf12,Ddwf,src5,FGrid,FrbGrid);
+  CompareOperators("DomainWallFermion8D" ,Ddwf8 ,Ddwf,src5,FGrid,FrbGrid);
+
+  std::cout << GridLogMessage << "all checks passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,124 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_dslash_overlap_point.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+struct CommsMode {
+  const char *name;
+  int comms;
+  int exterior;
+};
+
+// Dhop and DhopEO in each comms mode must agree with comms then compute
+template<class Action,class Field>
+void checkModes(const std::string &name,Action &Dw,const Field &src,const Field &src_o)
+{
+  CommsMode modes[3] = {
+    { "comms then compute", WilsonKernelsStatic::CommsThenCompute, WilsonKernelsStatic::ExteriorAfterComms },
+    { "overlapped"        , WilsonKernelsStatic::CommsAndCompute , WilsonKernelsStatic::ExteriorAfterComms },
+    { "overlapped by point",WilsonKernelsStatic::CommsAndCompute , WilsonKernelsStatic::ExteriorByPoint    }
+  };
+  int comms    = WilsonKernelsStatic::Comms;
+  int exterior = WilsonKernelsStatic::Exterior;
+
+  GridBase *grid   = src.Grid();
+  GridBase *rbgrid = src_o.Grid();
+  Field ref(grid), res(grid), diff(grid);
+  Field ref_e(rbgrid), res_e(rbgrid), diff_e(rbgrid);
+
+  for(int dag=0;dag<2;dag++){
+    for(int m=0;m<3;m++){
+      WilsonKernelsStatic::Comms    = modes[m].comms;
+      WilsonKernelsStatic::Exterior = modes[m].exterior;
+      // twice, so the second call replays the recorded exchange
+      for(int rep=0;rep<2;rep++){
+	Dw.Dhop  (src  ,res  ,dag);
+	Dw.DhopEO(src_o,res_e,dag);
+      }
+      if ( m==0 ) {
+	ref   = res;
+	ref_e = res_e;
+      }
+      diff   = res - ref;
+      diff_e = res_e - ref_e;
+      RealD d  = norm2(diff)/norm2(ref);
+      RealD de = norm2(diff_e)/norm2(ref_e);
+      std::cout << GridLogMessage << name << " dag " << dag << " " << modes[m].name
+		<< " Dhop rel diff " << d << " DhopEO rel diff " << de << std::endl;
+      assert(d  < 1.0e-24);
+      assert(de < 1.0e-24);
+    }
+  }
+  WilsonKernelsStatic::Comms    = comms;
+  WilsonKernelsStatic::Exterior = exterior;
+}
+
+int main(int argc, char **argv) {
+  Grid_init(&argc, &argv);
+
+  const int Ls = 8;
+
+  GridCartesian         *UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian *UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         *FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian *FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG RNG5(FGrid); RNG5.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  LatticeGaugeField Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  ////////////////////////////////////////////////////////////////
+  // Four dimensional Wilson
+  ////////////////////////////////////////////////////////////////
+  {
+    LatticeFermion src(UGrid);    random(RNG4,src);
+    LatticeFermion src_o(UrbGrid);
+    pickCheckerboard(Odd,src_o,src);
+    RealD mass=0.1;
+    WilsonFermionR Dw(Umu,*UGrid,*UrbGrid,mass);
+    checkModes("Wilson",Dw,src,src_o);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Five dimensional domain wall
+  ////////////////////////////////////////////////////////////////
+  {
+    LatticeFermion src(FGrid);    random(RNG5,src);
+    LatticeFermion src_o(FrbGrid);
+    pickCheckerboard(Odd,src_o,src);
+    RealD mass=0.1;
+    RealD M5  =1.8;
+    DomainWallFermionR Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+    checkModes("DomainWall",Ddwf,src,src_o);
+  }
+
+  std::cout << GridLogMessage << "all checks passed" << std::endl;
+  Grid_finalize();
+}
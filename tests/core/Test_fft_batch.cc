@@ -0,0 +1,97 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_fft_batch.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main(int argc, char **argv) {
+  Grid_init(&argc, &argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+  GridParallelRNG pRNG(grid);
+  pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  const int Nf = 5;
+  std::vector<LatticeSpinColourVectorD> src(Nf,grid);
+  std::vector<LatticeSpinColourVectorD> ref(Nf,grid);
+  std::vector<LatticeSpinColourVectorD> res(Nf,grid);
+  std::vector<LatticeSpinColourVectorD> bck(Nf,grid);
+  for(int f=0;f<Nf;f++) gaussian(pRNG,src[f]);
+
+  FFT theFFT(grid);
+  LatticeSpinColourVectorD diff(grid);
+
+  ////////////////////////////////////////////////////////////////
+  // Batched transforms agree with field by field ones
+  ////////////////////////////////////////////////////////////////
+  GridStopWatch Single, Batch;
+  Single.Start();
+  for(int f=0;f<Nf;f++) theFFT.FFT_all_dim(ref[f],src[f],FFT::forward);
+  Single.Stop();
+
+  Batch.Start();
+  theFFT.FFT_all_dim(res,src,FFT::forward);
+  Batch.Stop();
+
+  std::cout << GridLogMessage << Nf << " fields: one at a time " << Single.Elapsed() << " batched " << Batch.Elapsed() << std::endl;
+  for(int f=0;f<Nf;f++){
+    diff = res[f]-ref[f];
+    RealD d = norm2(diff)/norm2(ref[f]);
+    std::cout << GridLogMessage << " field " << f << " rel diff " << d << std::endl;
+    assert(d < 1.0e-24);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Round trip, in place, a dimension at a time
+  ////////////////////////////////////////////////////////////////
+  bck = res;
+  for(int d=0;d<Nd;d++) theFFT.FFT_dim(bck,bck,d,FFT::backward);
+  for(int f=0;f<Nf;f++){
+    diff = bck[f]-src[f];
+    RealD d = norm2(diff)/norm2(src[f]);
+    std::cout << GridLogMessage << " field " << f << " round trip rel diff " << d << std::endl;
+    assert(d < 1.0e-24);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Masked batch matches masked single
+  ////////////////////////////////////////////////////////////////
+  Coordinate mask(Nd,1);
+  mask[Nd-1]=0;
+  theFFT.FFT_dim_mask(res,src,mask,FFT::backward);
+  for(int f=0;f<Nf;f++){
+    theFFT.FFT_dim_mask(ref[f],src[f],mask,FFT::backward);
+    diff = res[f]-ref[f];
+    RealD d = norm2(diff)/norm2(ref[f]);
+    assert(d < 1.0e-24);
+  }
+
+  std::cout << GridLogMessage << "all checks passed" << std::endl;
+  Grid_finalize();
+}
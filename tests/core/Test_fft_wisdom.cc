@@ -0,0 +1,112 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_fft_wisdom.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main(int argc, char **argv) {
+  Grid_init(&argc, &argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+  GridParallelRNG pRNG(grid);
+  pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeSpinColourMatrixD S(grid); gaussian(pRNG,S);
+  LatticeSpinColourMatrixD Sref(grid);
+  LatticeSpinColourMatrixD St(grid);
+  LatticeSpinColourMatrixD Sb(grid);
+  LatticeSpinColourMatrixD diff(grid);
+
+  std::string wisdom("fftw_wisdom_test");
+
+  ////////////////////////////////////////////////////////////////
+  // Estimated plans give the reference; repeat calls hit the cache
+  ////////////////////////////////////////////////////////////////
+  {
+    FFT theFFT(grid);
+    theFFT.FFT_all_dim(Sref,S,FFT::forward);
+  }
+  GridStopWatch Cold, Warm;
+  {
+    FFT theFFT(grid);
+    Warm.Start();
+    theFFT.FFT_all_dim(St,S,FFT::forward);
+    Warm.Stop();
+  }
+  diff = St - Sref;
+  std::cout << GridLogMessage << "cached plans: diff " << norm2(diff) << " time " << Warm.Elapsed() << std::endl;
+  assert(norm2(diff) == 0.0);
+
+  ////////////////////////////////////////////////////////////////
+  // Measured plans agree with estimated ones to rounding
+  ////////////////////////////////////////////////////////////////
+  FFT::SetPlanningEffort(FFT::measure);
+  {
+    FFT theFFT(grid);
+    Cold.Start();
+    theFFT.FFT_all_dim(St,S,FFT::forward);
+    Cold.Stop();
+    theFFT.FFT_all_dim(Sb,St,FFT::backward);
+  }
+  diff = St - Sref;
+  RealD d = norm2(diff)/norm2(Sref);
+  std::cout << GridLogMessage << "measured plans: forward rel diff " << d << " planning+transform " << Cold.Elapsed() << std::endl;
+  assert(d < 1.0e-24);
+  diff = Sb - S;
+  d = norm2(diff)/norm2(S);
+  std::cout << GridLogMessage << "measured plans: round trip rel diff " << d << std::endl;
+  assert(d < 1.0e-24);
+
+  ////////////////////////////////////////////////////////////////
+  // Wisdom survives clearing the cache
+  ////////////////////////////////////////////////////////////////
+  if ( grid->IsBoss() ) assert(FFT::ExportWisdom(wisdom));
+  grid->Barrier();
+  FFT::ClearPlanCache();
+  assert(FFT::ImportWisdom(wisdom));
+  {
+    FFT theFFT(grid);
+    theFFT.FFT_all_dim(St,S,FFT::forward);
+  }
+  diff = St - Sref;
+  d = norm2(diff)/norm2(Sref);
+  std::cout << GridLogMessage << "plans from wisdom: forward rel diff " << d << std::endl;
+  assert(d < 1.0e-24);
+
+  FFT::SetPlanningEffort(FFT::estimate);
+  FFT::ClearPlanCache();
+  grid->Barrier();
+  if ( grid->IsBoss() ) {
+    remove((wisdom+".d").c_str());
+    remove((wisdom+".f").c_str());
+  }
+
+  std::cout << GridLogMessage << "all checks passed" << std::endl;
+  Grid_finalize();
+}
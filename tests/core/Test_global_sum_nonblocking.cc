@@ -0,0 +1,80 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_global_sum_nonblocking.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main(int argc, char **argv) {
+  Grid_init(&argc, &argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+  GridParallelRNG pRNG(grid);
+  pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  const int N = 4;
+  std::vector<LatticeFermion> x(N,grid);
+  for(int i=0;i<N;i++) gaussian(pRNG,x[i]);
+
+  ////////////////////////////////////////////////////
+  // Overlap N independent reductions with local work
+  ////////////////////////////////////////////////////
+  std::vector<ComplexD> blocking(N);
+  std::vector<ComplexD> nonblocking(N);
+  std::vector<CommsRequest_t> reqs(N);
+  for(int i=0;i<N;i++){
+    blocking[i] = innerProduct(x[i],x[(i+1)%N]);
+    nonblocking[i] = rankInnerProduct(x[i],x[(i+1)%N]);
+    grid->GlobalSumVectorBegin(&nonblocking[i],1,reqs[i]);
+  }
+
+  LatticeFermion tmp(grid);
+  tmp = x[0] + x[1];
+
+  grid->GlobalSumVectorComplete(reqs);
+
+  for(int i=0;i<N;i++){
+    RealD diff = abs(blocking[i]-nonblocking[i])/abs(blocking[i]);
+    std::cout << GridLogMessage << " reduction "<<i<<" blocking "<<blocking[i]
+	      <<" non-blocking "<<nonblocking[i]<<" rel diff "<<diff<<std::endl;
+    assert(diff < 1.0e-12);
+  }
+
+  ////////////////////////////////////////////////////
+  // Polled completion
+  ////////////////////////////////////////////////////
+  RealD nrm = norm2(tmp);
+  RealD lnrm = real(rankInnerProduct(tmp,tmp));
+  CommsRequest_t req;
+  grid->GlobalSumVectorBegin(&lnrm,1,req);
+  while ( !grid->GlobalSumVectorTest(req) ) {};
+  std::cout << GridLogMessage << " norm2 blocking "<<nrm<<" polled "<<lnrm<<std::endl;
+  assert(std::fabs(nrm-lnrm)/nrm < 1.0e-12);
+
+  Grid_finalize();
+}
@@ -0,0 +1,128 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_memory_cache.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+static uint64_t cacheHits(size_t bytes)
+{
+  std::vector<MemoryCacheStats> stats;
+  MemoryManager::CacheStatistics(0,stats);
+  for(int s=0;s<stats.size();s++) if ( stats[s].bytes==bytes ) return stats[s].hits;
+  return 0;
+}
+static uint64_t cacheCount(size_t bytes)
+{
+  std::vector<MemoryCacheStats> stats;
+  MemoryManager::CacheStatistics(0,stats);
+  for(int s=0;s<stats.size();s++) if ( stats[s].bytes==bytes ) return stats[s].cached;
+  return 0;
+}
+static uint64_t cacheBytes(void)
+{
+  std::vector<MemoryCacheStats> stats;
+  MemoryManager::CacheStatistics(0,stats);
+  uint64_t bytes=0;
+  for(int s=0;s<stats.size();s++) bytes+=stats[s].bytes*stats[s].cached;
+  return bytes;
+}
+
+int main(int argc, char **argv) {
+  // Small high water mark so that the trim policy is exercised
+  setenv("GRID_ALLOC_CACHE_HIGHWATER_MB","64",1);
+  Grid_init(&argc, &argv);
+
+#ifdef ALLOCATION_CACHE
+  alignedAllocator<char> alloc;
+
+  ////////////////////////////////////////////////////////////////
+  // Requests of slightly different size share a size class
+  ////////////////////////////////////////////////////////////////
+  const size_t MB = 1024*1024;
+  char *a = alloc.allocate(1000000);
+  alloc.deallocate(a,1000000);
+  uint64_t hits = cacheHits(MB);
+  char *b = alloc.allocate(1001000);
+  std::cout << GridLogMessage << "reused size class: " << (a==b) << " hits " << cacheHits(MB)-hits << std::endl;
+  assert(a==b);
+  assert(cacheHits(MB)==hits+1);
+  alloc.deallocate(b,1001000);
+
+  ////////////////////////////////////////////////////////////////
+  // Temporaries allocated and freed inside threaded regions
+  ////////////////////////////////////////////////////////////////
+  const int Nrep = 1000;
+  std::vector<int> fail(GridThread::GetThreads(),0);
+  thread_for(t,fail.size(),{
+    for(int r=0;r<Nrep;r++){
+      size_t n = 8+(r%64)*8;
+      std::vector<double,alignedAllocator<double> > tmp(n);
+      Vector<int> itmp(n+t);
+      for(int i=0;i<n;i++) { tmp[i]=t; itmp[i]=t; }
+      for(int i=0;i<n;i++) if ( (tmp[i]!=t) || (itmp[i]!=t) ) fail[t]=1;
+    }
+  });
+  for(int t=0;t<fail.size();t++) assert(fail[t]==0);
+
+  ////////////////////////////////////////////////////////////////
+  // Cached bytes respect the high water mark
+  ////////////////////////////////////////////////////////////////
+  const int Nbig = 8;
+  std::vector<char *> big(Nbig);
+  for(int i=0;i<Nbig;i++) big[i] = alloc.allocate(16*MB);
+  for(int i=0;i<Nbig;i++) alloc.deallocate(big[i],16*MB);
+  std::cout << GridLogMessage << "cached bytes after freeing "<<Nbig*16<<" MB: " << cacheBytes() << std::endl;
+  assert(cacheBytes() <= 64*MB);
+
+  // A block larger than the cap is never cached
+  char *huge = alloc.allocate(96*MB);
+  alloc.deallocate(huge,96*MB);
+  std::cout << GridLogMessage << "cached bytes after freeing 96 MB: " << cacheBytes() << std::endl;
+  assert(cacheBytes() <= 64*MB);
+
+  ////////////////////////////////////////////////////////////////
+  // Blocks left in an exiting thread's cache are recovered
+  ////////////////////////////////////////////////////////////////
+  // A new thread starts with an empty cache, so a hit came from the central list
+  const size_t cls = 3072;
+  uint64_t cached = cacheCount(cls);
+  uint64_t central_hits = cacheHits(cls);
+  std::thread worker([&](){
+    char *c = alloc.allocate(3000);
+    alloc.deallocate(c,3000);
+  });
+  worker.join();
+  central_hits = cacheHits(cls) - central_hits;
+  std::cout << GridLogMessage << "central list of exited thread's class: " << cached << " -> " << cacheCount(cls) << std::endl;
+  assert(cacheCount(cls)==cached-central_hits+1);
+
+  MemoryManager::PrintCacheStatistics();
+#endif
+
+  std::cout << GridLogMessage << "all checks passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,136 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_padded_cell.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Run also with --mpi splits (e.g. --mpi 1.1.2.2 --grid 8.8.8.8) so the halo
+// crosses ranks and the local extent is smaller than the global one
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian Grid(latt_size,simd_layout,mpi_layout);
+
+  // Test volumes are below the default threshold; use the engine everywhere
+  GaugeStaplesStatic::MinLocalVolume = 0;
+  assert(GaugeStaples<PeriodicGimplR>::Usable(&Grid,2));
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG pRNG(&Grid);  pRNG.SeedFixedIntegers(seeds);
+
+  LatticeGaugeField Umu(&Grid);
+  SU<Nc>::HotConfiguration(pRNG,Umu);
+
+  typedef WilsonLoops<PeriodicGimplR> WL;
+
+  LatticeColourMatrix ref(&Grid), diff(&Grid), tmp(&Grid);
+  LatticeGaugeField staple(&Grid), rect(&Grid);
+
+  ////////////////////////////////////////////////////
+  // Halo exchange and extraction round trip
+  ////////////////////////////////////////////////////
+  {
+    PaddedCell Ghost(2,&Grid);
+    LatticeGaugeField padded = Ghost.Exchange(Umu);
+    LatticeGaugeField back   = Ghost.Extract(padded);
+    back = back - Umu;
+    std::cout << GridLogMessage << "Padded cell round trip " << norm2(back) << std::endl;
+    assert(norm2(back)==0.0);
+  }
+
+  ////////////////////////////////////////////////////
+  // Stencil staples against the Cshift based ones
+  ////////////////////////////////////////////////////
+  GaugeStaples<PeriodicGimplR> Staples(&Grid,2);
+  Staples.ImportGauge(Umu);
+  Staples.Staple(staple);
+  Staples.RectStaple(rect);
+
+  RealD tol = 1.0e-10;
+  for(int mu=0;mu<Nd;mu++){
+    WL::Staple(ref,Umu,mu);
+    diff = ref - PeekIndex<LorentzIndex>(staple,mu);
+    std::cout << GridLogMessage << "mu "<<mu<<" staple diff " << norm2(diff) << std::endl;
+    assert(norm2(diff) < tol*norm2(ref));
+
+    WL::RectStapleUnoptimised(ref,Umu,mu);
+    diff = ref - PeekIndex<LorentzIndex>(rect,mu);
+    std::cout << GridLogMessage << "mu "<<mu<<" rectangle staple diff " << norm2(diff) << std::endl;
+    assert(norm2(diff) < tol*norm2(ref));
+  }
+
+  for(int mu=0;mu<Nd;mu++){
+    for(int nu=0;nu<Nd;nu++){
+      if ( mu==nu ) continue;
+      WL::FieldStrength(ref,Umu,mu,nu);
+      Staples.FieldStrength(tmp,mu,nu);
+      diff = ref - tmp;
+      std::cout << GridLogMessage << "mu "<<mu<<" nu "<<nu<<" clover field strength diff " << norm2(diff) << std::endl;
+      assert(norm2(diff) < tol*norm2(ref));
+    }
+  }
+
+  ////////////////////////////////////////////////////
+  // Gauge forces
+  ////////////////////////////////////////////////////
+  {
+    LatticeGaugeField dSdU(&Grid);
+    LatticeColourMatrix U_mu(&Grid);
+    RealD beta = 6.0;
+    WilsonGaugeAction<PeriodicGimplR> Waction(beta);
+    Waction.deriv(Umu,dSdU);
+    for(int mu=0;mu<Nd;mu++){
+      U_mu = PeekIndex<LorentzIndex>(Umu,mu);
+      WL::Staple(ref,Umu,mu);
+      ref  = Ta(U_mu*ref)*(0.5*beta/RealD(Nc));
+      diff = ref - PeekIndex<LorentzIndex>(dSdU,mu);
+      std::cout << GridLogMessage << "mu "<<mu<<" Wilson force diff " << norm2(diff) << std::endl;
+      assert(norm2(diff) < tol*norm2(ref));
+    }
+
+    RealD c1 = -0.331;
+    IwasakiGaugeAction<PeriodicGimplR> Iaction(beta);
+    Iaction.deriv(Umu,dSdU);
+    for(int mu=0;mu<Nd;mu++){
+      U_mu = PeekIndex<LorentzIndex>(Umu,mu);
+      WL::Staple(ref,Umu,mu);
+      WL::RectStapleUnoptimised(tmp,Umu,mu);
+      ref  = Ta(U_mu*ref)*(0.5*beta*(1.0-8.0*c1)/RealD(Nc)) + Ta(U_mu*tmp)*(0.5*beta*c1/RealD(Nc));
+      diff = ref - PeekIndex<LorentzIndex>(dSdU,mu);
+      std::cout << GridLogMessage << "mu "<<mu<<" Iwasaki force diff " << norm2(diff) << std::endl;
+      assert(norm2(diff) < tol*norm2(ref));
+    }
+  }
+
+  Grid_finalize();
+}
@@ -0,0 +1,137 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_precision_change.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Single precision image of a double field must agree site by site, wherever the lanes live
+template<class FieldF,class FieldD>
+void checkNarrowed(const FieldF &f,const FieldD &d)
+{
+  typedef typename FieldF::scalar_object sobjF;
+  typedef typename FieldD::scalar_object sobjD;
+  std::vector<sobjF> lexF;
+  std::vector<sobjD> lexD;
+  unvectorizeToLexOrdArray(lexF,f);
+  unvectorizeToLexOrdArray(lexD,d);
+  assert(lexF.size()==lexD.size());
+  const int words = sizeof(sobjD)/sizeof(ComplexD);
+  for(int s=0;s<lexD.size();s++){
+    ComplexF *pf = (ComplexF *)&lexF[s];
+    ComplexD *pd = (ComplexD *)&lexD[s];
+    for(int w=0;w<words;w++){
+      assert(pf[w]==ComplexF(pd[w]));
+    }
+  }
+}
+
+template<class FieldF,class FieldD>
+void checkPair(const std::string &name,GridBase *gridF,GridBase *gridD,GridParallelRNG &pRNG)
+{
+  FieldD d(gridD), dd(gridD), diff(gridD);
+  FieldF f(gridF), ff(gridF);
+  gaussian(pRNG,d);
+
+  precisionChange(f,d);
+  checkNarrowed(f,d);
+
+  precisionChange(dd,f);
+  diff = dd - d;
+  RealD rel = norm2(diff)/norm2(d);
+  std::cout << GridLogMessage << name << " double -> single -> double rel diff " << rel << std::endl;
+  assert(rel < 1.0e-12);
+
+  // widening is exact
+  precisionChange(ff,dd);
+  checkNarrowed(ff,dd);
+  FieldF fdiff(gridF);
+  fdiff = ff - f;
+  assert(norm2(fdiff)==0.0);
+}
+
+int main(int argc, char **argv) {
+  Grid_init(&argc, &argv);
+
+  Coordinate latt = GridDefaultLatt();
+  Coordinate mpi  = GridDefaultMpi();
+
+  ////////////////////////////////////////////////////////////////
+  // Default layouts; lanes do not line up word for word
+  ////////////////////////////////////////////////////////////////
+  GridCartesian         *UGridD   = SpaceTimeGrid::makeFourDimGrid(latt,GridDefaultSimd(Nd,vComplexD::Nsimd()),mpi);
+  GridCartesian         *UGridF   = SpaceTimeGrid::makeFourDimGrid(latt,GridDefaultSimd(Nd,vComplexF::Nsimd()),mpi);
+  GridRedBlackCartesian *UrbGridD = SpaceTimeGrid::makeFourDimRedBlackGrid(UGridD);
+  GridRedBlackCartesian *UrbGridF = SpaceTimeGrid::makeFourDimRedBlackGrid(UGridF);
+
+  ////////////////////////////////////////////////////////////////
+  // Layouts where the single precision grid doubles the slowest lane dimension
+  ////////////////////////////////////////////////////////////////
+  Coordinate simdD = GridDefaultSimd(Nd-1,vComplexD::Nsimd());
+  Coordinate simdF = simdD;
+  simdD.push_back(1);
+  simdF.push_back(2);
+  GridCartesian         *VGridD   = SpaceTimeGrid::makeFourDimGrid(latt,simdD,mpi);
+  GridCartesian         *VGridF   = SpaceTimeGrid::makeFourDimGrid(latt,simdF,mpi);
+  GridRedBlackCartesian *VrbGridD = SpaceTimeGrid::makeFourDimRedBlackGrid(VGridD);
+  GridRedBlackCartesian *VrbGridF = SpaceTimeGrid::makeFourDimRedBlackGrid(VGridF);
+
+  std::cout << GridLogMessage << "default layouts "<< GridDefaultSimd(Nd,vComplexD::Nsimd()) << " " << GridDefaultSimd(Nd,vComplexF::Nsimd()) <<std::endl;
+  std::cout << GridLogMessage << "word layouts    "<< simdD << " " << simdF <<std::endl;
+
+  GridParallelRNG pRNGU(UGridD); pRNGU.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG pRNGV(VGridD); pRNGV.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  checkPair<LatticeColourMatrixF,LatticeColourMatrixD>("lane gather",UGridF,UGridD,pRNGU);
+  checkPair<LatticeColourMatrixF,LatticeColourMatrixD>("word convert",VGridF,VGridD,pRNGV);
+
+  ////////////////////////////////////////////////////////////////
+  // Checkerboarded fields keep their parity and their sites
+  ////////////////////////////////////////////////////////////////
+  for(int layout=0;layout<2;layout++){
+    GridCartesian         *GridD   = layout ? VGridD : UGridD;
+    GridCartesian         *GridF   = layout ? VGridF : UGridF;
+    GridRedBlackCartesian *rbGridD = layout ? VrbGridD : UrbGridD;
+    GridRedBlackCartesian *rbGridF = layout ? VrbGridF : UrbGridF;
+    GridParallelRNG       &pRNG    = layout ? pRNGV : pRNGU;
+
+    LatticeFermionD d(GridD);    gaussian(pRNG,d);
+    LatticeFermionF f(GridF);    precisionChange(f,d);
+    LatticeFermionD d_o(rbGridD);
+    LatticeFermionF f_o(rbGridF), ref_o(rbGridF), diff_o(rbGridF);
+
+    pickCheckerboard(Odd,d_o,d);
+    pickCheckerboard(Odd,ref_o,f);
+    precisionChange(f_o,d_o);
+    assert(f_o.Checkerboard()==Odd);
+    diff_o = f_o - ref_o;
+    std::cout << GridLogMessage << "checkerboarded layout "<<layout<<" diff " << norm2(diff_o) << std::endl;
+    assert(norm2(diff_o)==0.0);
+  }
+
+  std::cout << GridLogMessage << "all checks passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,146 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_reproducible_reduction.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main(int argc, char **argv) {
+  Grid_init(&argc, &argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+  GridParallelRNG pRNG(grid);
+  pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeFermion x(grid); gaussian(pRNG,x);
+  LatticeFermion y(grid); gaussian(pRNG,y);
+
+  typedef LatticeFermion::scalar_object sobj;
+
+  RealD nrm_fast = norm2(x);
+  ComplexD ip_fast = innerProduct(x,y);
+  std::vector<sobj> slice_fast;
+  sliceSum(x,slice_fast,Nd-1);
+
+  GridReproducibleReduction::Enabled = 1;
+
+  ////////////////////////////////////////////////////////////////
+  // Thread count must not change a single bit of the result
+  ////////////////////////////////////////////////////////////////
+  RealD nrm_ref;
+  ComplexD ip_ref;
+  std::vector<sobj> slice_ref;
+  int max_threads = GridThread::GetThreads();
+  for(int thr=max_threads;thr>=1;thr--){
+    GridThread::SetThreads(thr);
+
+    RealD nrm = norm2(x);
+    ComplexD ip = innerProduct(x,y);
+    std::vector<sobj> slice;
+    sliceSum(x,slice,Nd-1);
+
+    std::cout << GridLogMessage << std::setprecision(17) << thr << " threads: norm2 " << nrm
+	      << " innerProduct " << ip << std::endl;
+    if ( thr == max_threads ) {
+      nrm_ref = nrm;
+      ip_ref = ip;
+      slice_ref = slice;
+    }
+    assert(nrm == nrm_ref);
+    assert(ip == ip_ref);
+    assert(slice.size() == slice_ref.size());
+    for(int t=0;t<slice.size();t++){
+      assert(memcmp(&slice[t],&slice_ref[t],sizeof(sobj))==0);
+    }
+  }
+  GridThread::SetThreads(max_threads);
+
+  ////////////////////////////////////////////////////////////////
+  // and agree with the fast path to rounding
+  ////////////////////////////////////////////////////////////////
+  std::cout << GridLogMessage << std::setprecision(17) << "fast norm2 " << nrm_fast << " reproducible " << nrm_ref << std::endl;
+  std::cout << GridLogMessage << std::setprecision(17) << "fast innerProduct " << ip_fast << " reproducible " << ip_ref << std::endl;
+  assert(std::fabs(nrm_fast-nrm_ref)/nrm_fast < 1.0e-12);
+  assert(abs(ip_fast-ip_ref)/nrm_fast < 1.0e-12);
+  for(int t=0;t<slice_ref.size();t++){
+    sobj diff = slice_fast[t]-slice_ref[t];
+    RealD n = norm2(diff)/norm2(slice_fast[t]);
+    assert(n < 1.0e-20);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Same field on other MPI and SIMD decompositions of the same
+  // ranks; run with --mpi splits so the MPI layouts differ
+  ////////////////////////////////////////////////////////////////
+  {
+    Coordinate mpi  = GridDefaultMpi();
+    Coordinate simd = GridDefaultSimd(Nd,vComplexD::Nsimd());
+    Coordinate mpi_r(Nd), simd_r(Nd);
+    for(int d=0;d<Nd;d++){
+      mpi_r[d]  = mpi[Nd-1-d];
+      simd_r[d] = simd[Nd-1-d];
+    }
+    std::vector<GridCartesian *> grids;
+    grids.push_back(new GridCartesian(GridDefaultLatt(),simd  ,mpi  ));
+    grids.push_back(new GridCartesian(GridDefaultLatt(),simd_r,mpi  ));
+    grids.push_back(new GridCartesian(GridDefaultLatt(),simd  ,mpi_r));
+    grids.push_back(new GridCartesian(GridDefaultLatt(),simd_r,mpi_r));
+
+    // A function of the global coordinate, with rounding in every site value
+    RealD    tiny0;
+    ComplexD ip0;
+    for(int g=0;g<grids.size();g++){
+      LatticeComplexD f(grids[g]), c(grids[g]), t(grids[g]);
+      f = ComplexD(1.0,0.0);
+      for(int mu=0;mu<Nd;mu++){
+	LatticeCoordinate(c,mu);
+	f = f + c*ComplexD(1.0/(3.0+2*mu),1.0/(5.0+mu));
+      }
+      f = f*f*ComplexD(1.0/7.0,1.0/3.0);
+      t = f*f;
+      ComplexD ipg = innerProduct(f,t);
+      // Site values below ~1e-289: a single 2^scale factor would overflow
+      t = f*ComplexD(1.0e-150,0.0);
+      RealD tinyg = norm2(t);
+      std::cout << GridLogMessage << std::setprecision(17) << "layout "<<g<<" innerProduct "<<ipg<<" tiny norm2 "<<tinyg<<std::endl;
+      assert(std::isfinite(tinyg) && (tinyg > 0.0));
+      if ( g==0 ) {
+	ip0 = ipg; tiny0 = tinyg;
+	assert(std::fabs(tinyg*1.0e300/norm2(f)-1.0) < 1.0e-12);
+      }
+      assert(ipg == ip0);
+      assert(tinyg == tiny0);
+    }
+    for(int g=0;g<grids.size();g++) delete grids[g];
+  }
+
+  GridReproducibleReduction::Enabled = 0;
+
+  std::cout << GridLogMessage << "all checks passed" << std::endl;
+  Grid_finalize();
+}
@@ -352,5 +352,62 @@ int main(int argc, char **argv)
   std::cout << GridLogMessage << "phi (EO decomposition)          diff  :" << norm2(phi) << std::endl;
   std::cout << GridLogMessage << "norm diff                             :" << norm2(err) << std::endl;
 
+  std::cout << GridLogMessage << "==========================================================" << std::endl;
+  std::cout << GridLogMessage << "= Testing packed clover term against full spin-colour matrix " << std::endl;
+  std::cout << GridLogMessage << "==========================================================" << std::endl;
+
+  {
+    typedef typename WilsonCloverFermionR::CloverFieldType CloverFieldType;
+    LatticeColourMatrix Bx(&Grid), By(&Grid), Bz(&Grid), Ex(&Grid), Ey(&Grid), Ez(&Grid);
+    WilsonLoops<WilsonImplR>::FieldStrength(Bx, Umu, Zdir, Ydir);
+    WilsonLoops<WilsonImplR>::FieldStrength(By, Umu, Zdir, Xdir);
+    WilsonLoops<WilsonImplR>::FieldStrength(Bz, Umu, Ydir, Xdir);
+    WilsonLoops<WilsonImplR>::FieldStrength(Ex, Umu, Tdir, Xdir);
+    WilsonLoops<WilsonImplR>::FieldStrength(Ey, Umu, Tdir, Ydir);
+    WilsonLoops<WilsonImplR>::FieldStrength(Ez, Umu, Tdir, Zdir);
+
+    // Isotropic normalisation used by the constructor
+    CloverFieldType Full(&Grid);
+    Full  = Dwc.fillCloverYZ(Bx) * (0.5 * csw_r);
+    Full += Dwc.fillCloverXZ(By) * (0.5 * csw_r);
+    Full += Dwc.fillCloverXY(Bz) * (0.5 * csw_r);
+    Full += Dwc.fillCloverXT(Ex) * (0.5 * csw_t);
+    Full += Dwc.fillCloverYT(Ey) * (0.5 * csw_t);
+    Full += Dwc.fillCloverZT(Ez) * (0.5 * csw_t);
+    Full += (4.0 + mass);
+
+    ref = Full * src;
+    pickCheckerboard(Even, src_e, src);
+    pickCheckerboard(Odd, src_o, src);
+    Dwc.Mooee(src_e, chi_e);
+    Dwc.Mooee(src_o, chi_o);
+    setCheckerboard(chi, chi_e);
+    setCheckerboard(chi, chi_o);
+    err = ref - chi;
+    std::cout << GridLogMessage << "Mooee    norm diff   " << norm2(err) << std::endl;
+
+    Dwc.MooeeDag(src_e, chi_e);
+    Dwc.MooeeDag(src_o, chi_o);
+    setCheckerboard(chi, chi_e);
+    setCheckerboard(chi, chi_o);
+    err = ref - chi;
+    std::cout << GridLogMessage << "MooeeDag norm diff   " << norm2(err) << std::endl;
+
+    pickCheckerboard(Even, chi_e, ref);
+    pickCheckerboard(Odd, chi_o, ref);
+    Dwc.MooeeInv(chi_e, phi_e);
+    Dwc.MooeeInv(chi_o, phi_o);
+    setCheckerboard(phi, phi_e);
+    setCheckerboard(phi, phi_o);
+    err = src - phi;
+    std::cout << GridLogMessage << "MooeeInv norm diff   " << norm2(err) << std::endl;
+
+    int ncall = 10;
+    double t0 = usecond();
+    for (int i = 0; i < ncall; i++) Dwc.ImportGauge(Umu);
+    double t1 = usecond();
+    std::cout << GridLogMessage << "ImportGauge " << (t1 - t0) / ncall << " us" << std::endl;
+  }
+
   Grid_finalize();
 }
@@ -0,0 +1,183 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_wilson_multirhs.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class Field>
+RealD MaxRelErr(std::vector<Field> &res,std::vector<Field> &ref)
+{
+  RealD err=0.0;
+  for(int r=0;r<res.size();r++){
+    Field diff = res[r]-ref[r];
+    err = std::max(err,norm2(diff)/norm2(ref[r]));
+  }
+  return err;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int nrhs=3;
+  const int Ls=4;
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+								     GridDefaultSimd(Nd,vComplexD::Nsimd()),
+								     GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+
+  // Batch grids: nrhs 4d fields, and nrhs 5d fields of extent Ls
+  GridCartesian         * BGrid   = SpaceTimeGrid::makeFiveDimGrid(nrhs,UGrid);
+  GridRedBlackCartesian * BrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(nrhs,UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+  GridCartesian         * BFGrid  = SpaceTimeGrid::makeFiveDimGrid(Ls*nrhs,UGrid);
+  GridRedBlackCartesian * BFrbGrid= SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls*nrhs,UGrid);
+
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG RNG5(FGrid); RNG5.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  LatticeGaugeFieldD Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+
+  std::vector<Complex> boundary_phases(Nd,1.0);
+  boundary_phases[Nd-1] = -1.0;
+  WilsonImplParams params(boundary_phases);
+
+  std::vector<LatticeFermionD> src(nrhs,UGrid), res(nrhs,UGrid), ref(nrhs,UGrid);
+  for(int r=0;r<nrhs;r++) gaussian(RNG4,src[r]);
+
+  std::cout << GridLogMessage << "Insert/Extract round trip" << std::endl;
+  {
+    LatticeFermionD batch(BGrid);
+    InsertRHS(src,batch);
+    ExtractRHS(res,batch);
+    for(int r=0;r<nrhs;r++){
+      LatticeFermionD diff = res[r]-src[r];
+      assert(norm2(diff)==0.0);
+    }
+    // r-th rhs is the s=r slice of the batch
+    LatticeFermionD slice(UGrid);
+    ExtractSlice(slice,batch,nrhs-1,0);
+    LatticeFermionD diff = slice-src[nrhs-1];
+    assert(norm2(diff)==0.0);
+  }
+
+  WilsonFermionD         Dw(Umu,*UGrid,*UrbGrid,mass,params);
+  WilsonFermionMultiRHSD Dm(Umu,*BGrid,*BrbGrid,*UGrid,*UrbGrid,mass,params);
+
+  for(int dag=0;dag<2;dag++){
+    for(int r=0;r<nrhs;r++) Dw.Dhop(src[r],ref[r],dag);
+    Dm.DhopMultiRHS(src,res,dag);
+    RealD err = MaxRelErr(res,ref);
+    std::cout << GridLogMessage << "Wilson Dhop dag "<<dag<<" batched vs single rel err " << err << std::endl;
+    assert(err < 1.0e-28);
+  }
+
+  {
+    // Partial batch, as left by a solver once some systems converge
+    std::vector<LatticeFermionD> part_src(src.begin()+1,src.end());
+    std::vector<LatticeFermionD> part_res(nrhs-1,UGrid), part_ref(nrhs-1,UGrid);
+    for(int r=0;r<nrhs-1;r++) Dw.Dhop(part_src[r],part_ref[r],DaggerNo);
+    Dm.DhopMultiRHS(part_src,part_res,DaggerNo);
+    RealD err = MaxRelErr(part_res,part_ref);
+    std::cout << GridLogMessage << "Wilson Dhop partial batch rel err " << err << std::endl;
+    assert(err < 1.0e-28);
+  }
+
+  for(int r=0;r<nrhs;r++) Dw.M(src[r],ref[r]);
+  Dm.MMultiRHS(src,res);
+  RealD err = MaxRelErr(res,ref);
+  std::cout << GridLogMessage << "Wilson M batched vs single rel err " << err << std::endl;
+  assert(err < 1.0e-28);
+
+  for(int r=0;r<nrhs;r++) Dw.Mdag(src[r],ref[r]);
+  Dm.MdagMultiRHS(src,res);
+  err = MaxRelErr(res,ref);
+  std::cout << GridLogMessage << "Wilson Mdag batched vs single rel err " << err << std::endl;
+  assert(err < 1.0e-28);
+
+  {
+    std::vector<LatticeFermionD> src_o(nrhs,UrbGrid), res_e(nrhs,UrbGrid), ref_e(nrhs,UrbGrid);
+    for(int r=0;r<nrhs;r++) pickCheckerboard(Odd,src_o[r],src[r]);
+    for(int dag=0;dag<2;dag++){
+      for(int r=0;r<nrhs;r++) Dw.DhopEO(src_o[r],ref_e[r],dag);
+      Dm.DhopMultiRHS(src_o,res_e,dag);
+      err = MaxRelErr(res_e,ref_e);
+      std::cout << GridLogMessage << "Wilson DhopEO dag "<<dag<<" batched vs single rel err " << err << std::endl;
+      assert(err < 1.0e-28);
+      for(int r=0;r<nrhs;r++) assert(res_e[r].Checkerboard()==Even);
+    }
+  }
+
+  std::cout << GridLogMessage << "Single field through the Schur operator" << std::endl;
+  {
+    SchurDiagMooeeOperator<WilsonFermionD,LatticeFermionD>         HermOp (Dw);
+    SchurDiagMooeeOperator<WilsonFermionMultiRHSD,LatticeFermionD> HermOpM(Dm);
+    LatticeFermionD src_o(UrbGrid), res_o(UrbGrid), ref_o(UrbGrid);
+    pickCheckerboard(Odd,src_o,src[0]);
+    HermOp.HermOp (src_o,ref_o);
+    HermOpM.HermOp(src_o,res_o);
+    res_o = res_o - ref_o;
+    err = std::sqrt(norm2(res_o)/norm2(ref_o));
+    std::cout << GridLogMessage << "Schur HermOp single field rel err " << err << std::endl;
+    assert(err < 1.0e-14);
+    assert(res_o.Checkerboard()==Odd);
+
+    LatticeFermionD res(UGrid), ref(UGrid);
+    Dw.M(src[0],ref);
+    Dm.M(src[0],res);
+    res = res - ref;
+    err = std::sqrt(norm2(res)/norm2(ref));
+    std::cout << GridLogMessage << "M single field rel err " << err << std::endl;
+    assert(err < 1.0e-14);
+  }
+
+  std::cout << GridLogMessage << "Batched DWF hopping term" << std::endl;
+  {
+    std::vector<LatticeFermionD> src5(nrhs,FGrid), res5(nrhs,FGrid), ref5(nrhs,FGrid);
+    for(int r=0;r<nrhs;r++) gaussian(RNG5,src5[r]);
+
+    DomainWallFermionD     Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,params);
+    WilsonFermionMultiRHSD Dm5 (Umu,*BFGrid,*BFrbGrid,*UGrid,*UrbGrid,mass,params);
+
+    for(int dag=0;dag<2;dag++){
+      for(int r=0;r<nrhs;r++) Ddwf.Dhop(src5[r],ref5[r],dag);
+      Dm5.DhopMultiRHS(src5,res5,dag);
+      err = MaxRelErr(res5,ref5);
+      std::cout << GridLogMessage << "DWF Dhop dag "<<dag<<" batched vs single rel err " << err << std::endl;
+      assert(err < 1.0e-28);
+    }
+  }
+
+  std::cout << GridLogMessage << "all checks passed" << std::endl;
+  Grid_finalize();
+}
@@ -297,5 +297,43 @@ int main (int argc, char ** argv)
   std::cout<<GridLogMessage <<"pDce - conj(cDpo) "<< pDco-conj(cDpo) <<std::endl;
   std::cout<<GridLogMessage <<"pDco - conj(cDpe) "<< pDce-conj(cDpe) <<std::endl;
   
+  std::cout<<GridLogMessage<<"=============================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Test fused Schur complement against the separate passes       "<<std::endl;
+  std::cout<<GridLogMessage<<"=============================================================="<<std::endl;
+
+  {
+    typedef CheckerBoardedSparseMatrixBase<LatticeFermion> Unfused;
+    LatticeFermion ref_eo(FrbGrid);
+    int fused = WilsonKernelsStatic::FusedSchur;
+    int comms = WilsonKernelsStatic::Comms;
+    WilsonKernelsStatic::FusedSchur = 1;
+    WilsonKernelsStatic::Comms      = WilsonKernelsStatic::CommsThenCompute;
+    for(int dag=0;dag<2;dag++){
+      for(int cb=0;cb<2;cb++){
+	LatticeFermion &in = (cb==0) ? chi_e : chi_o;
+	LatticeFermion &out= (cb==0) ? dchi_e : dchi_o;
+	if ( dag ) {
+	  Ddwf.SchurDiagMooeeDag(in,out);
+	  Ddwf.Unfused::SchurDiagMooeeDag(in,ref_eo);
+	} else {
+	  Ddwf.SchurDiagMooee(in,out);
+	  Ddwf.Unfused::SchurDiagMooee(in,ref_eo);
+	}
+	ref_eo = ref_eo - out;
+	std::cout<<GridLogMessage << "dag "<<dag<<" cb "<<cb<<" norm diff   "<< norm2(ref_eo)<< std::endl;
+      }
+    }
+
+    int ncall=10;
+    RealD t0=usecond();
+    for(int i=0;i<ncall;i++) Ddwf.SchurDiagMooee(chi_e,dchi_e);
+    RealD t1=usecond();
+    for(int i=0;i<ncall;i++) Ddwf.Unfused::SchurDiagMooee(chi_e,dchi_e);
+    RealD t2=usecond();
+    std::cout<<GridLogMessage << "Mpc fused "<<(t1-t0)/ncall<<" us, separate passes "<<(t2-t1)/ncall<<" us"<<std::endl;
+    WilsonKernelsStatic::FusedSchur = fused;
+    WilsonKernelsStatic::Comms      = comms;
+  }
+
   Grid_finalize();
 }
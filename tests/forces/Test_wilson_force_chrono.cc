@@ -0,0 +1,98 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/Test_wilson_force_chrono.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Force solves along a short MD trajectory, with and without
+// chronological guesses from the previous steps
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  GridCartesian               Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian     RBGrid(&Grid);
+
+  GridSerialRNG            sRNG; sRNG.SeedFixedIntegers(std::vector<int>({4,3,2,1}));
+  GridParallelRNG          pRNG(&Grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  LatticeGaugeField U(&Grid);
+  LatticeGaugeField P(&Grid);
+  SU<Nc>::HotConfiguration(pRNG,U);
+  PeriodicGimplR::generate_momenta(P,sRNG,pRNG);
+
+  RealD mass=0.2;
+  WilsonFermionR Dw(U,Grid,RBGrid,mass);
+
+  ConjugateGradient<LatticeFermion> CG(1.0e-10,10000);
+  TwoFlavourEvenOddPseudoFermionAction<WilsonImplR> Nf2(Dw,CG,CG);
+  Nf2.refresh(U,sRNG,pRNG);
+
+  // Same pseudofermion, guesses from the last four solutions
+  TwoFlavourEvenOddPseudoFermionAction<WilsonImplR> Nf2chrono(Nf2);
+  Nf2chrono.DerivativeHistory.Depth = 4;
+
+  const int nstep = 8;
+  const RealD dt  = 0.02;
+
+  LatticeGaugeField force_plain(&Grid);
+  LatticeGaugeField force_chrono(&Grid);
+
+  int iters_plain  = 0;
+  int iters_chrono = 0;
+
+  for(int step=0;step<nstep;step++){
+
+    Nf2.deriv(U,force_plain);
+    iters_plain += CG.IterationsToComplete;
+
+    Nf2chrono.deriv(U,force_chrono);
+    iters_chrono += CG.IterationsToComplete;
+
+    force_chrono = force_chrono - force_plain;
+    RealD rdiff = std::sqrt(norm2(force_chrono)/norm2(force_plain));
+    std::cout << GridLogMessage << "Step "<<step<<" force relative difference "<<rdiff
+	      << " iterations plain "<<iters_plain<<" chrono "<<iters_chrono<<std::endl;
+    assert(rdiff < 1.0e-6);
+
+    PeriodicGimplR::update_field(P,U,dt);
+  }
+
+  std::cout << GridLogMessage << "Force solve iterations: zero guess "<<iters_plain
+	    << " chronological guess "<<iters_chrono<<std::endl;
+  assert(iters_chrono < iters_plain);
+
+  // A reset leaves the zero guess
+  Nf2chrono.reset_history();
+  assert(Nf2chrono.DerivativeHistory.Solutions.size() == 0);
+
+  Grid_finalize();
+}
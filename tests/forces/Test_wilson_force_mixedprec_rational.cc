@@ -0,0 +1,96 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/forces/Test_wilson_force_mixedprec_rational.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Mixed precision one flavour rational ratio against the double precision
+// action: same pseudofermion, same gauge field, S and dS/dU must agree
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian         *UGrid_d   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridCartesian         *UGrid_f   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexF::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian *UrbGrid_d = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid_d);
+  GridRedBlackCartesian *UrbGrid_f = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid_f);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG pRNG(UGrid_d); pRNG.SeedFixedIntegers(seeds);
+  GridSerialRNG   sRNG;          sRNG.SeedFixedIntegers(seeds);
+
+  LatticeGaugeFieldD U(UGrid_d);
+  SU<Nc>::HotConfiguration(pRNG,U);
+  LatticeGaugeFieldF Uf(UGrid_f);
+  precisionChange(Uf,U);
+
+  RealD num_mass=0.4;
+  RealD den_mass=0.2;
+  WilsonFermionD NumOp (U ,*UGrid_d,*UrbGrid_d,num_mass);
+  WilsonFermionD DenOp (U ,*UGrid_d,*UrbGrid_d,den_mass);
+  WilsonFermionF NumOpF(Uf,*UGrid_f,*UrbGrid_f,num_mass);
+  WilsonFermionF DenOpF(Uf,*UGrid_f,*UrbGrid_f,den_mass);
+
+  // Rarely bounds check, so both actions do the same work in S
+  OneFlavourRationalParams Params(1.0e-2,64.0,10000,1.0e-10,12,60,1000000);
+
+  OneFlavourEvenOddRatioRationalPseudoFermionAction<WilsonImplD> Action(NumOp,DenOp,Params);
+  OneFlavourEvenOddRatioRationalMixedPrecPseudoFermionAction<WilsonImplD,WilsonImplF> ActionMP(NumOp,DenOp,NumOpF,DenOpF,Params);
+
+  // Same pseudofermion from identically seeded generators
+  {
+    GridParallelRNG pRNGa(UGrid_d); pRNGa.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+    GridParallelRNG pRNGb(UGrid_d); pRNGb.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+    Action.refresh  (U,sRNG,pRNGa);
+    ActionMP.refresh(U,sRNG,pRNGb);
+  }
+
+  ////////////////////////////////////
+  // Action
+  ////////////////////////////////////
+  RealD S   = Action.S(U);
+  RealD Smp = ActionMP.S(U);
+  RealD Sdiff = std::fabs(Smp-S)/std::fabs(S);
+  std::cout << GridLogMessage << "S double "<<S<<" mixed precision "<<Smp<<" relative difference "<<Sdiff<<std::endl;
+  assert(Sdiff < 1.0e-8);
+
+  ////////////////////////////////////
+  // Force
+  ////////////////////////////////////
+  LatticeGaugeFieldD dSdU(UGrid_d);
+  LatticeGaugeFieldD dSdUmp(UGrid_d);
+  Action.deriv(U,dSdU);
+  ActionMP.deriv(U,dSdUmp);
+  dSdUmp = dSdUmp - dSdU;
+  RealD Fdiff = std::sqrt(norm2(dSdUmp)/norm2(dSdU));
+  std::cout << GridLogMessage << "Force relative difference "<<Fdiff<<std::endl;
+  assert(Fdiff < 1.0e-7);
+
+  Grid_finalize();
+}
@@ -0,0 +1,121 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./tests/Test_wilson_block_lanczos.cc
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef typename WilsonFermionR::FermionField FermionField;
+
+int main(int argc, char** argv) {
+  Grid_init(&argc, &argv);
+
+  const int Nblock = 4;
+
+  GridCartesian* UGrid = SpaceTimeGrid::makeFourDimGrid(
+      GridDefaultLatt(), GridDefaultSimd(Nd, vComplex::Nsimd()),
+      GridDefaultMpi());
+  GridRedBlackCartesian* UrbGrid =
+      SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian* BGrid = SpaceTimeGrid::makeFiveDimGrid(Nblock, UGrid);
+  GridRedBlackCartesian* BrbGrid =
+      SpaceTimeGrid::makeFiveDimRedBlackGrid(Nblock, UGrid);
+
+  std::vector<int> seeds4({1, 2, 3, 4});
+  GridParallelRNG RNG4(UGrid);
+  RNG4.SeedFixedIntegers(seeds4);
+
+  LatticeGaugeField Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4, Umu);
+
+  RealD mass = 0.1;
+  WilsonFermionR         Dw(Umu, *UGrid, *UrbGrid, mass);
+  WilsonFermionMultiRHSR Dm(Umu, *BGrid, *BrbGrid, *UGrid, *UrbGrid, mass);
+
+  SchurDiagMooeeOperator<WilsonFermionR, FermionField>         HermOp(Dw);
+  SchurDiagMooeeOperator<WilsonFermionMultiRHSR, FermionField> HermOpM(Dm);
+
+  const int Nstop = 16;
+  const int Nk    = 24;
+  const int Nm    = 48;
+  const int MaxIt = 1000;
+  RealD resid = 1.0e-6;
+
+  Chebyshev<FermionField> Cheby(2.0, 30., 11);
+
+  ////////////////////////////////////////////////////////
+  // Reference: single vector implicitly restarted Lanczos
+  ////////////////////////////////////////////////////////
+  FunctionHermOp<FermionField> OpCheby(Cheby, HermOp);
+  PlainHermOp<FermionField>    Op(HermOp);
+
+  ImplicitlyRestartedLanczos<FermionField> IRL(OpCheby, Op, Nstop, Nk, Nm, resid, MaxIt);
+
+  std::vector<RealD> eval(Nm);
+  std::vector<FermionField> evec(Nm, UrbGrid);
+  FermionField src_full(UGrid);
+  FermionField src(UrbGrid);
+  gaussian(RNG4, src_full);
+  pickCheckerboard(Odd, src, src_full);
+
+  int Nconv;
+  IRL.calc(eval, evec, src, Nconv);
+
+  ////////////////////////////////////////////////////////
+  // Block Lanczos, Chebyshev applied with the batched Dslash.
+  // The single vector convergence tests go through the same
+  // operator, which treats each field as a batch of one.
+  ////////////////////////////////////////////////////////
+  FunctionHermOp<FermionField> OpChebyM(Cheby, HermOpM);
+  PlainHermOp<FermionField>    OpM(HermOpM);
+
+  ThickRestartBlockLanczos<FermionField> BL(OpChebyM, OpM, Nstop, Nk, Nm, Nblock, resid, MaxIt);
+
+  std::vector<RealD> eval_b(Nm);
+  std::vector<FermionField> evec_b(Nm, UrbGrid);
+  std::vector<FermionField> src_b(Nblock, UrbGrid);
+  for (int b = 0; b < Nblock; b++) {
+    gaussian(RNG4, src_full);
+    pickCheckerboard(Odd, src_b[b], src_full);
+  }
+
+  int Nconv_b;
+  BL.calc(eval_b, evec_b, src_b, Nconv_b);
+
+  assert(Nconv_b >= Nstop);
+  for (int i = 0; i < Nstop; i++) {
+    FermionField r(UrbGrid);
+    HermOp.HermOp(evec_b[i], r);
+    r = r - eval_b[i] * evec_b[i];
+    RealD rnorm = std::sqrt(norm2(r));
+    std::cout << GridLogMessage << "eval " << i << " IRL " << eval[i] << " block " << eval_b[i]
+              << " |H v - lambda v| " << rnorm << std::endl;
+    assert(fabs(eval_b[i] - eval[i]) < 1.0e-6 * fabs(eval[i]) + 1.0e-10);
+  }
+
+  Grid_finalize();
+}
@@ -65,6 +65,44 @@ int main (int argc, char ** argv)
   CovariantSmearing<PeriodicGimplR>::GaussianSmear(U, src, 2.0, 50, Tdir);
 
   std::cout << src <<std::endl;
-  
+
+  // Stout smearing against the Taylor series exponential
+  {
+    LatticeGaugeField Uhot(&Grid), Usmr(&Grid), C(&Grid);
+    LatticeColourMatrix Cmu(&Grid), Umu(&Grid), iQ(&Grid), e_iQ(&Grid), diff(&Grid);
+    SU<Nc>::HotConfiguration(pRNG,Uhot);
+
+    // expMat picks up the Cayley-Hamilton form for SU(3); sum the series by hand
+    auto taylor = [&](const LatticeColourMatrix &X) {
+      LatticeColourMatrix ret(&Grid), term(&Grid);
+      ret  = 1.0;
+      term = 1.0;
+      for(int n=1;n<=20;n++){
+	term = term*X*(1.0/n);
+	ret  = ret+term;
+      }
+      return ret;
+    };
+
+    int orthog = Tdir;
+    Smear_Stout<PeriodicGimplR> Stout(0.1,orthog);
+    Stout.smear(Usmr,Uhot);
+    Stout.BaseSmear(C,Uhot);
+
+    for(int mu=0;mu<Nd;mu++){
+      Cmu = PeekIndex<LorentzIndex>(C,mu);
+      Umu = PeekIndex<LorentzIndex>(Uhot,mu);
+      if ( mu != orthog ) {
+	iQ  = Ta(Cmu*adj(Umu));
+	Stout.exponentiate_iQ(e_iQ,iQ);
+	diff = e_iQ - taylor(iQ);
+	std::cout << GridLogMessage << "mu "<<mu<<" exp(iQ) - Taylor series " << norm2(diff) <<std::endl;
+	Umu = taylor(iQ)*Umu;
+      }
+      diff = PeekIndex<LorentzIndex>(Usmr,mu) - Umu;
+      std::cout << GridLogMessage << "mu "<<mu<<" stout link - reference " << norm2(diff) <<std::endl;
+    }
+  }
+
 }
 
@@ -0,0 +1,104 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./tests/Test_dwf_cg_pipelined.cc
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main(int argc, char** argv) {
+  Grid_init(&argc, &argv);
+
+  const int Ls = 8;
+
+  GridCartesian* UGrid = SpaceTimeGrid::makeFourDimGrid(
+      GridDefaultLatt(), GridDefaultSimd(Nd, vComplex::Nsimd()),
+      GridDefaultMpi());
+  GridRedBlackCartesian* UrbGrid =
+      SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian* FGrid = SpaceTimeGrid::makeFiveDimGrid(Ls, UGrid);
+  GridRedBlackCartesian* FrbGrid =
+      SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls, UGrid);
+
+  std::vector<int> seeds4({1, 2, 3, 4});
+  std::vector<int> seeds5({5, 6, 7, 8});
+  GridParallelRNG RNG5(FGrid);
+  RNG5.SeedFixedIntegers(seeds5);
+  GridParallelRNG RNG4(UGrid);
+  RNG4.SeedFixedIntegers(seeds4);
+
+  LatticeFermion src(FGrid);
+  random(RNG5, src);
+  LatticeGaugeField Umu(UGrid);
+
+  SU<Nc>::HotConfiguration(RNG4, Umu);
+
+  RealD mass = 0.01;
+  RealD M5 = 1.8;
+  DomainWallFermionR Ddwf(Umu, *FGrid, *FrbGrid, *UGrid, *UrbGrid, mass, M5);
+
+  LatticeFermion src_o(FrbGrid);
+  LatticeFermion result_o(FrbGrid);
+  LatticeFermion result_p(FrbGrid);
+  pickCheckerboard(Odd, src_o, src);
+  result_o = Zero();
+  result_p = Zero();
+
+  SchurDiagMooeeOperator<DomainWallFermionR, LatticeFermion> HermOpEO(Ddwf);
+
+  RealD tol = 1.0e-8;
+  ConjugateGradient<LatticeFermion>          CG (tol, 10000);
+  ConjugateGradientPipelined<LatticeFermion> PCG(tol, 10000);
+
+  GridStopWatch CGTimer;
+  GridStopWatch PCGTimer;
+
+  std::cout << GridLogMessage << "::::::::::::::::::::: Standard CG" << std::endl;
+  CGTimer.Start();
+  CG(HermOpEO, src_o, result_o);
+  CGTimer.Stop();
+
+  std::cout << GridLogMessage << "::::::::::::::::::::: Pipelined CG" << std::endl;
+  PCGTimer.Start();
+  PCG(HermOpEO, src_o, result_p);
+  PCGTimer.Stop();
+
+  std::cout << GridLogMessage << "CG  iterations " << CG.IterationsToComplete
+	    << " time " << CGTimer.Elapsed() << std::endl;
+  std::cout << GridLogMessage << "PCG iterations " << PCG.IterationsToComplete
+	    << " time " << PCGTimer.Elapsed()
+	    << " replacements " << PCG.ReplacementsPerformed << std::endl;
+
+  LatticeFermion diff(FrbGrid);
+  diff = result_o - result_p;
+  RealD rdiff = std::sqrt(norm2(diff)/norm2(result_o));
+  std::cout << GridLogMessage << "Relative solution difference " << rdiff << std::endl;
+
+  assert(PCG.TrueResidual < 10.0 * tol);
+  assert(rdiff < 1.0e-5);
+
+  Grid_finalize();
+}
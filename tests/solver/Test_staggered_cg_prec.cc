@@ -102,5 +102,20 @@ int main (int argc, char ** argv)
   HermOpEO.Mpc(res_o,tmp);
   std::cout << "check Mpc resid " << axpy_norm(tmp,-1.0,src_o,tmp)/norm2(src_o) << "\n";
 
+  // Batched HermOp, as used by the multi RHS solvers, is the same operator
+  const int nrhs = 3;
+  std::vector<FermionField> bin(nrhs,&RBGrid), bout(nrhs,&RBGrid);
+  for(int r=0;r<nrhs;r++){
+    random(pRNG,src);
+    pickCheckerboard(Odd,bin[r],src);
+  }
+  HermOpEO.HermOpMultiRHS(bin,bout);
+  for(int r=0;r<nrhs;r++){
+    HermOpEO.HermOp(bin[r],tmp);
+    tmp = tmp - bout[r];
+    std::cout<<GridLogMessage << "rhs "<<r<<" batched vs single HermOp diff " << norm2(tmp) << std::endl;
+    assert(norm2(tmp)==0.0);
+  }
+
   Grid_finalize();
 }
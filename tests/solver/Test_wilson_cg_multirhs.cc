@@ -0,0 +1,114 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./tests/Test_wilson_cg_multirhs.cc
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main(int argc, char** argv) {
+  Grid_init(&argc, &argv);
+
+  const int nrhs = 4;
+
+  GridCartesian* UGrid = SpaceTimeGrid::makeFourDimGrid(
+      GridDefaultLatt(), GridDefaultSimd(Nd, vComplex::Nsimd()),
+      GridDefaultMpi());
+  GridRedBlackCartesian* UrbGrid =
+      SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian* BGrid = SpaceTimeGrid::makeFiveDimGrid(nrhs, UGrid);
+  GridRedBlackCartesian* BrbGrid =
+      SpaceTimeGrid::makeFiveDimRedBlackGrid(nrhs, UGrid);
+
+  std::vector<int> seeds4({1, 2, 3, 4});
+  GridParallelRNG RNG4(UGrid);
+  RNG4.SeedFixedIntegers(seeds4);
+
+  LatticeGaugeField Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4, Umu);
+
+  RealD mass = 0.5;
+  WilsonFermionR          Dw(Umu, *UGrid, *UrbGrid, mass);
+  WilsonFermionMultiRHSR  Dm(Umu, *BGrid, *BrbGrid, *UGrid, *UrbGrid, mass);
+
+  std::vector<LatticeFermion> src(nrhs, UGrid);
+  std::vector<LatticeFermion> src_o(nrhs, UrbGrid);
+  std::vector<LatticeFermion> result_o(nrhs, UrbGrid);
+  std::vector<LatticeFermion> result_m(nrhs, UrbGrid);
+  for (int r = 0; r < nrhs; r++) {
+    random(RNG4, src[r]);
+    pickCheckerboard(Odd, src_o[r], src[r]);
+    result_o[r] = Zero();
+    result_m[r] = Zero();
+  }
+
+  SchurDiagMooeeOperator<WilsonFermionR, LatticeFermion>         HermOpEO(Dw);
+  SchurDiagMooeeOperator<WilsonFermionMultiRHSR, LatticeFermion> HermOpEOm(Dm);
+
+  RealD tol = 1.0e-8;
+  ConjugateGradient<LatticeFermion>         CG (tol, 10000);
+  ConjugateGradientMultiRHS<LatticeFermion> MCG(tol, 10000);
+
+  std::cout << GridLogMessage << "::::::::::::::::::::: Standard CG, one system at a time" << std::endl;
+  for (int r = 0; r < nrhs; r++) CG(HermOpEO, src_o[r], result_o[r]);
+
+  // Start one system from its solution so that it leaves the batch early
+  result_m[1] = result_o[1];
+
+  std::cout << GridLogMessage << "::::::::::::::::::::: Multi RHS CG, batched operator" << std::endl;
+  MCG(HermOpEOm, src_o, result_m);
+  assert(MCG.IterationsToCompleteRHS[1] < MCG.IterationsToComplete);
+
+  for (int r = 0; r < nrhs; r++) {
+    LatticeFermion diff(UrbGrid);
+    diff = result_o[r] - result_m[r];
+    RealD rdiff = std::sqrt(norm2(diff)/norm2(result_o[r]));
+    std::cout << GridLogMessage << "System " << r << " relative solution difference " << rdiff << std::endl;
+    assert(MCG.TrueResidualRHS[r] < 10.0 * tol);
+    assert(rdiff < 1.0e-5);
+  }
+
+  std::cout << GridLogMessage << "::::::::::::::::::::: Multi RHS CG, unbatched operator" << std::endl;
+  for (int r = 0; r < nrhs; r++) result_m[r] = Zero();
+  MCG(HermOpEO, src_o, result_m);
+  for (int r = 0; r < nrhs; r++) {
+    LatticeFermion diff(UrbGrid);
+    diff = result_o[r] - result_m[r];
+    RealD rdiff = std::sqrt(norm2(diff)/norm2(result_o[r]));
+    std::cout << GridLogMessage << "System " << r << " relative solution difference " << rdiff << std::endl;
+    assert(MCG.TrueResidualRHS[r] < 10.0 * tol);
+    assert(rdiff < 1.0e-5);
+  }
+
+  std::cout << GridLogMessage << "::::::::::::::::::::: Multi RHS CG on MdagM, full lattice" << std::endl;
+  MdagMLinearOperator<WilsonFermionMultiRHSR, LatticeFermion> HermOpm(Dm);
+  std::vector<LatticeFermion> result(nrhs, UGrid);
+  for (int r = 0; r < nrhs; r++) result[r] = Zero();
+  MCG(HermOpm, src, result);
+  for (int r = 0; r < nrhs; r++) assert(MCG.TrueResidualRHS[r] < 10.0 * tol);
+
+  Grid_finalize();
+}
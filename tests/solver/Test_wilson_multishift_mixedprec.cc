@@ -0,0 +1,97 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./tests/Test_wilson_multishift_mixedprec.cc
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main(int argc, char** argv) {
+  Grid_init(&argc, &argv);
+
+  GridCartesian         *UGrid_d   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd, vComplexD::Nsimd()), GridDefaultMpi());
+  GridCartesian         *UGrid_f   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd, vComplexF::Nsimd()), GridDefaultMpi());
+  GridRedBlackCartesian *UrbGrid_d = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid_d);
+  GridRedBlackCartesian *UrbGrid_f = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid_f);
+
+  std::vector<int> seeds({1, 2, 3, 4});
+  GridParallelRNG  RNG(UGrid_d);
+  RNG.SeedFixedIntegers(seeds);
+
+  LatticeGaugeFieldD Umu_d(UGrid_d);  SU<Nc>::HotConfiguration(RNG, Umu_d);
+  LatticeGaugeFieldF Umu_f(UGrid_f);  precisionChange(Umu_f, Umu_d);
+
+  RealD mass = 0.1;
+  WilsonFermionD Dw_d(Umu_d, *UGrid_d, *UrbGrid_d, mass);
+  WilsonFermionF Dw_f(Umu_f, *UGrid_f, *UrbGrid_f, mass);
+
+  LatticeFermionD src(UGrid_d);   gaussian(RNG, src);
+  LatticeFermionD src_o(UrbGrid_d);
+  pickCheckerboard(Odd, src_o, src);
+
+  SchurDiagMooeeOperator<WilsonFermionD, LatticeFermionD> HermOpEO_d(Dw_d);
+  SchurDiagMooeeOperator<WilsonFermionF, LatticeFermionF> HermOpEO_f(Dw_f);
+
+  ////////////////////////////////////////
+  // Poles of (MdagM)^-1/2, as used by RHMC
+  ////////////////////////////////////////
+  RealD tol    = 1.0e-10;
+  int   degree = 8;
+  AlgRemez remez(0.01, 80.0, 64);
+  remez.generateApprox(degree, 1, 2);
+  MultiShiftFunction PowerNegHalf(remez, tol, true);
+
+  std::vector<LatticeFermionD> result_d(degree, UrbGrid_d);
+  std::vector<LatticeFermionD> result_m(degree, UrbGrid_d);
+  LatticeFermionD psi_d(UrbGrid_d);
+  LatticeFermionD psi_m(UrbGrid_d);
+
+  std::cout << GridLogMessage << "::::::::::::: Starting double precision multi-shift CG" << std::endl;
+  ConjugateGradientMultiShift<LatticeFermionD> MSCG(10000, PowerNegHalf);
+  MSCG(HermOpEO_d, src_o, result_d, psi_d);
+
+  std::cout << GridLogMessage << "::::::::::::: Starting mixed precision multi-shift CG" << std::endl;
+  ConjugateGradientMultiShiftMixedPrec<LatticeFermionD, LatticeFermionF> MSCGm(10000, PowerNegHalf, UrbGrid_f, HermOpEO_f);
+  MSCGm(HermOpEO_d, src_o, result_m, psi_m);
+
+  assert(MSCGm.ReliableUpdatesPerformed > 0);
+  for (int s = 0; s < degree; s++) {
+    LatticeFermionD diff(UrbGrid_d);
+    RealD rdiff = std::sqrt(axpy_norm(diff, -1.0, result_m[s], result_d[s]) / norm2(result_d[s]));
+    std::cout << GridLogMessage << "Shift " << s << " true residual " << MSCGm.TrueResidualShift[s]
+              << " cleanup iterations " << MSCGm.IterationsToCleanupShift[s]
+              << " relative difference to double " << rdiff << std::endl;
+    assert(MSCGm.TrueResidualShift[s] < 10.0 * tol);
+    assert(rdiff < 1.0e-7);
+  }
+
+  LatticeFermionD diff(UrbGrid_d);
+  RealD rdiff = std::sqrt(axpy_norm(diff, -1.0, psi_m, psi_d) / norm2(psi_d));
+  std::cout << GridLogMessage << "Rational function relative difference to double " << rdiff << std::endl;
+  assert(rdiff < 1.0e-7);
+
+  Grid_finalize();
+}